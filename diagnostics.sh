@@ -186,11 +186,15 @@ fi
 
 section "main.qml – visualization completeness"
 MAIN_QML="$PKG_DIR/contents/ui/main.qml"
+VIS_DIR="$PKG_DIR/contents/ui/visualizations"
 if [[ -f "$MAIN_QML" ]]; then
-  IMPL_COUNT=$(grep -o 'visualizationType === [0-9]*' "$MAIN_QML" 2>/dev/null | sort -u | wc -l)
-  ok "main.qml handles $IMPL_COUNT visualization type(s)"
-  [[ "$IMPL_COUNT" -ge 20 ]] || warn "Expected ≥20 handled types, found $IMPL_COUNT"
-  ! grep -q 'Visualization Not Yet Implemented' "$MAIN_QML" \
+  grep -q 'VisualizationHost' "$MAIN_QML" \
+    && ok "main.qml loads visualizations through VisualizationHost" \
+    || { err "VisualizationHost not used in main.qml"; ((ISSUES++)); }
+  IMPL_COUNT=$(find "$VIS_DIR" -maxdepth 1 -name '*.qml' 2>/dev/null | wc -l)
+  ok "$IMPL_COUNT visualization file(s) in contents/ui/visualizations"
+  [[ "$IMPL_COUNT" -ge 20 ]] || warn "Expected ≥20 visualization files, found $IMPL_COUNT"
+  ! grep -rq 'Visualization Not Yet Implemented' "$MAIN_QML" "$VIS_DIR" 2>/dev/null \
     && ok "No 'Not Yet Implemented' placeholder" \
     || { err "'Not Yet Implemented' placeholder still present"; ((ISSUES++)); }
 else
@@ -2,6 +2,9 @@
 #include <X11/Xlib.h>
 #include <X11/Xutil.h>
 #include <X11/Xatom.h>
+#include <X11/extensions/XShm.h>
+#include <sys/ipc.h>
+#include <sys/shm.h>
 #include <pulse/simple.h>
 #include <pulse/error.h>
 #include <iostream>
@@ -11,6 +14,7 @@
 #include <chrono>
 #include <cmath>
 #include <algorithm>
+#include <cstdint>
 
 class FFTWVisualizer {
 private:
@@ -22,6 +26,14 @@ private:
     int m_screen;
     unsigned char* m_imageData;
     
+    // MIT-SHM: m_imageData lives in a segment shared with the X server
+    XShmSegmentInfo m_shmInfo;
+    bool m_useShm;
+    int m_shmCompletionType;
+    bool m_shmPending;
+    
+    static bool s_shmAttachFailed;
+    
     // Audio processing
     pa_simple* m_pulseAudio;
     std::thread m_audioThread;
@@ -42,7 +54,8 @@ private:
 public:
     FFTWVisualizer() : m_display(nullptr), m_window(0), m_gc(nullptr), 
                        m_image(nullptr), m_pulseAudio(nullptr), m_running(false),
-                       m_imageData(nullptr), m_fftOutput(nullptr) {
+                       m_imageData(nullptr), m_shmInfo{}, m_useShm(false),
+                       m_shmCompletionType(0), m_shmPending(false), m_fftOutput(nullptr) {
         m_audioBuffer.resize(AUDIO_BUFFER_SIZE);
         m_fftInput.resize(FFT_SIZE);
         m_fftOutput = (fftw_complex*)fftw_malloc(sizeof(fftw_complex) * FFT_SIZE);
@@ -100,12 +113,15 @@ public:
         
         m_gc = XCreateGC(m_display, m_window, 0, nullptr);
         
-        // Create image
+        // Create image — shared with the server when MIT-SHM is available
         int depth = DefaultDepth(m_display, m_screen);
-        m_imageData = new unsigned char[m_width * m_height * 4];
-        m_image = XCreateImage(m_display, DefaultVisual(m_display, m_screen),
-                              depth, ZPixmap, 0, (char*)m_imageData,
-                              m_width, m_height, 32, 0);
+        if (!XShmQueryExtension(m_display) || !createSharedImage(DefaultVisual(m_display, m_screen), depth)) {
+            std::cout << "MIT-SHM unavailable, using XPutImage" << std::endl;
+            m_imageData = new unsigned char[m_width * m_height * 4];
+            m_image = XCreateImage(m_display, DefaultVisual(m_display, m_screen),
+                                  depth, ZPixmap, 0, (char*)m_imageData,
+                                  m_width, m_height, 32, 0);
+        }
         
         // Initialize PulseAudio
         pa_sample_spec ss;
@@ -146,7 +162,9 @@ public:
             // Check for X11 events
             while (XPending(m_display)) {
                 XNextEvent(m_display, &event);
-                if (event.type == KeyPress) {
+                if (m_useShm && event.type == m_shmCompletionType) {
+                    m_shmPending = false;
+                } else if (event.type == KeyPress) {
                     m_running = false;
                     break;
                 }
@@ -165,6 +183,68 @@ public:
     }
 
 private:
+    static int shmAttachErrorHandler(Display*, XErrorEvent*) {
+        s_shmAttachFailed = true;
+        return 0;
+    }
+    
+    static Bool isShmCompletion(Display*, XEvent* event, XPointer arg) {
+        return event->type == *reinterpret_cast<int*>(arg);
+    }
+    
+    bool createSharedImage(Visual* visual, int depth) {
+        m_image = XShmCreateImage(m_display, visual, depth, ZPixmap, nullptr,
+                                  &m_shmInfo, m_width, m_height);
+        if (!m_image) {
+            return false;
+        }
+        
+        m_shmInfo.shmid = shmget(IPC_PRIVATE, m_image->bytes_per_line * m_image->height,
+                                 IPC_CREAT | 0600);
+        if (m_shmInfo.shmid < 0) {
+            XDestroyImage(m_image);
+            m_image = nullptr;
+            return false;
+        }
+        m_shmInfo.shmaddr = m_image->data = (char*)shmat(m_shmInfo.shmid, nullptr, 0);
+        m_shmInfo.readOnly = False;
+        
+        // Attaching fails asynchronously on displays that cannot see the segment
+        bool attached = m_shmInfo.shmaddr != (char*)-1;
+        if (attached) {
+            s_shmAttachFailed = false;
+            XErrorHandler previous = XSetErrorHandler(shmAttachErrorHandler);
+            attached = XShmAttach(m_display, &m_shmInfo);
+            XSync(m_display, False);
+            XSetErrorHandler(previous);
+            attached = attached && !s_shmAttachFailed;
+        }
+        shmctl(m_shmInfo.shmid, IPC_RMID, nullptr);
+        
+        if (!attached) {
+            if (m_shmInfo.shmaddr != (char*)-1) {
+                shmdt(m_shmInfo.shmaddr);
+            }
+            m_image->data = nullptr;
+            XDestroyImage(m_image);
+            m_image = nullptr;
+            return false;
+        }
+        
+        m_imageData = (unsigned char*)m_shmInfo.shmaddr;
+        m_shmCompletionType = XShmGetEventBase(m_display) + ShmCompletion;
+        m_useShm = true;
+        return true;
+    }
+    
+    void waitForShmCompletion() {
+        if (m_shmPending) {
+            XEvent event;
+            XIfEvent(m_display, &event, isShmCompletion, (XPointer)&m_shmCompletionType);
+            m_shmPending = false;
+        }
+    }
+    
     void audioLoop() {
         std::vector<int16_t> buffer(AUDIO_BUFFER_SIZE);
         
@@ -205,8 +285,11 @@ private:
     }
     
     void renderFrame() {
+        // The server may still be reading the previous frame
+        waitForShmCompletion();
+        
         // Clear the image
-        std::fill(m_imageData, m_imageData + m_width * m_height * 4, 0);
+        std::fill(m_imageData, m_imageData + m_image->bytes_per_line * m_height, 0);
         
         // Draw spectrum bars
         int barWidth = m_width / SPECTRUM_BARS;
@@ -229,19 +312,22 @@ private:
             int x = i * barWidth;
             int y = m_height - barHeight;
             
-            for (int px = x; px < x + barWidth - 1 && px < m_width; ++px) {
-                for (int py = y; py < m_height && py >= 0; ++py) {
-                    int pixelIndex = (py * m_width + px) * 4;
-                    m_imageData[pixelIndex + 0] = blue;  // B
-                    m_imageData[pixelIndex + 1] = green; // G
-                    m_imageData[pixelIndex + 2] = red;   // R
-                    m_imageData[pixelIndex + 3] = 255;   // A
-                }
+            // One native 0x00RRGGBB word per pixel, filled a row span at a time
+            const uint32_t pixel = 0xFF000000u | (red << 16) | (green << 8) | blue;
+            const int spanWidth = std::min(barWidth - 1, m_width - x);
+            for (int py = std::max(y, 0); py < m_height && spanWidth > 0; ++py) {
+                uint32_t* row = reinterpret_cast<uint32_t*>(m_imageData + py * m_image->bytes_per_line);
+                std::fill_n(row + x, spanWidth, pixel);
             }
         }
         
         // Update X11 display
-        XPutImage(m_display, m_window, m_gc, m_image, 0, 0, 0, 0, m_width, m_height);
+        if (m_useShm) {
+            XShmPutImage(m_display, m_window, m_gc, m_image, 0, 0, 0, 0, m_width, m_height, True);
+            m_shmPending = true;
+        } else {
+            XPutImage(m_display, m_window, m_gc, m_image, 0, 0, 0, 0, m_width, m_height);
+        }
         XFlush(m_display);
     }
     
@@ -256,6 +342,14 @@ private:
             pa_simple_free(m_pulseAudio);
         }
         
+        if (m_useShm) {
+            waitForShmCompletion();
+            XShmDetach(m_display, &m_shmInfo);
+            XSync(m_display, False);
+            shmdt(m_shmInfo.shmaddr);
+            m_imageData = nullptr;
+        }
+        
         if (m_image) {
             m_image->data = nullptr;
             XDestroyImage(m_image);
@@ -279,6 +373,8 @@ private:
     }
 };
 
+bool FFTWVisualizer::s_shmAttachFailed = false;
+
 int main() {
     std::cout << "FFTW3 Audio Visualizer for KDE Desktop Background" << std::endl;
     std::cout << "Press any key to exit..." << std::endl;
@@ -20,6 +20,8 @@ if [ -f /etc/debian_version ]; then
         libvisual-0.4-dev \
         libpulse-dev \
         libx11-dev \
+        libxext-dev \
+        libxrandr-dev \
         libxrender-dev \
         libvisual-0.4-plugins
 
@@ -35,6 +37,8 @@ elif [ -f /etc/redhat-release ]; then
         libvisual-devel \
         pulseaudio-libs-devel \
         libX11-devel \
+        libXext-devel \
+        libXrandr-devel \
         libXrender-devel \
         libvisual-plugins
 
@@ -50,6 +54,8 @@ elif [ -f /etc/arch-release ]; then
         libvisual \
         pulseaudio \
         libx11 \
+        libxext \
+        libxrandr \
         libxrender \
         libvisual-plugins
 
@@ -64,6 +70,8 @@ elif [ -f /etc/gentoo-release ]; then
         media-libs/libvisual \
         media-sound/pulseaudio \
         x11-libs/libX11 \
+        x11-libs/libXext \
+        x11-libs/libXrandr \
         x11-libs/libXrender
 
 else
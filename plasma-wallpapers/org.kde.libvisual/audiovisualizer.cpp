@@ -5,7 +5,6 @@
 
 #include "audiovisualizer.h"
 #include <QDebug>
-#include <QDir>
 #include <QMutexLocker>
 #include <cmath>
 #include <algorithm>
@@ -17,6 +16,12 @@
 
 AudioVisualizer::AudioVisualizer(QObject *parent)
     : QObject(parent)
+    , m_pcmRing(std::make_shared<SampleRing>(PCM_RING_SIZE))
+    , m_stereoRing(std::make_shared<SampleRing>(PCM_RING_SIZE * 2))
+    , m_spectrumRing(std::make_shared<SampleRing>(SPECTRUM_RING_ROWS * SPECTRUM_SIZE))
+    , m_captureScratch(BUFFER_SIZE)
+    , m_stereoScratch(BUFFER_SIZE * 2)
+    , m_spectrumScratch(SPECTRUM_SIZE, 0.0f)
 {
     qDebug() << "AudioVisualizer: Initializing (async pa_stream backend)";
 
@@ -151,12 +156,6 @@ QStringList AudioVisualizer::getAudioSources()
     return {QStringLiteral("default")};
 }
 
-QStringList AudioVisualizer::scanProjectMPresets(const QString &path) const
-{
-    return QDir(path).entryList({QStringLiteral("*.milk"), QStringLiteral("*.prjm")},
-                                QDir::Files, QDir::Name);
-}
-
 // ---------------------------------------------------------------------------
 // Device enumeration — native libpulse, no pactl subprocess
 // Filters out monitor sources using PA_SOURCE_MONITOR flag.
@@ -306,7 +305,7 @@ void AudioVisualizer::connectStream()
     // Called with mainloop lock held; m_context state must be PA_CONTEXT_READY.
     pa_sample_spec spec;
     spec.format   = PA_SAMPLE_S16LE;
-    spec.channels = 1;
+    spec.channels = 2;
     spec.rate     = static_cast<uint32_t>(SAMPLE_RATE);
 
     m_stream = pa_stream_new(m_context, "Audio Visualization", &spec, nullptr);
@@ -318,12 +317,12 @@ void AudioVisualizer::connectStream()
     pa_stream_set_state_callback(m_stream, streamStateCb, this);
     pa_stream_set_read_callback(m_stream, streamReadCb, this);
 
-    // Request fragments of exactly BUFFER_SIZE samples so FFT is always fed
+    // Request fragments of exactly BUFFER_SIZE frames so FFT is always fed
     // a consistent block.  PA_STREAM_START_CORKED lets start()/stop() control
     // capture without reconnecting the stream.
     pa_buffer_attr attr{};
     attr.maxlength = static_cast<uint32_t>(-1);
-    attr.fragsize  = sizeof(int16_t) * BUFFER_SIZE;
+    attr.fragsize  = sizeof(int16_t) * 2 * BUFFER_SIZE;
 
     const QByteArray srcBytes = m_audioSource.toUtf8();
     const char *src = (m_audioSource == QLatin1String("default")) ? nullptr : srcBytes.constData();
@@ -390,27 +389,51 @@ void AudioVisualizer::streamReadCb(pa_stream *s, size_t /*nbytes*/, void *ud)
 {
     auto *av = static_cast<AudioVisualizer *>(ud);
 
-    const void *data;
-    size_t length;
-    if (pa_stream_peek(s, &data, &length) < 0) return;
-
-    if (!data) {
-        // Hole in the stream — consume and ignore
-        if (length > 0) pa_stream_drop(s);
-        return;
+    // Drain every pending fragment into the capture ring.  When the callback
+    // runs late several fragments are queued; consuming them all keeps the
+    // PCM consumers (projectM beat detection) fed with a gap-free stream.
+    bool gotSamples = false;
+    while (pa_stream_readable_size(s) > 0) {
+        const void *data;
+        size_t length;
+        if (pa_stream_peek(s, &data, &length) < 0)
+            return;
+        if (length == 0)
+            break;
+
+        if (data) {
+            // Interleaved stereo frames: kept as they are for XY scopes and
+            // down-mixed to mono for everything else
+            const auto *samples = static_cast<const int16_t *>(data);
+            int remaining = static_cast<int>(length / (2 * sizeof(int16_t)));
+            while (remaining > 0) {
+                const int chunk = std::min(remaining, BUFFER_SIZE);
+                for (int i = 0; i < chunk; ++i) {
+                    const float left  = samples[2 * i]     / 32768.0f;
+                    const float right = samples[2 * i + 1] / 32768.0f;
+                    av->m_stereoScratch[2 * i]     = left;
+                    av->m_stereoScratch[2 * i + 1] = right;
+                    av->m_captureScratch[i] = (left + right) * 0.5f;
+                }
+                av->m_pcmRing->write(av->m_captureScratch.data(), chunk);
+                av->m_stereoRing->write(av->m_stereoScratch.data(), chunk * 2);
+                samples   += chunk * 2;
+                remaining -= chunk;
+            }
+            gotSamples = true;
+        }
+        // data == nullptr with length > 0 is a hole in the stream — drop it
+        pa_stream_drop(s);
     }
+    if (!gotSamples)
+        return;
 
-    const int nSamples = std::min(static_cast<int>(length / sizeof(int16_t)), BUFFER_SIZE);
-    const auto *samples = static_cast<const int16_t *>(data);
+    // Analyse the newest BUFFER_SIZE samples once per callback
+    const int nSamples = BUFFER_SIZE;
     const qreal sens = av->m_sensitivity;
-
-    // Normalize to [-1.0, 1.0] into the FFTW input buffer
-    for (int i = 0; i < nSamples; ++i)
-        av->m_fftIn[i] = samples[i] / 32768.0;
-    for (int i = nSamples; i < BUFFER_SIZE; ++i)
-        av->m_fftIn[i] = 0.0;
-
-    pa_stream_drop(s);
+    av->m_pcmRing->readLatest(av->m_captureScratch.data(), BUFFER_SIZE);
+    for (int i = 0; i < BUFFER_SIZE; ++i)
+        av->m_fftIn[i] = av->m_captureScratch[i];
 
     // --- Decibels / level ---
     double rms = 0.0;
@@ -432,8 +455,11 @@ void AudioVisualizer::streamReadCb(pa_stream *s, size_t /*nbytes*/, void *ud)
         double mag = std::sqrt(re * re + im * im) / BUFFER_SIZE;
         mag *= sens;
         mag  = std::log10(mag + 1e-10) * 20.0;
-        spec[i] = qMax(0.0, (mag + 100.0) / 100.0);
+        const double norm = qMax(0.0, (mag + 100.0) / 100.0);
+        av->m_spectrumScratch[i] = static_cast<float>(norm);
+        spec[i] = norm;
     }
+    av->m_spectrumRing->write(av->m_spectrumScratch.data(), SPECTRUM_SIZE);
 
     // --- Waveform ---
     QVariantList wave(BUFFER_SIZE, QVariant(0.0));
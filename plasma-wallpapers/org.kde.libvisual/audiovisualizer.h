@@ -11,7 +11,11 @@
 #include <QVariantList>
 #include <QtQml/qqml.h>
 #include <fftw3.h>
+#include <memory>
 #include <pulse/pulseaudio.h>
+#include <vector>
+
+#include "samplering.h"
 
 /**
  * Async PulseAudio/PipeWire audio capture backend for the LibVisual wallpaper.
@@ -20,6 +24,12 @@
  * blocking QTimer), and pa_context_get_source_info_list() for in-process
  * device enumeration (no pactl subprocess).  Data written by the PA callback
  * thread is protected by m_mutex and published to QML via QueuedConnection.
+ *
+ * Every captured sample is additionally pushed into a lock-free SampleRing
+ * (see pcmRing()) so C++ consumers such as ProjectMItem can pull raw PCM on
+ * their own thread without going through QML; the capture is stereo, and
+ * stereoRing() keeps both channels for XY scopes.  Each analysed spectrum is
+ * likewise appended to spectrumRing() as one row of spectrumSize() floats.
  */
 class AudioVisualizer : public QObject
 {
@@ -56,7 +66,20 @@ public:
     Q_INVOKABLE void         stop();
     Q_INVOKABLE QStringList  getAudioSources();
     Q_INVOKABLE QVariantList getInputSources();
-    Q_INVOKABLE QStringList  scanProjectMPresets(const QString &path) const;
+
+    // Mono mix of the capture in [-1, 1] at SAMPLE_RATE, written by the PA callback thread.
+    // Safe to read from any thread; the ring outlives this object if retained.
+    std::shared_ptr<const SampleRing> pcmRing() const { return m_pcmRing; }
+
+    // The same capture as interleaved left/right pairs, two floats per frame.
+    // Always written in whole frames, so even-sized reads stay frame-aligned.
+    std::shared_ptr<const SampleRing> stereoRing() const { return m_stereoRing; }
+
+    // Spectrum history: one row of spectrumSize() normalised magnitudes per
+    // analysis hop.  Row-aligned, so reading in multiples of spectrumSize()
+    // always yields whole rows.
+    std::shared_ptr<const SampleRing> spectrumRing() const { return m_spectrumRing; }
+    static constexpr int spectrumSize() { return SPECTRUM_SIZE; }
 
 signals:
     void decibelsChanged();
@@ -95,6 +118,14 @@ private:
     void initFFTW();
     void cleanupFFTW();
 
+    // --- Capture ring (written only from the PA callback thread) ---
+    std::shared_ptr<SampleRing> m_pcmRing;
+    std::shared_ptr<SampleRing> m_stereoRing;
+    std::shared_ptr<SampleRing> m_spectrumRing;
+    std::vector<float>          m_captureScratch;
+    std::vector<float>          m_stereoScratch;
+    std::vector<float>          m_spectrumScratch;
+
     // --- Shared audio results (mutex-protected) ---
     mutable QMutex m_mutex;
     qreal          m_decibels = -60.0;
@@ -111,4 +142,6 @@ private:
     static constexpr int SAMPLE_RATE   = 44100;
     static constexpr int BUFFER_SIZE   = 1024;
     static constexpr int SPECTRUM_SIZE = 256;
+    static constexpr int PCM_RING_SIZE = 32768;  // ~0.7 s at 44.1 kHz
+    static constexpr int SPECTRUM_RING_ROWS = 128;
 };
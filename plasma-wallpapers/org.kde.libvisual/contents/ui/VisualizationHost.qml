@@ -0,0 +1,90 @@
+/*
+ * SPDX-FileCopyrightText: 2026 VitexSoftware <vitex@vitexsoftware.cz>
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+import QtQuick
+import AudioVisualizer 1.0
+
+// Instantiates only the selected visualization type.
+//
+// Two Loader slots take turns: the new type is compiled and created
+// asynchronously in the spare slot while the current one keeps rendering,
+// and the slots swap once it is ready, so switching never shows an empty
+// frame.  With keepWarm the previous type stays loaded (hidden, and therefore
+// idle) in the spare slot, making a switch back instantaneous.
+Item {
+    id: host
+
+    property int  visualizationType: 0
+    property bool keepWarm: true
+
+    readonly property Item activeItem: slots[activeSlot].item
+    readonly property bool loading: pendingSlot !== -1
+
+    property int activeSlot: 0
+    property int pendingSlot: -1
+    readonly property var slots: [slotA, slotB]
+
+    function sourceFor(type) {
+        return Qt.resolvedUrl("visualizations/" + VisualizationRegistry.fileFor(type))
+    }
+
+    function show(type) {
+        const active = slots[activeSlot]
+        const spare  = slots[1 - activeSlot]
+        if (active.type === type && active.status !== Loader.Null) {
+            // Back to the current type while another one was still loading
+            if (pendingSlot !== -1 && !keepWarm)
+                release(spare)
+            pendingSlot = -1
+            return
+        }
+        if (spare.type !== type || spare.status === Loader.Null || spare.status === Loader.Error) {
+            spare.type = type
+            spare.source = sourceFor(type)
+        }
+        pendingSlot = 1 - activeSlot
+        if (spare.status === Loader.Ready)
+            promote()
+    }
+
+    function promote() {
+        const previous = slots[activeSlot]
+        activeSlot  = pendingSlot
+        pendingSlot = -1
+        if (!keepWarm)
+            release(previous)
+    }
+
+    function release(slot) {
+        slot.source = ""
+        slot.type   = -1
+    }
+
+    onVisualizationTypeChanged: show(visualizationType)
+    onKeepWarmChanged: if (!keepWarm && pendingSlot === -1) release(slots[1 - activeSlot])
+    Component.onCompleted: show(visualizationType)
+
+    component Slot: Loader {
+        property int type: -1
+        required property int slotIndex
+
+        anchors.fill: parent
+        asynchronous: true
+        visible: status === Loader.Ready && host.activeSlot === slotIndex && host.pendingSlot !== slotIndex
+
+        onStatusChanged: {
+            if (status === Loader.Ready && host.pendingSlot === slotIndex) {
+                host.promote()
+            } else if (status === Loader.Error) {
+                console.warn("VisualizationHost: failed to load", source)
+                if (host.pendingSlot === slotIndex)
+                    host.pendingSlot = -1
+            }
+        }
+    }
+
+    Slot { id: slotA; slotIndex: 0 }
+    Slot { id: slotB; slotIndex: 1 }
+}
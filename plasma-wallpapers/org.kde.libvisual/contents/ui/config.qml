@@ -20,6 +20,7 @@ KCM.SimpleKCM {
     property bool   cfg_projectMShuffle: true
     property int    cfg_projectMDuration: 30
     property int    cfg_projectMPreset: -1
+    property real   cfg_projectMRenderScale: 0
 
     // Parallel list of raw PA source names (indices match audioDeviceCombo model)
     property var paSourceNames: ["default"]
@@ -201,7 +202,9 @@ ComboBox {
                 i18n("Geometric Dance"),
                 i18n("Audio Bars 3D"),
                 i18n("Kaleidoscope"),
-                i18n("ProjectM Visualizer")
+                i18n("ProjectM Visualizer"),
+                i18n("Spectrogram"),
+                i18n("Deep Zoom Mandelbrot")
             ]
             currentIndex: 0
         }
@@ -458,21 +461,47 @@ ComboBox {
                                         r2 * 0.7, 0, Math.PI * 2)
                                 ctx.fill()
                             }
+                        } else if (type === 20) {
+                            // Spectrogram — scrolling rows of coloured bins
+                            var rows = 24, bins = 32
+                            var rh = H / rows, bw = W / bins
+                            for (var r = 0; r < rows; r++) {
+                                for (var b = 0; b < bins; b++) {
+                                    var m = Math.max(0, Math.sin(b * 0.35 - (t * 2 - r * 0.25)) * Math.exp(-b / 14))
+                                    ctx.fillStyle = Qt.hsva(0.66 * (1 - m), 0.9, m, 1)
+                                    ctx.fillRect(b * bw, r * rh, bw + 0.5, rh + 0.5)
+                                }
+                            }
+                        } else if (type === 21) {
+                            // Deep Zoom Mandelbrot — escape-time bands around a
+                            // seahorse-valley point, magnification cycling with time
+                            var zoomDepth = Math.pow(0.5, (t * 0.6) % 20), maxIt = 48
+                            for (var dx=0; dx<W; dx+=3) {
+                                for (var dy=0; dy<H; dy+=3) {
+                                    var cr=-0.7436438870 + (dx/W-0.5)*3*zoomDepth, ci=0.1318259042 - (dy/H-0.5)*2*zoomDepth
+                                    var zr=0,zi=0,n=0
+                                    while(zr*zr+zi*zi<=4&&n<maxIt){var zt=zr*zr-zi*zi+cr;zi=2*zr*zi+ci;zr=zt;n++}
+                                    if(n<maxIt){ctx.fillStyle=Qt.hsva((n/16)%1,0.8,0.5+0.5*Math.cos(n/3),1);ctx.fillRect(dx,dy,3,3)}
+                                }
+                            }
                         }
                     }
 
                     onVisibleChanged: if (visible) requestPaint()
                 }
 
-                Timer {
-                    interval: 80
-                    running: true
-                    repeat: true
-                    onTriggered: {
-                        visualizationPreview.previewTime += 0.08
+                // Thumbnail only needs ~12 fps; paced by the config window's frames
+                Connections {
+                    target: FrameClock
+                    function onTick() {
+                        if (!FrameClock.isDue(12.5))
+                            return
+                        visualizationPreview.previewTime = FrameClock.time
                         previewCanvas.requestPaint()
                     }
                 }
+
+                Component.onCompleted: FrameClock.registerItem(visualizationPreview)
             }
             
             Item { Layout.fillWidth: true }
@@ -484,18 +513,74 @@ ComboBox {
             visible: visualizationCombo.currentIndex === 19
         }
 
-        ComboBox {
-            id: presetCombo
+        // Loaded in batches off the GUI thread; the list only instantiates
+        // delegates for visible rows, so thousands of presets stay cheap
+        PresetModel {
+            id: presetModel
+            path: visualizationCombo.currentIndex === 19 ? configRoot.cfg_projectMPresetPath : ""
+            filter: presetSearch.text
+        }
+
+        ColumnLayout {
             Kirigami.FormData.label: i18n("Preset:")
             visible: visualizationCombo.currentIndex === 19
-            model: {
-                var names = configAudio.scanProjectMPresets(configRoot.cfg_projectMPresetPath)
-                var result = [i18n("Shuffle (auto)")]
-                for (var i = 0; i < names.length; i++) result.push(names[i])
-                return result
+            Layout.preferredWidth: Kirigami.Units.gridUnit * 20
+
+            Kirigami.SearchField {
+                id: presetSearch
+                Layout.fillWidth: true
+                placeholderText: i18n("Search name, author or category…")
+            }
+
+            ScrollView {
+                Layout.fillWidth: true
+                Layout.preferredHeight: Kirigami.Units.gridUnit * 12
+
+                ListView {
+                    id: presetList
+                    clip: true
+                    reuseItems: true
+                    model: presetModel
+                    currentIndex: {
+                        presetModel.count   // re-evaluate as batches arrive and the filter changes
+                        return presetModel.rowOf(configRoot.cfg_projectMPreset)
+                    }
+
+                    header: ItemDelegate {
+                        width: ListView.view.width
+                        text: i18n("Shuffle (auto)")
+                        highlighted: configRoot.cfg_projectMPreset < 0
+                        onClicked: configRoot.cfg_projectMPreset = -1
+                    }
+
+                    delegate: ItemDelegate {
+                        required property string name
+                        required property string author
+                        required property int presetIndex
+
+                        width: ListView.view.width
+                        text: name
+                        highlighted: presetIndex === configRoot.cfg_projectMPreset
+                        onClicked: configRoot.cfg_projectMPreset = presetIndex
+                    }
+                }
+            }
+
+            Label {
+                Layout.fillWidth: true
+                elide: Text.ElideRight
+                color: Kirigami.Theme.disabledTextColor
+                text: {
+                    var current = configRoot.cfg_projectMPreset < 0
+                        ? i18n("Shuffle (auto)")
+                        : presetModel.nameOf(configRoot.cfg_projectMPreset)
+                    if (presetModel.loading)
+                        return i18n("Loading presets… %1", presetModel.totalCount)
+                    if (presetSearch.text.length > 0)
+                        return i18n("%1 of %2 presets — current: %3", presetModel.count, presetModel.totalCount, current)
+                    return i18np("%1 preset — current: %2", "%1 presets — current: %2", presetModel.totalCount, current)
+                }
             }
-            currentIndex: Math.max(0, configRoot.cfg_projectMPreset + 1)
-            onActivated: configRoot.cfg_projectMPreset = currentIndex - 1
         }
 
         CheckBox {
@@ -514,6 +599,22 @@ ComboBox {
             onValueModified: configRoot.cfg_projectMDuration = value
         }
 
+        ComboBox {
+            id: projectMRenderScaleCombo
+            Kirigami.FormData.label: i18n("Render resolution:")
+            visible: visualizationCombo.currentIndex === 19
+            readonly property var scales: [0, 1, 0.75, 0.5, 1 / 3, 0.25]
+            model: [i18n("Automatic"), "100%", "75%", "50%", "33%", "25%"]
+            currentIndex: {
+                for (var i = 0; i < scales.length; ++i) {
+                    if (Math.abs(scales[i] - configRoot.cfg_projectMRenderScale) < 0.01)
+                        return i
+                }
+                return 0
+            }
+            onActivated: configRoot.cfg_projectMRenderScale = scales[currentIndex]
+        }
+
         Label {
             visible: visualizationCombo.currentIndex === 19
             text: i18n("Works on Wayland (EGL/OpenGL) and X11.\nOn Vulkan backends set QSG_RHI_BACKEND=opengl.")
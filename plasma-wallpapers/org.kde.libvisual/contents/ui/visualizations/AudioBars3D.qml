@@ -0,0 +1,52 @@
+/*
+ * SPDX-FileCopyrightText: 2026 VitexSoftware <vitex@vitexsoftware.cz>
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+import QtQuick
+import AudioVisualizer 1.0
+
+// Type 17: Audio Bars 3D – spectrum bars in perspective
+Canvas {
+    anchors.fill: parent
+    onPaint: {
+        var ctx = getContext("2d")
+        ctx.clearRect(0, 0, width, height)
+        ctx.fillStyle = "#000"; ctx.fillRect(0, 0, width, height)
+        var n = 32
+        var horizonY = height * 0.55
+        var vanishX = width / 2
+        ctx.strokeStyle = Qt.rgba(0.1, 0.3, 0.5, 0.4); ctx.lineWidth = 1
+        for (var row = 0; row <= 8; row++) {
+            var pct = row / 8
+            var gy = horizonY + (height - horizonY) * pct
+            ctx.beginPath()
+            ctx.moveTo(vanishX - width*0.5*pct, gy)
+            ctx.lineTo(vanishX + width*0.5*pct, gy); ctx.stroke()
+        }
+        for (var i = 0; i < n; i++) {
+            var mag = Math.min(1.0, root.getRealSpectrumValue(i*2) * root.audioSensitivity)
+            var xNorm = (i + 0.5) / n
+            var frontXL = xNorm * width * 0.9 + width * 0.05
+            var frontXR = frontXL + width * 0.9 / n * 0.8
+            var frontY = height - 20
+            var barH = (height - horizonY) * Math.max(0.02, mag)
+            var topFY = frontY - barH
+            var topVXL = vanishX + (frontXL - vanishX) * 0.3
+            var topVXR = vanishX + (frontXR - vanishX) * 0.3
+            var topVY  = horizonY + (topFY - horizonY) * 0.3
+            var hue = i / n
+            var bright = 0.5 + mag * 0.5
+            ctx.beginPath()
+            ctx.moveTo(frontXL, frontY); ctx.lineTo(frontXR, frontY)
+            ctx.lineTo(frontXR, topFY); ctx.lineTo(frontXL, topFY)
+            ctx.closePath(); ctx.fillStyle = Qt.hsva(hue, 0.8, bright, 0.9); ctx.fill()
+            ctx.beginPath()
+            ctx.moveTo(frontXL, topFY); ctx.lineTo(frontXR, topFY)
+            ctx.lineTo(topVXR, topVY); ctx.lineTo(topVXL, topVY)
+            ctx.closePath(); ctx.fillStyle = Qt.hsva(hue, 0.5, bright * 1.3, 0.9); ctx.fill()
+        }
+    }
+    readonly property real frame: visible ? FrameClock.frameIndex : -1
+    onFrameChanged: requestPaint()
+}
@@ -0,0 +1,74 @@
+/*
+ * SPDX-FileCopyrightText: 2026 VitexSoftware <vitex@vitexsoftware.cz>
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+import QtQuick
+
+// Enhanced audio-reactive fractal pattern
+Item {
+    anchors.fill: parent
+
+    Item {
+        anchors.centerIn: parent
+        scale: 0.3 + (root.audioPeak * 0.8) + (root.audioSensitivity * 0.4) // More dramatic scaling
+        rotation: root.t * 15 * root.audioPeak // Rotate faster with audio peaks
+
+        Repeater {
+            model: 50
+            Rectangle {
+                // Audio-reactive size and pulsing
+                property real audioBoost: (index < 15) ? root.bassLevel : 
+                                         (index < 30) ? root.midLevel : root.trebleLevel
+                property real baseSize: index * 10 + 15
+                property real pulseSize: baseSize * (1.0 + audioBoost * 0.5)
+
+                width: pulseSize * (1.0 + 0.3 * Math.sin(root.t * 8 + index * 0.4))
+                height: width
+                radius: width/2
+                color: "transparent"
+
+                // Enhanced reactive border with frequency-based colors
+                border.color: Qt.rgba(
+                    0.2 + 0.6 * audioBoost, 
+                    0.4 + 0.6 * Math.sin(root.t * 3 + index * 0.3) * root.audioPeak, 
+                    0.7 + 0.3 * Math.cos(root.t * 2 + index * 0.2) * audioBoost,
+                    0.3 + 0.5 * root.audioPeak * (1.0 + 0.5 * Math.sin(root.t * 6))
+                )
+                border.width: (1 + (index % 4)) * (1.0 + audioBoost * 2)
+                anchors.centerIn: parent
+
+                // Multi-layered rotation responsive to different frequency ranges
+                rotation: (root.t * 8 * root.audioSensitivity + index * 12 + audioBoost * 45) % 360
+
+                // Pulse scaling for intense audio moments
+                scale: audioBoost > 0.6 ? (1.0 + (audioBoost - 0.6) * 0.8 * Math.sin(root.t * 25)) : 1.0
+
+                // Secondary glow effect for peaks
+                Rectangle {
+                    anchors.centerIn: parent
+                    width: parent.width * 1.3
+                    height: parent.height * 1.3
+                    radius: width/2
+                    color: "transparent"
+                    border.color: Qt.rgba(1, 0.5, 0.8, audioBoost > 0.7 ? (audioBoost - 0.7) : 0)
+                    border.width: audioBoost > 0.7 ? 2 : 0
+                    visible: audioBoost > 0.5
+                    rotation: -parent.rotation * 0.5 // Counter-rotate for hypnotic effect
+                }
+            }
+        }
+
+        // Central pulsing core
+        Rectangle {
+            anchors.centerIn: parent
+            width: 20 + root.audioPeak * 60
+            height: width
+            radius: width/2
+            color: Qt.rgba(0.9, 0.6, 0.2, 0.7 * root.audioPeak)
+            border.color: Qt.rgba(1, 0.8, 0.4, root.audioPeak)
+            border.width: root.audioPeak > 0.5 ? 4 : 2
+            scale: 1.0 + root.bassLevel * 0.4 * Math.sin(root.t * 12)
+        }
+    }
+}
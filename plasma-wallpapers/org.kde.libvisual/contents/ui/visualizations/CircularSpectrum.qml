@@ -0,0 +1,40 @@
+/*
+ * SPDX-FileCopyrightText: 2026 VitexSoftware <vitex@vitexsoftware.cz>
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+import QtQuick
+import AudioVisualizer 1.0
+
+// Type 4: Circular Spectrum – 64 radial bars around center
+Canvas {
+    anchors.fill: parent
+    onPaint: {
+        var ctx = getContext("2d")
+        ctx.clearRect(0, 0, width, height)
+        var cx = width / 2, cy = height / 2
+        var innerR = Math.min(width, height) * 0.12
+        var outerR = Math.min(width, height) * 0.47
+        var n = 64
+        var barW = Math.max(2, (Math.PI * 2 * innerR / n) * 0.7)
+        for (var i = 0; i < n; i++) {
+            var angle = (i / n) * Math.PI * 2 - Math.PI / 2
+            var mag = Math.min(1.0, root.getRealSpectrumValue(i) * root.audioSensitivity)
+            var barLen = (outerR - innerR) * Math.max(0.04, mag)
+            ctx.strokeStyle = Qt.hsva((i / n + root.t * 0.05) % 1.0, 0.85, 0.9, 0.9)
+            ctx.lineWidth = barW
+            ctx.lineCap = "round"
+            ctx.beginPath()
+            ctx.moveTo(cx + Math.cos(angle) * innerR, cy + Math.sin(angle) * innerR)
+            ctx.lineTo(cx + Math.cos(angle) * (innerR + barLen), cy + Math.sin(angle) * (innerR + barLen))
+            ctx.stroke()
+        }
+        ctx.beginPath()
+        ctx.arc(cx, cy, innerR * (0.8 + root.audioPeak * 0.4), 0, Math.PI * 2)
+        ctx.strokeStyle = Qt.rgba(1, 1, 1, 0.6 * root.audioPeak)
+        ctx.lineWidth = 2
+        ctx.stroke()
+    }
+    readonly property real frame: visible ? FrameClock.frameIndex : -1
+    onFrameChanged: requestPaint()
+}
@@ -0,0 +1,19 @@
+/*
+ * SPDX-FileCopyrightText: 2026 VitexSoftware <vitex@vitexsoftware.cz>
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+import QtQuick
+import AudioVisualizer 1.0
+
+// Type 21: Deep Zoom Mandelbrot – perturbation rendering around reference
+// orbits computed in double-double precision on worker threads.  Zooms to
+// ~1e30× magnification, then continues with the next target; loud passages
+// speed the zoom up.
+DeepMandelbrotItem {
+    anchors.fill: parent
+    running: visible
+    colorScheme: root.colorScheme
+    audioLevel: root.audioPeak * root.audioSensitivity
+    zoomSpeed: 0.6
+}
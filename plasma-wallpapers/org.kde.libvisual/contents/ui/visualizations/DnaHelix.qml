@@ -0,0 +1,46 @@
+/*
+ * SPDX-FileCopyrightText: 2026 VitexSoftware <vitex@vitexsoftware.cz>
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+import QtQuick
+import AudioVisualizer 1.0
+
+// Type 9: DNA Helix – two intertwined sine strands with rungs
+Canvas {
+    anchors.fill: parent
+    onPaint: {
+        var ctx = getContext("2d")
+        ctx.clearRect(0, 0, width, height)
+        var steps = 60
+        var cx = width / 2
+        var ampX = width * 0.3 * (0.7 + root.audioPeak * 0.5)
+        for (var i = 0; i < steps; i++) {
+            var t2 = (i / steps) * Math.PI * 6 + root.t * 2
+            var y = (i / steps) * height
+            var x1 = cx + Math.cos(t2) * ampX
+            var x2 = cx + Math.cos(t2 + Math.PI) * ampX
+            if (i > 0) {
+                var tp = ((i-1) / steps) * Math.PI * 6 + root.t * 2
+                var yp = ((i-1) / steps) * height
+                ctx.strokeStyle = Qt.rgba(0.2, 0.6 + root.bassLevel*0.4, 1.0, 0.9)
+                ctx.lineWidth = 3; ctx.beginPath()
+                ctx.moveTo(cx + Math.cos(tp) * ampX, yp); ctx.lineTo(x1, y); ctx.stroke()
+                ctx.strokeStyle = Qt.rgba(1.0, 0.3 + root.trebleLevel*0.4, 0.2, 0.9)
+                ctx.beginPath()
+                ctx.moveTo(cx + Math.cos(tp + Math.PI) * ampX, yp); ctx.lineTo(x2, y); ctx.stroke()
+            }
+            if (i % 4 === 0) {
+                var alpha = 0.3 + 0.4 * Math.abs(Math.cos(t2))
+                ctx.strokeStyle = Qt.rgba(0.8, 0.8, 0.3, alpha)
+                ctx.lineWidth = 2; ctx.beginPath(); ctx.moveTo(x1, y); ctx.lineTo(x2, y); ctx.stroke()
+                ctx.fillStyle = Qt.rgba(0.3, 1.0, 0.5, alpha); ctx.beginPath()
+                ctx.arc(x1, y, 4 + root.audioPeak*3, 0, Math.PI*2); ctx.fill()
+                ctx.fillStyle = Qt.rgba(1.0, 0.5, 0.3, alpha); ctx.beginPath()
+                ctx.arc(x2, y, 4 + root.audioPeak*3, 0, Math.PI*2); ctx.fill()
+            }
+        }
+    }
+    readonly property real frame: visible ? FrameClock.frameIndex : -1
+    onFrameChanged: requestPaint()
+}
@@ -0,0 +1,25 @@
+/*
+ * SPDX-FileCopyrightText: 2026 VitexSoftware <vitex@vitexsoftware.cz>
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+import QtQuick
+import AudioVisualizer 1.0
+
+// Type 7: Fireworks – particle bursts on bass beats
+Item {
+    anchors.fill: parent
+    ParticleSystemItem {
+        anchors.fill: parent
+        running: parent.visible
+        audioSource: parent.visible ? audioBackend : null
+        mode: ParticleSystemItem.Fireworks
+        maxParticles: 20000
+        burstSize: 600
+        beatThreshold: 0.5
+        particleSize: 4
+        sensitivity: root.audioSensitivity
+        color: Qt.hsva(0.0, 0.9, 1.0, 1.0)
+        hueSpread: 1.0
+    }
+}
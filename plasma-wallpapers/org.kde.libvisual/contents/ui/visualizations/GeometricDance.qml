@@ -0,0 +1,53 @@
+/*
+ * SPDX-FileCopyrightText: 2026 VitexSoftware <vitex@vitexsoftware.cz>
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+import QtQuick
+import AudioVisualizer 1.0
+
+// Type 16: Geometric Dance – rotating polygons driven by audio
+Canvas {
+    anchors.fill: parent
+    onPaint: {
+        var ctx = getContext("2d")
+        ctx.clearRect(0, 0, width, height)
+        var cx = width / 2, cy = height / 2
+        var minDim = Math.min(width, height)
+        var audioBoost = 1 + root.audioPeak * 0.4
+        var shapes = [
+            { sides: 3, r: 0.15, speed:  1.0, phase: 0.0, cr: 0.9, cg: 0.3, cb: 0.1 },
+            { sides: 4, r: 0.22, speed: -0.7, phase: 0.5, cr: 0.1, cg: 0.8, cb: 0.9 },
+            { sides: 5, r: 0.30, speed:  0.5, phase: 1.0, cr: 0.9, cg: 0.8, cb: 0.1 },
+            { sides: 6, r: 0.38, speed: -0.3, phase: 1.5, cr: 0.5, cg: 0.2, cb: 0.9 },
+            { sides: 8, r: 0.45, speed:  0.2, phase: 2.0, cr: 0.1, cg: 0.9, cb: 0.4 }
+        ]
+        for (var s = 0; s < shapes.length; s++) {
+            var sh = shapes[s]
+            var angle = root.t * sh.speed + sh.phase
+            var radius = minDim * sh.r * audioBoost * (1 + 0.2 * Math.sin(root.t * 3 + s))
+            ctx.beginPath()
+            for (var v = 0; v <= sh.sides; v++) {
+                var a = angle + (v / sh.sides) * Math.PI * 2
+                if (v === 0) ctx.moveTo(cx + Math.cos(a)*radius, cy + Math.sin(a)*radius)
+                else ctx.lineTo(cx + Math.cos(a)*radius, cy + Math.sin(a)*radius)
+            }
+            ctx.closePath()
+            ctx.strokeStyle = Qt.rgba(sh.cr, sh.cg, sh.cb, 0.8)
+            ctx.lineWidth = 2 + root.audioPeak * 3; ctx.stroke()
+            ctx.fillStyle = Qt.rgba(sh.cr, sh.cg, sh.cb, 0.05 + root.audioPeak * 0.15); ctx.fill()
+        }
+        if (root.audioPeak > 0.5) {
+            var rays = 12
+            for (var ray = 0; ray < rays; ray++) {
+                var ra = (ray / rays) * Math.PI * 2 + root.t * 3
+                ctx.strokeStyle = Qt.rgba(1, 1, 1, (root.audioPeak - 0.5) * 2)
+                ctx.lineWidth = 1; ctx.beginPath(); ctx.moveTo(cx, cy)
+                ctx.lineTo(cx + Math.cos(ra)*minDim*0.5*root.audioPeak,
+                           cy + Math.sin(ra)*minDim*0.5*root.audioPeak); ctx.stroke()
+            }
+        }
+    }
+    readonly property real frame: visible ? FrameClock.frameIndex : -1
+    onFrameChanged: requestPaint()
+}
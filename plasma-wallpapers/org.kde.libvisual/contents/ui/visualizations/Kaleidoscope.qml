@@ -0,0 +1,44 @@
+/*
+ * SPDX-FileCopyrightText: 2026 VitexSoftware <vitex@vitexsoftware.cz>
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+import QtQuick
+import AudioVisualizer 1.0
+
+// Type 18: Kaleidoscope – radially mirrored pattern segments
+Canvas {
+    anchors.fill: parent
+    onPaint: {
+        var ctx = getContext("2d")
+        ctx.clearRect(0, 0, width, height)
+        var cx = width / 2, cy = height / 2
+        var segments = 8
+        var segAngle = Math.PI * 2 / segments
+        var r = Math.min(width, height) * 0.5
+        for (var seg = 0; seg < segments; seg++) {
+            ctx.save()
+            ctx.translate(cx, cy)
+            ctx.rotate(seg * segAngle + root.t * 0.1)
+            ctx.beginPath(); ctx.moveTo(0, 0)
+            ctx.arc(0, 0, r, -segAngle/2, segAngle/2)
+            ctx.closePath(); ctx.clip()
+            if (seg % 2 === 1) ctx.scale(-1, 1)
+            for (var layer = 0; layer < 4; layer++) {
+                var lx = r * 0.3 * Math.sin(root.t * (0.5 + layer*0.3) + layer*1.2)
+                var ly = r * 0.2 * Math.cos(root.t * (0.4 + layer*0.2) + layer)
+                var lsz = r * (0.1 + 0.15*layer) * (1 + root.audioPeak * 0.5)
+                ctx.beginPath(); ctx.arc(lx, ly, lsz, 0, Math.PI*2)
+                ctx.fillStyle = Qt.hsva((layer/4 + root.t*0.05 + root.audioPeak*0.2) % 1.0, 0.8, 0.9,
+                                        0.35 + root.audioPeak*0.2); ctx.fill()
+                ctx.beginPath(); ctx.moveTo(0, 0); ctx.lineTo(lx + lsz, ly)
+                ctx.strokeStyle = Qt.hsva((layer/4 + 0.3 + root.t*0.05) % 1.0, 0.9, 1.0,
+                                          0.3 + root.bassLevel*0.4)
+                ctx.lineWidth = 1 + root.audioPeak*2; ctx.stroke()
+            }
+            ctx.restore()
+        }
+    }
+    readonly property real frame: visible ? FrameClock.frameIndex : -1
+    onFrameChanged: requestPaint()
+}
@@ -0,0 +1,39 @@
+/*
+ * SPDX-FileCopyrightText: 2026 VitexSoftware <vitex@vitexsoftware.cz>
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+import QtQuick
+import AudioVisualizer 1.0
+
+// Type 14: Lightning – recursive jagged bolts on beats
+Canvas {
+    anchors.fill: parent
+    function drawBolt(ctx, x1, y1, x2, y2, roughness, depth) {
+        if (depth <= 0) {
+            ctx.beginPath(); ctx.moveTo(x1, y1); ctx.lineTo(x2, y2); ctx.stroke(); return
+        }
+        var mx = (x1+x2)/2 + (Math.random()-0.5)*roughness
+        var my = (y1+y2)/2 + (Math.random()-0.5)*roughness
+        drawBolt(ctx, x1, y1, mx, my, roughness/2, depth-1)
+        drawBolt(ctx, mx, my, x2, y2, roughness/2, depth-1)
+        if (depth === 2 && Math.random() < 0.4) {
+            var bx = mx + (Math.random()-0.5)*roughness*2
+            drawBolt(ctx, mx, my, bx, my + roughness*2, roughness/3, depth-1)
+        }
+    }
+    onPaint: {
+        var ctx = getContext("2d")
+        ctx.fillStyle = Qt.rgba(0, 0, 0.05, 0.3); ctx.fillRect(0, 0, width, height)
+        var numBolts = 1 + Math.floor(root.audioPeak * 3)
+        for (var b = 0; b < numBolts; b++) {
+            var bx = width * (0.2 + Math.random() * 0.6)
+            ctx.strokeStyle = Qt.rgba(0.5 + root.trebleLevel*0.5, 0.5, 1.0, 0.4 + root.audioPeak*0.6)
+            ctx.lineWidth = 1 + root.audioPeak * 2
+            ctx.shadowColor = Qt.rgba(0.5, 0.5, 1.0, 0.8); ctx.shadowBlur = 10
+            drawBolt(ctx, bx, 0, bx + (Math.random()-0.5)*100, height*0.7, width*0.15, 4)
+        }
+    }
+    readonly property real frame: visible ? FrameClock.frameIndex : -1
+    onFrameChanged: if (FrameClock.isDue(20)) requestPaint()
+}
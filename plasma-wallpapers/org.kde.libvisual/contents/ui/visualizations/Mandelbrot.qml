@@ -0,0 +1,32 @@
+/*
+ * SPDX-FileCopyrightText: 2026 VitexSoftware <vitex@vitexsoftware.cz>
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+import QtQuick
+
+// Mandelbrot Zoom visualization (type 15) — GPU-accelerated via ShaderEffect.
+// Every pixel is iterated in parallel on the GPU; this is typically 10–100×
+// faster than the previous Canvas-based CPU fallback at full wallpaper resolution.
+//
+// The compiled shader (mandelbrot.frag.qsb) is embedded in the wallpaper plugin
+// binary via qt6_add_shaders (or installed to the shaders/ dir by the manual
+// qsb fallback). When the QSB is unavailable the ShaderEffect renders transparent.
+ShaderEffect {
+    anchors.fill: parent
+
+    // Each property maps directly to a uniform in the GLSL buf block.
+    // Qt6 ShaderEffect updates them every frame via the binding engine.
+    property real time:             root.t
+    property real audioPeak:        root.audioPeak
+    property real audioSensitivity: root.audioSensitivity
+    property real centerX:          -0.5 + Math.sin(root.t * 0.3) * 0.3 * root.audioSensitivity
+    property real centerY:           0.0 + Math.cos(root.t * 0.2) * 0.3 * root.audioSensitivity
+    property int  colorScheme:      root.colorScheme
+    property int  maxIter:          50 + Math.floor(root.audioPeak * 50)
+
+    // Compiled shader embedded in the wallpaper plugin binary at build time
+    // via qt6_add_shaders (or qt_add_resources + manual qsb) — prefix "/shaders".
+    // If the QSB is absent (build without ShaderTools) the effect renders blank.
+    fragmentShader: "qrc:/shaders/mandelbrot.frag.qsb"
+}
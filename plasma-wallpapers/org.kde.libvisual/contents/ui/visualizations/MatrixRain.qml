@@ -0,0 +1,44 @@
+/*
+ * SPDX-FileCopyrightText: 2026 VitexSoftware <vitex@vitexsoftware.cz>
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+import QtQuick
+import AudioVisualizer 1.0
+
+// Type 8: Matrix Rain – falling green characters
+Canvas {
+    anchors.fill: parent
+    property var columns: []
+    property bool initialized: false
+    onPaint: {
+        var ctx = getContext("2d")
+        var colW = 20
+        var numCols = Math.floor(width / colW)
+        if (!initialized || columns.length !== numCols) {
+            columns = []
+            for (var c = 0; c < numCols; c++)
+                columns.push({ y: Math.random() * height, speed: 1 + Math.random() * 3 })
+            initialized = true
+            ctx.fillStyle = "#000"; ctx.fillRect(0, 0, width, height)
+        }
+        ctx.fillStyle = Qt.rgba(0, 0, 0, 0.05); ctx.fillRect(0, 0, width, height)
+        ctx.font = "bold " + colW + "px monospace"
+        var chars = "0123456789ABCDEF①②③"
+        var speed = 1 + root.audioPeak * 4
+        for (var i = 0; i < columns.length; i++) {
+            var col = columns[i]
+            var intensity = 0.5 + root.trebleLevel * 0.5
+            ctx.fillStyle = Qt.rgba(0.7, 1.0, 0.7, intensity)
+            ctx.fillText(chars[Math.floor(root.t * 20 + i) % chars.length], i * colW, col.y)
+            ctx.fillStyle = Qt.rgba(0.0, 0.8, 0.0, intensity * 0.6)
+            ctx.fillText(chars[Math.floor(root.t * 10 + i*3) % chars.length], i * colW, col.y - colW)
+            ctx.fillStyle = Qt.rgba(0.0, 0.5, 0.0, intensity * 0.3)
+            ctx.fillText(chars[Math.floor(root.t * 5 + i*7) % chars.length], i * colW, col.y - colW*2)
+            col.y += col.speed * speed
+            if (col.y > height + colW) { col.y = -colW; col.speed = 1 + Math.random() * 3 }
+        }
+    }
+    readonly property real frame: visible ? FrameClock.frameIndex : -1
+    onFrameChanged: if (FrameClock.isDue(20)) requestPaint()
+}
@@ -0,0 +1,113 @@
+/*
+ * SPDX-FileCopyrightText: 2026 VitexSoftware <vitex@vitexsoftware.cz>
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+import QtQuick
+import AudioVisualizer 1.0
+
+// Lissajous oscilloscope (type 2) — left channel against right as an XY
+// plot, or the simulated Lissajous figures when real audio is off or not
+// running.
+Item {
+    anchors.fill: parent
+
+    Item {
+        id: scope
+        anchors.centerIn: parent
+        width: Math.min(parent.width, parent.height) * 0.8
+        height: width
+
+        readonly property bool liveAudio: root.useRealAudio && audioBackend && audioBackend.running
+        readonly property vector4d bandLevels: visible ? Qt.vector4d(root.bassLevel, root.midLevel, root.trebleLevel, root.audioPeak)
+                                                       : Qt.vector4d(0, 0, 0, 0)
+
+        // Oscilloscope screen background
+        Rectangle {
+            anchors.fill: parent
+            color: Qt.rgba(0.02, 0.05, 0.1, 0.8)
+            border.color: Qt.rgba(0.2, 0.8, 0.4, 0.6)
+            border.width: 2
+            radius: 8
+        }
+
+        // Grid lines
+        Repeater {
+            model: 8
+            Rectangle {
+                width: parent.width
+                height: 1
+                color: Qt.rgba(0.1, 0.3, 0.2, 0.3)
+                y: (index + 1) * parent.height / 9
+            }
+        }
+        Repeater {
+            model: 8
+            Rectangle {
+                height: parent.height
+                width: 1
+                color: Qt.rgba(0.1, 0.3, 0.2, 0.3)
+                x: (index + 1) * parent.width / 9
+            }
+        }
+
+        // XY trace — left channel across, right channel up; glow replaces
+        // the Canvas shadowBlur
+        WaveformItem {
+            anchors.fill: parent
+            anchors.margins: 10
+            audioSource: parent.visible && scope.liveAudio ? audioBackend : null
+            source: WaveformItem.Stereo
+            figure: WaveformItem.BassTrebleFigure
+            time: parent.visible ? root.t : 0
+            bandLevels: scope.bandLevels
+            sampleCount: 600
+            amplitude: Math.min(1.0, 0.6 * root.audioSensitivity)
+            lineWidth: 2
+            glowWidth: 4
+            glow: 0.5
+            color: Qt.rgba(0.2, 0.9, 0.3, 0.9)
+        }
+
+        // Secondary trace for complexity on loud passages — radial scope of
+        // the mono mix, or the simulated secondary figure
+        WaveformItem {
+            anchors.fill: parent
+            anchors.margins: 10
+            visible: root.audioPeak > 0.4
+            audioSource: visible && parent.visible && scope.liveAudio ? audioBackend : null
+            source: scope.liveAudio ? WaveformItem.Waveform : WaveformItem.Stereo
+            figure: WaveformItem.MidPeakFigure
+            time: visible && parent.visible ? root.t : 0
+            bandLevels: scope.bandLevels
+            shape: WaveformItem.Radial
+            sampleCount: 300
+            radius: 0.4
+            amplitude: 0.4 * root.audioSensitivity * (scope.liveAudio ? root.midLevel : 1.0)
+            lineWidth: 1
+            glowWidth: 2
+            glow: 0.3
+            color: Qt.rgba(0.9, 0.5, 0.2, 0.6)
+        }
+
+        // Scope intensity indicator
+        Rectangle {
+            anchors.top: parent.top
+            anchors.right: parent.right
+            anchors.margins: 15
+            width: 8
+            height: parent.height * 0.3
+            color: Qt.rgba(0.1, 0.2, 0.1, 0.8)
+            radius: 4
+
+            Rectangle {
+                anchors.bottom: parent.bottom
+                anchors.horizontalCenter: parent.horizontalCenter
+                width: parent.width * 0.6
+                height: parent.height * root.audioPeak
+                color: Qt.rgba(0.3, 0.9, 0.2, 0.8)
+                radius: 2
+            }
+        }
+    }
+}
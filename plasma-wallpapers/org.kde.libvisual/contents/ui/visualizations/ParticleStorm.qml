@@ -0,0 +1,26 @@
+/*
+ * SPDX-FileCopyrightText: 2026 VitexSoftware <vitex@vitexsoftware.cz>
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+import QtQuick
+
+// Type 10: Particle Storm – orbiting colored dots
+Item {
+    anchors.fill: parent
+    Rectangle { anchors.fill: parent; color: "#02000a" }
+    Repeater {
+        model: 150
+        Rectangle {
+            property real angle: (index / 150) * Math.PI * 2 + root.t * (0.1 + (index % 7) * 0.05)
+            property real dist: Math.min(parent.width, parent.height) * 0.1 +
+                               Math.min(parent.width, parent.height) * 0.4 *
+                               Math.abs(Math.sin(root.t * (0.3 + index * 0.02) + index))
+            property real sz: 3 + root.audioPeak * 6 * (1 + (index % 3) * 0.3)
+            x: parent.width/2  + Math.cos(angle) * dist - sz/2
+            y: parent.height/2 + Math.sin(angle) * dist - sz/2
+            width: sz; height: sz; radius: sz/2
+            color: Qt.hsva((index / 150 + root.t * 0.03) % 1.0, 0.9, 1.0, 0.8)
+        }
+    }
+}
@@ -0,0 +1,31 @@
+/*
+ * SPDX-FileCopyrightText: 2026 VitexSoftware <vitex@vitexsoftware.cz>
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+import QtQuick
+
+// Type 5: Plasma – animated overlapping colored blobs
+Item {
+    anchors.fill: parent
+    clip: true
+    Rectangle { anchors.fill: parent; color: "#050010" }
+    Repeater {
+        model: 8
+        Item {
+            property real spd: 0.2 + index * 0.12
+            property real phase: index * 0.785
+            property real cx: parent.width  * (0.5 + 0.45 * Math.sin(root.t * spd + phase))
+            property real cy: parent.height * (0.5 + 0.45 * Math.cos(root.t * spd * 0.7 + phase * 1.3))
+            property real sz: Math.min(parent.width, parent.height) * (0.5 + 0.25 * root.audioPeak) * (0.8 + 0.4 * Math.sin(root.t * spd * 2 + phase))
+            x: cx - sz/2; y: cy - sz/2
+            width: sz; height: sz
+            Rectangle {
+                anchors.fill: parent
+                radius: width / 2
+                opacity: 0.35 + 0.15 * root.audioPeak
+                color: Qt.hsva(((index / 8) + root.t * 0.04 + root.audioPeak * 0.1) % 1.0, 0.85, 1.0, 1.0)
+            }
+        }
+    }
+}
@@ -0,0 +1,36 @@
+/*
+ * SPDX-FileCopyrightText: 2026 VitexSoftware <vitex@vitexsoftware.cz>
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+import QtQuick
+import AudioVisualizer 1.0
+
+// Type 19: ProjectM — Milkdrop-compatible GPU presets via libprojectM
+// Works on Wayland (OpenGL/EGL) and X11.  Shows a text notice on Vulkan.
+Item {
+    anchors.fill: parent
+
+    ProjectMItem {
+        anchors.fill: parent
+        visible: GraphicsInfo.api === GraphicsInfo.OpenGL
+        audioSource: audioBackend
+        presetPath:     root.configuration.projectMPresetPath || "/usr/share/projectM/presets"
+        shuffleEnabled: root.configuration.projectMShuffle !== false
+        presetDuration: root.configuration.projectMDuration > 0 ? root.configuration.projectMDuration : 30
+        presetIndex:    root.configuration.projectMPreset !== undefined ? root.configuration.projectMPreset : -1
+        renderScale:    root.configuration.projectMRenderScale || 0
+    }
+    Rectangle {
+        anchors.fill: parent
+        visible: GraphicsInfo.api !== GraphicsInfo.OpenGL
+        color: "#050010"
+        Text {
+            anchors.centerIn: parent
+            text: "ProjectM requires an OpenGL backend.\nSet QSG_RHI_BACKEND=opengl\n(Wayland + EGL works automatically in KDE Plasma)."
+            color: "#888"
+            horizontalAlignment: Text.AlignHCenter
+            font.pointSize: 11
+        }
+    }
+}
@@ -0,0 +1,25 @@
+/*
+ * SPDX-FileCopyrightText: 2026 VitexSoftware <vitex@vitexsoftware.cz>
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+import QtQuick
+
+// Type 11: Ripple Effect – expanding concentric rings
+Item {
+    anchors.fill: parent
+    Rectangle { anchors.fill: parent; color: "#000a10" }
+    Repeater {
+        model: 12
+        Rectangle {
+            property real offset: index / 12
+            property real phase: (root.t * 0.8 + offset) % 1.0
+            property real sz: Math.min(parent.width, parent.height) * phase * (1.2 + root.audioPeak * 0.5)
+            anchors.centerIn: parent
+            width: sz; height: sz; radius: sz/2; color: "transparent"
+            border.width: 2 + root.bassLevel * 3
+            border.color: Qt.hsva(((1 - phase) * 0.6 + root.t * 0.05) % 1.0, 0.8, 1.0,
+                                  (1 - phase) * 0.8 * (0.4 + root.audioPeak * 0.6))
+        }
+    }
+}
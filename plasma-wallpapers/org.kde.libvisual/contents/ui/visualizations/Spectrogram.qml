@@ -0,0 +1,19 @@
+/*
+ * SPDX-FileCopyrightText: 2026 VitexSoftware <vitex@vitexsoftware.cz>
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+import QtQuick
+import AudioVisualizer 1.0
+
+// Type 20: Spectrogram – scrolling waterfall kept in a GPU ring texture.
+// One texture row is uploaded per analysis hop; scrolling is a shader
+// uniform, so cost does not depend on how much history is on screen.
+SpectrogramItem {
+    anchors.fill: parent
+    audioSource: visible ? audioBackend : null
+    historyLength: 512
+    binCount: 128
+    colorScheme: root.colorScheme
+    gain: root.audioSensitivity
+}
@@ -0,0 +1,37 @@
+/*
+ * SPDX-FileCopyrightText: 2026 VitexSoftware <vitex@vitexsoftware.cz>
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+import QtQuick
+import AudioVisualizer 1.0
+
+// Spectrum bars (type 0) — one scene-graph geometry node for all bars,
+// fed from the AudioVisualizer spectrum ring on each analysis hop, or
+// simulated in C++ when real audio is off or not running.
+Item {
+    anchors.fill: parent
+
+    SpectrumBarsItem {
+        readonly property bool liveAudio: root.useRealAudio && audioBackend && audioBackend.running
+
+        anchors.left: parent.left
+        anchors.right: parent.right
+        anchors.bottom: parent.bottom
+        height: parent.height * 0.8
+        audioSource: visible && liveAudio ? audioBackend : null
+        simulated: !liveAudio
+        // Repaints every frame, so peaks keep falling between analysis hops
+        time: visible ? root.t : 0
+        bandLevels: visible ? Qt.vector4d(root.bassLevel, root.midLevel, root.trebleLevel, root.audioPeak)
+                            : Qt.vector4d(0, 0, 0, 0)
+        barCount: 64
+        spectrumBins: 64
+        spacing: 0.2
+        gain: root.audioSensitivity
+        bottomColor: root.getColorForValue(0.0, 0.2)
+        topColor: root.getColorForValue(1.0, 1.0)
+        hueAcrossBars: root.colorScheme === 0
+        peakColor: Qt.rgba(1, 0.8, 0.3, 0.9)
+    }
+}
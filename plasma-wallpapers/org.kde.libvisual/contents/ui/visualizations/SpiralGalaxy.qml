@@ -0,0 +1,28 @@
+/*
+ * SPDX-FileCopyrightText: 2026 VitexSoftware <vitex@vitexsoftware.cz>
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+import QtQuick
+
+// Type 13: Spiral Galaxy – dots arranged in 3 rotating spiral arms
+Item {
+    anchors.fill: parent
+    Rectangle { anchors.fill: parent; color: "#010008" }
+    Repeater {
+        model: 200
+        Rectangle {
+            property int arm: index % 3
+            property real armAngle: (arm / 3) * Math.PI * 2
+            property real t2: (index / 200) * 5
+            property real angle: armAngle + t2 + root.t * (0.15 + root.audioPeak * 0.1) * (arm % 2 === 0 ? 1 : -0.5)
+            property real dist: t2 * Math.min(parent.width, parent.height) * 0.08 * (1 + root.audioPeak * 0.3)
+            property real sz: Math.max(1.5, 4 - t2 * 0.5 + root.audioPeak * 3)
+            x: parent.width/2  + Math.cos(angle) * dist - sz/2
+            y: parent.height/2 + Math.sin(angle) * dist - sz/2
+            width: sz; height: sz; radius: sz/2
+            color: Qt.hsva((arm / 3 + t2 * 0.05 + root.t * 0.02) % 1.0,
+                           0.6 + root.midLevel * 0.4, 0.7 + root.trebleLevel * 0.3, 0.7 + root.audioPeak * 0.3)
+        }
+    }
+}
@@ -0,0 +1,25 @@
+/*
+ * SPDX-FileCopyrightText: 2026 VitexSoftware <vitex@vitexsoftware.cz>
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+import QtQuick
+import AudioVisualizer 1.0
+
+// Type 6: Starfield – stars flying outward from center
+Item {
+    anchors.fill: parent
+    Rectangle { anchors.fill: parent; color: "#000008" }
+    ParticleSystemItem {
+        anchors.fill: parent
+        running: parent.visible
+        audioSource: parent.visible ? audioBackend : null
+        mode: ParticleSystemItem.Starfield
+        maxParticles: 12000
+        emissionRate: 2500
+        particleSize: 2
+        sensitivity: root.audioSensitivity
+        color: Qt.rgba(0.7 + 0.3 * root.trebleLevel, 0.8 + 0.2 * root.midLevel, 1.0, 1.0)
+        hueSpread: 0.08
+    }
+}
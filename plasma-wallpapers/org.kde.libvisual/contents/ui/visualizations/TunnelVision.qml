@@ -0,0 +1,26 @@
+/*
+ * SPDX-FileCopyrightText: 2026 VitexSoftware <vitex@vitexsoftware.cz>
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+import QtQuick
+
+// Type 12: Tunnel Vision – rotating rectangles converging to center
+Item {
+    anchors.fill: parent
+    Rectangle { anchors.fill: parent; color: "#050005" }
+    Repeater {
+        model: 20
+        Rectangle {
+            property real offset: index / 20
+            property real phase: (root.t * 0.4 + offset) % 1.0
+            property real w: parent.width  * phase * phase * (1 + root.audioPeak * 0.3)
+            property real h: parent.height * phase * phase * (1 + root.audioPeak * 0.3)
+            anchors.centerIn: parent
+            width: w; height: h; color: "transparent"
+            rotation: root.t * 20 + index * 18
+            border.width: 2
+            border.color: Qt.hsva(((offset + root.t * 0.06) % 1.0), 0.9, 1.0, (1 - phase) * 0.8)
+        }
+    }
+}
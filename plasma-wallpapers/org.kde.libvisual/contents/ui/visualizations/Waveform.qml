@@ -0,0 +1,58 @@
+/*
+ * SPDX-FileCopyrightText: 2026 VitexSoftware <vitex@vitexsoftware.cz>
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+import QtQuick
+import AudioVisualizer 1.0
+
+// Enhanced audio-reactive waveform visualization
+Item {
+    anchors.fill: parent
+    
+    // Main waveform path — live PCM as a GPU line strip
+    WaveformItem {
+        anchors.fill: parent
+        audioSource: parent.visible ? audioBackend : null
+        source: WaveformItem.Waveform
+        sampleCount: 512
+        amplitude: Math.min(1.0, 0.98 * root.audioSensitivity)
+        lineWidth: 2 + root.audioPeak * 4
+        glowWidth: 4 + root.audioPeak * 8
+        glow: 0.35
+        color: root.getColorForValue(0.5, 0.7 + 0.3 * root.audioPeak)
+    }
+
+    // Secondary harmonic trace — spectrum envelope across the full width
+    WaveformItem {
+        anchors.fill: parent
+        audioSource: parent.visible ? audioBackend : null
+        source: WaveformItem.Spectrum
+        sampleCount: 128
+        amplitude: 0.94 * root.audioSensitivity
+        lineWidth: 1 + root.midLevel * 3
+        glowWidth: 3
+        glow: 0.25
+        color: root.getColorForValue(0.7, 0.5 + 0.3 * root.midLevel)
+    }
+    
+    // Waveform particles for intense moments
+    Repeater {
+        model: root.audioPeak > 0.6 ? 20 : 0
+        Rectangle {
+            width: 4 + root.audioPeak * 6
+            height: width
+            radius: width/2
+            color: Qt.rgba(1, 0.7, 0.3, 0.8 * root.audioPeak)
+            x: Math.random() * parent.width
+            y: parent.height/2 + (Math.random() - 0.5) * parent.height * 0.4 * root.audioPeak
+            
+            PropertyAnimation on y {
+                duration: 1000 + Math.random() * 1000
+                to: parent.height/2 + (Math.random() - 0.5) * parent.height * 0.6 * root.audioPeak
+                loops: Animation.Infinite
+                easing.type: Easing.InOutQuad
+            }
+        }
+    }
+}
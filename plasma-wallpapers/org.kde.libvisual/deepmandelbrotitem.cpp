@@ -0,0 +1,580 @@
+/*
+ * SPDX-FileCopyrightText: 2026 VitexSoftware <vitex@vitexsoftware.cz>
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "deepmandelbrotitem.h"
+
+#include <QDebug>
+#include <QFloat16>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QQuickWindow>
+#include <QSGGeometry>
+#include <QSGGeometryNode>
+#include <QSGMaterial>
+#include <QSGMaterialShader>
+#include <QSGTexture>
+#include <QThreadPool>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+#include <rhi/qrhi.h>
+#include <vector>
+
+namespace {
+
+constexpr int    ORBIT_WIDTH   = 1024;   // texels per orbit texture row, matches the shader
+constexpr int    MAX_ORBIT     = 4096;   // reference iterations, also the shader's loop bound
+constexpr double ESCAPE_RADIUS2 = 1e4;
+constexpr double START_SCALE   = 1.5;    // half the view height at depth 0
+constexpr double MIN_SCALE     = 1e-30;  // float deltas stay normalised down to here
+constexpr int    MIN_ITERATIONS = 200;
+constexpr int    ITERATIONS_PER_HALVING = 30;
+
+// Zoom targets: Misiurewicz points and the classic seahorse-valley spiral.
+// They are given to more digits than double-double keeps; the rest is
+// rounded away by the parser.
+struct Target {
+    const char *name;
+    const char *re;
+    const char *im;
+};
+
+constexpr Target TARGETS[] = {
+    { "Seahorse valley",  "-0.743643887037158704752191506114774",    "0.131825904205311970493132056385139"   },
+    { "Spiral M(1,2)",    "-0.228155493653961819214572014099126007", "1.115142508039937359745764636315014068"  },
+    { "Double spiral",    "-0.776610592599701856564039502552994749", "0.134608961675028166056737270233057810"  },
+    { "Real axis M(3,1)", "-1.5436890126920763615708559718017479865", "0"                                      },
+};
+constexpr int TARGET_COUNT = static_cast<int>(std::size(TARGETS));
+
+// ---------------------------------------------------------------------------
+// DoubleDouble — unevaluated sum hi + lo, ~106 bit mantissa
+// ---------------------------------------------------------------------------
+
+struct DoubleDouble
+{
+    double hi = 0.0;
+    double lo = 0.0;
+};
+
+inline DoubleDouble quickTwoSum(double a, double b)
+{
+    const double s = a + b;
+    return {s, b - (s - a)};
+}
+
+inline DoubleDouble twoSum(double a, double b)
+{
+    const double s  = a + b;
+    const double bb = s - a;
+    return {s, (a - (s - bb)) + (b - bb)};
+}
+
+inline DoubleDouble operator+(DoubleDouble x, DoubleDouble y)
+{
+    DoubleDouble s = twoSum(x.hi, y.hi);
+    const DoubleDouble t = twoSum(x.lo, y.lo);
+    s.lo += t.hi;
+    s = quickTwoSum(s.hi, s.lo);
+    s.lo += t.lo;
+    return quickTwoSum(s.hi, s.lo);
+}
+
+inline DoubleDouble operator-(DoubleDouble x)
+{
+    return {-x.hi, -x.lo};
+}
+
+inline DoubleDouble operator-(DoubleDouble x, DoubleDouble y)
+{
+    return x + -y;
+}
+
+inline DoubleDouble operator*(DoubleDouble x, DoubleDouble y)
+{
+    const double p = x.hi * y.hi;
+    double e = std::fma(x.hi, y.hi, -p);   // exact rounding error of p
+    e += x.hi * y.lo + x.lo * y.hi;
+    return quickTwoSum(p, e);
+}
+
+inline DoubleDouble operator/(DoubleDouble x, DoubleDouble y)
+{
+    // Long division, three quotient digits
+    const double q1 = x.hi / y.hi;
+    DoubleDouble r  = x - y * DoubleDouble{q1, 0.0};
+    const double q2 = r.hi / y.hi;
+    r = r - y * DoubleDouble{q2, 0.0};
+    const double q3 = r.hi / y.hi;
+    return quickTwoSum(q1, q2) + DoubleDouble{q3, 0.0};
+}
+
+inline DoubleDouble scaled(DoubleDouble x, double powerOfTwo)
+{
+    return {x.hi * powerOfTwo, x.lo * powerOfTwo};   // exact
+}
+
+// Plain decimal "[-]digits[.digits]" without exponent; 32 significant digits
+// is all double-double can hold, further digits are ignored.
+DoubleDouble parseDecimal(const char *text)
+{
+    constexpr int SIGNIFICANT_DIGITS = 32;
+    const DoubleDouble ten{10.0, 0.0};
+
+    bool negative = false;
+    if (*text == '-' || *text == '+')
+        negative = *text++ == '-';
+
+    DoubleDouble mantissa;
+    DoubleDouble divisor{1.0, 0.0};
+    int  digits = 0;
+    bool fraction = false;
+    for (; *text; ++text) {
+        if (*text == '.') {
+            fraction = true;
+            continue;
+        }
+        if (*text < '0' || *text > '9')
+            break;
+        if (digits == 0 && *text == '0' && !fraction)
+            continue;
+        if (digits >= SIGNIFICANT_DIGITS) {
+            if (!fraction)
+                mantissa = mantissa * ten;   // keep the integer part's magnitude
+            continue;
+        }
+        mantissa = mantissa * ten + DoubleDouble{double(*text - '0'), 0.0};
+        if (fraction)
+            divisor = divisor * ten;
+        if (digits > 0 || *text != '0')
+            ++digits;
+    }
+    const DoubleDouble value = mantissa / divisor;
+    return negative ? -value : value;
+}
+
+// ---------------------------------------------------------------------------
+// Reference orbits — computed on QThreadPool workers, shared read-only
+// ---------------------------------------------------------------------------
+
+struct ReferenceOrbit
+{
+    int target = 0;
+    int length = 0;              // iterations stored, Z_0 .. Z_{length-1}
+    int rows   = 0;              // texture rows of ORBIT_WIDTH texels
+    std::vector<float> texels;   // RGBA32F, (Re Z_n, Im Z_n, 0, 0)
+};
+
+std::shared_ptr<const ReferenceOrbit> computeOrbit(int target)
+{
+    const DoubleDouble cr = parseDecimal(TARGETS[target].re);
+    const DoubleDouble ci = parseDecimal(TARGETS[target].im);
+
+    auto orbit = std::make_shared<ReferenceOrbit>();
+    orbit->target = target;
+    orbit->rows   = (MAX_ORBIT + ORBIT_WIDTH - 1) / ORBIT_WIDTH;
+    orbit->texels.assign(static_cast<size_t>(orbit->rows) * ORBIT_WIDTH * 4, 0.0f);
+
+    DoubleDouble zr, zi;
+    int n = 0;
+    for (;;) {
+        float *texel = orbit->texels.data() + static_cast<size_t>(n) * 4;
+        texel[0] = static_cast<float>(zr.hi);
+        texel[1] = static_cast<float>(zi.hi);
+        ++n;
+        if (n >= MAX_ORBIT || zr.hi * zr.hi + zi.hi * zi.hi > ESCAPE_RADIUS2)
+            break;
+        const DoubleDouble zr2 = zr * zr;
+        const DoubleDouble zi2 = zi * zi;
+        zi = scaled(zr * zi, 2.0) + ci;
+        zr = zr2 - zi2 + cr;
+    }
+    orbit->length = n;
+    return orbit;
+}
+
+} // namespace
+
+class OrbitCache : public std::enable_shared_from_this<OrbitCache>
+{
+public:
+    OrbitCache() : m_orbits(TARGET_COUNT), m_pending(TARGET_COUNT, false) {}
+
+    std::shared_ptr<const ReferenceOrbit> get(int target) const
+    {
+        QMutexLocker lock(&m_mutex);
+        return m_orbits[target];
+    }
+
+    // Queues the orbit for computation unless it is ready or already queued
+    void request(int target)
+    {
+        {
+            QMutexLocker lock(&m_mutex);
+            if (m_orbits[target] || m_pending[target])
+                return;
+            m_pending[target] = true;
+        }
+        // The task keeps the cache alive, so the item may go away meanwhile
+        QThreadPool::globalInstance()->start([self = shared_from_this(), target] {
+            auto orbit = computeOrbit(target);
+            qDebug() << "DeepMandelbrotItem: reference orbit for" << TARGETS[target].name
+                     << "ready," << orbit->length << "iterations";
+            QMutexLocker lock(&self->m_mutex);
+            self->m_orbits[target]  = std::move(orbit);
+            self->m_pending[target] = false;
+        });
+    }
+
+private:
+    mutable QMutex m_mutex;
+    std::vector<std::shared_ptr<const ReferenceOrbit>> m_orbits;
+    std::vector<bool> m_pending;
+};
+
+namespace {
+
+// ---------------------------------------------------------------------------
+// OrbitTexture — the current reference orbit, uploaded only when it changes
+// ---------------------------------------------------------------------------
+
+class OrbitTexture : public QSGTexture
+{
+public:
+    OrbitTexture()
+    {
+        setFiltering(QSGTexture::Nearest);
+        setHorizontalWrapMode(QSGTexture::ClampToEdge);
+        setVerticalWrapMode(QSGTexture::ClampToEdge);
+    }
+
+    ~OrbitTexture() override
+    {
+        if (m_texture)
+            m_texture->deleteLater();
+    }
+
+    qint64       comparisonKey()   const override { return qint64(quintptr(this)); }
+    QRhiTexture *rhiTexture()      const override { return m_texture; }
+    QSize        textureSize()     const override { return {ORBIT_WIDTH, rows()}; }
+    bool         hasAlphaChannel() const override { return false; }
+    bool         hasMipmaps()      const override { return false; }
+
+    int rows()   const { return m_orbit ? m_orbit->rows : 1; }
+    int length() const { return m_orbit ? m_orbit->length : 0; }
+
+    void setOrbit(std::shared_ptr<const ReferenceOrbit> orbit)
+    {
+        if (orbit == m_orbit)
+            return;
+        m_orbit = std::move(orbit);
+        m_dirty = true;
+    }
+
+    void commitTextureOperations(QRhi *rhi, QRhiResourceUpdateBatch *resourceUpdates) override
+    {
+        if (!m_dirty || !m_orbit)
+            return;
+
+        const QSize size(ORBIT_WIDTH, m_orbit->rows);
+        if (m_texture && m_texture->pixelSize() != size) {
+            m_texture->deleteLater();
+            m_texture = nullptr;
+        }
+        if (!m_texture) {
+            m_full = rhi->isTextureFormatSupported(QRhiTexture::RGBA32F);
+            if (!m_full)
+                qWarning() << "DeepMandelbrotItem: RGBA32F textures unsupported,"
+                           << "falling back to half floats (shallow zoom only)";
+            m_texture = rhi->newTexture(m_full ? QRhiTexture::RGBA32F : QRhiTexture::RGBA16F, size);
+            if (!m_texture->create()) {
+                qWarning() << "DeepMandelbrotItem: failed to create orbit texture";
+                delete m_texture;
+                m_texture = nullptr;
+                return;
+            }
+        }
+
+        QByteArray bytes;
+        if (m_full) {
+            bytes = QByteArray(reinterpret_cast<const char *>(m_orbit->texels.data()),
+                               qsizetype(m_orbit->texels.size() * sizeof(float)));
+        } else {
+            bytes.resize(qsizetype(m_orbit->texels.size() * sizeof(qfloat16)));
+            qFloatToFloat16(reinterpret_cast<qfloat16 *>(bytes.data()),
+                            m_orbit->texels.data(), qsizetype(m_orbit->texels.size()));
+        }
+        QRhiTextureSubresourceUploadDescription full(bytes);
+        resourceUpdates->uploadTexture(m_texture, QRhiTextureUploadEntry(0, 0, full));
+        m_dirty = false;
+    }
+
+private:
+    std::shared_ptr<const ReferenceOrbit> m_orbit;
+    QRhiTexture *m_texture = nullptr;
+    bool         m_dirty   = false;
+    bool         m_full    = true;
+};
+
+// ---------------------------------------------------------------------------
+// Material + shader — per-pixel perturbation against the orbit texture
+// ---------------------------------------------------------------------------
+
+class DeepMandelbrotMaterial : public QSGMaterial
+{
+public:
+    DeepMandelbrotMaterial() { setFlag(Blending); }
+
+    QSGMaterialType *type() const override
+    {
+        static QSGMaterialType materialType;
+        return &materialType;
+    }
+
+    QSGMaterialShader *createShader(QSGRendererInterface::RenderMode) const override;
+
+    int compare(const QSGMaterial *other) const override
+    {
+        return this == other ? 0 : (this < other ? -1 : 1);
+    }
+
+    OrbitTexture texture;
+    float scale       = float(START_SCALE);
+    float aspect      = 1.0f;
+    float angle       = 0.0f;
+    float intensity   = 0.8f;
+    int   maxIter     = MIN_ITERATIONS;
+    int   colorScheme = 0;
+};
+
+class DeepMandelbrotShader : public QSGMaterialShader
+{
+public:
+    DeepMandelbrotShader()
+    {
+        setShaderFileName(VertexStage,   QStringLiteral(":/audiovisualizer/shaders/mandelbrot_deep.vert.qsb"));
+        setShaderFileName(FragmentStage, QStringLiteral(":/audiovisualizer/shaders/mandelbrot_deep.frag.qsb"));
+    }
+
+    // std140 layout: mat4 qt_Matrix, float qt_Opacity, float scale,
+    // float aspect, float angle, float intensity, int refLength,
+    // int orbitRows, int maxIter, int colorScheme
+    bool updateUniformData(RenderState &state, QSGMaterial *newMaterial, QSGMaterial *) override
+    {
+        auto *mat = static_cast<DeepMandelbrotMaterial *>(newMaterial);
+        QByteArray *buf = state.uniformData();
+        if (state.isMatrixDirty())
+            std::memcpy(buf->data(), state.combinedMatrix().constData(), 64);
+        if (state.isOpacityDirty()) {
+            const float opacity = state.opacity();
+            std::memcpy(buf->data() + 64, &opacity, 4);
+        }
+        const int refLength = mat->texture.length();
+        const int orbitRows = mat->texture.rows();
+        std::memcpy(buf->data() + 68, &mat->scale, 4);
+        std::memcpy(buf->data() + 72, &mat->aspect, 4);
+        std::memcpy(buf->data() + 76, &mat->angle, 4);
+        std::memcpy(buf->data() + 80, &mat->intensity, 4);
+        std::memcpy(buf->data() + 84, &refLength, 4);
+        std::memcpy(buf->data() + 88, &orbitRows, 4);
+        std::memcpy(buf->data() + 92, &mat->maxIter, 4);
+        std::memcpy(buf->data() + 96, &mat->colorScheme, 4);
+        return true;
+    }
+
+    void updateSampledImage(RenderState &state, int binding, QSGTexture **texture,
+                            QSGMaterial *newMaterial, QSGMaterial *) override
+    {
+        if (binding != 1)
+            return;
+        auto *mat = static_cast<DeepMandelbrotMaterial *>(newMaterial);
+        mat->texture.commitTextureOperations(state.rhi(), state.resourceUpdateBatch());
+        *texture = &mat->texture;
+    }
+};
+
+QSGMaterialShader *DeepMandelbrotMaterial::createShader(QSGRendererInterface::RenderMode) const
+{
+    return new DeepMandelbrotShader;
+}
+
+class DeepMandelbrotNode : public QSGGeometryNode
+{
+public:
+    DeepMandelbrotNode()
+        : m_geometry(QSGGeometry::defaultAttributes_TexturedPoint2D(), 4)
+    {
+        setGeometry(&m_geometry);
+        setMaterial(&m_material);
+    }
+
+    DeepMandelbrotMaterial *material() { return &m_material; }
+
+    QRectF rect;
+
+private:
+    QSGGeometry            m_geometry;
+    DeepMandelbrotMaterial m_material;
+};
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// DeepMandelbrotItem — Qt main thread (properties) / render thread (paint node)
+// ---------------------------------------------------------------------------
+
+DeepMandelbrotItem::DeepMandelbrotItem(QQuickItem *parent)
+    : QQuickItem(parent)
+    , m_orbits(std::make_shared<OrbitCache>())
+{
+    setFlag(ItemHasContents, true);
+    // The first target and the one after it; later ones are queued as the
+    // zoom moves on, always one target ahead
+    m_orbits->request(0);
+    m_orbits->request(1 % TARGET_COUNT);
+}
+
+DeepMandelbrotItem::~DeepMandelbrotItem() = default;
+
+void DeepMandelbrotItem::setRunning(bool running)
+{
+    if (m_running == running)
+        return;
+    m_running = running;
+    emit runningChanged();
+    update();
+}
+
+void DeepMandelbrotItem::setColorScheme(int scheme)
+{
+    if (m_colorScheme == scheme)
+        return;
+    m_colorScheme = scheme;
+    emit colorSchemeChanged();
+    update();
+}
+
+void DeepMandelbrotItem::setAudioLevel(qreal level)
+{
+    level = qBound<qreal>(0.0, level, 1.0);
+    if (qFuzzyCompare(m_audioLevel, level))
+        return;
+    m_audioLevel = level;
+    emit audioLevelChanged();
+}
+
+void DeepMandelbrotItem::setZoomSpeed(qreal halvingsPerSecond)
+{
+    halvingsPerSecond = qBound<qreal>(0.0, halvingsPerSecond, 10.0);
+    if (qFuzzyCompare(m_zoomSpeed, halvingsPerSecond))
+        return;
+    m_zoomSpeed = halvingsPerSecond;
+    emit zoomSpeedChanged();
+}
+
+void DeepMandelbrotItem::setMaxIterations(int iterations)
+{
+    iterations = qBound(MIN_ITERATIONS, iterations, MAX_ORBIT);
+    if (m_maxIterations == iterations)
+        return;
+    m_maxIterations = iterations;
+    emit maxIterationsChanged();
+    update();
+}
+
+QSGNode *DeepMandelbrotItem::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *)
+{
+    const double dt = m_clock.isValid() ? std::min(m_clock.restart() / 1000.0, 0.1) : 0.0;
+    if (!m_clock.isValid())
+        m_clock.start();
+
+    auto orbit = m_orbits->get(m_zoomTarget);
+    const QRectF rect = boundingRect();
+    if (!orbit || rect.isEmpty()) {
+        // Nothing to draw until the worker delivers the first orbit
+        delete oldNode;
+        return nullptr;
+    }
+
+    static const double MAX_HALVINGS = std::log2(START_SCALE / MIN_SCALE);
+    if (m_running) {
+        const double level = m_audioLevel;
+        m_halvings += dt * m_zoomSpeed * (1.0 + 3.0 * level);
+        m_angle     = std::fmod(m_angle + dt * (0.04 + 0.25 * level), 2.0 * M_PI);
+    }
+    if (m_halvings >= MAX_HALVINGS) {
+        const int next = (m_zoomTarget + 1) % TARGET_COUNT;
+        if (auto nextOrbit = m_orbits->get(next)) {
+            m_zoomTarget = next;
+            m_halvings   = 0.0;
+            orbit        = std::move(nextOrbit);
+            m_orbits->request((next + 1) % TARGET_COUNT);
+        } else {
+            m_halvings = MAX_HALVINGS;   // hold the deepest frame until it arrives
+            m_orbits->request(next);
+        }
+    }
+
+    auto *node = static_cast<DeepMandelbrotNode *>(oldNode);
+    if (!node)
+        node = new DeepMandelbrotNode;
+
+    if (node->rect != rect) {
+        node->rect = rect;
+        QSGGeometry::updateTexturedRectGeometry(node->geometry(), rect, QRectF(0, 0, 1, 1));
+        node->markDirty(QSGNode::DirtyGeometry);
+    }
+
+    DeepMandelbrotMaterial *mat = node->material();
+    mat->texture.setOrbit(orbit);
+    mat->scale       = static_cast<float>(START_SCALE * std::exp2(-m_halvings));
+    mat->aspect      = static_cast<float>(rect.width() / rect.height());
+    mat->angle       = static_cast<float>(m_angle);
+    mat->intensity   = static_cast<float>(0.8 + 0.2 * m_audioLevel);
+    mat->maxIter     = std::clamp(MIN_ITERATIONS + static_cast<int>(m_halvings * ITERATIONS_PER_HALVING),
+                                  MIN_ITERATIONS, m_maxIterations);
+    mat->colorScheme = m_colorScheme;
+    node->markDirty(QSGNode::DirtyMaterial);
+
+    m_liveTarget.store(m_zoomTarget, std::memory_order_relaxed);
+    m_liveDepth.store(m_halvings * std::log10(2.0), std::memory_order_relaxed);
+    return node;
+}
+
+void DeepMandelbrotItem::itemChange(ItemChange change, const ItemChangeData &value)
+{
+    if (change == ItemSceneChange) {
+        disconnect(m_frameConnection);
+        // frameSwapped is emitted on the render thread; the queued connection
+        // brings us back to the GUI thread to schedule the next step
+        if (value.window)
+            m_frameConnection = connect(value.window, &QQuickWindow::frameSwapped,
+                                        this, &DeepMandelbrotItem::onFrameSwapped,
+                                        Qt::QueuedConnection);
+    } else if (change == ItemVisibleHasChanged && value.boolValue) {
+        m_clock.invalidate();   // resume where the zoom was hidden
+        update();
+    }
+    QQuickItem::itemChange(change, value);
+}
+
+void DeepMandelbrotItem::onFrameSwapped()
+{
+    const int target = m_liveTarget.load(std::memory_order_relaxed);
+    if (target != m_target) {
+        m_target = target;
+        emit targetChanged();
+    }
+    const qreal depth = m_liveDepth.load(std::memory_order_relaxed);
+    if (!qFuzzyCompare(1.0 + depth, 1.0 + m_depth)) {
+        m_depth = depth;
+        emit depthChanged();
+    }
+    if (m_running && isVisible())
+        update();
+}
+
+#include "deepmandelbrotitem.moc"
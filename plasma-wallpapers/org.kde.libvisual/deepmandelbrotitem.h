@@ -0,0 +1,101 @@
+/*
+ * SPDX-FileCopyrightText: 2026 VitexSoftware <vitex@vitexsoftware.cz>
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QQuickItem>
+#include <QtQml/qqml.h>
+#include <atomic>
+#include <memory>
+
+class OrbitCache;
+
+/**
+ * Deep-zoom Mandelbrot set rendered with perturbation theory.
+ *
+ * A single reference orbit Z_n is iterated on the CPU in double-double
+ * precision (~32 significant digits) for a handful of fixed zoom targets.
+ * The orbits are computed on QThreadPool workers, never on the GUI or render
+ * thread, and uploaded once per target as a float texture.  The fragment
+ * shader then iterates only the per-pixel delta
+ *
+ *     dz_{n+1} = 2 Z_n dz_n + dz_n^2 + dc
+ *
+ * in single precision, which stays accurate far beyond the ~1e-6 limit of
+ * the plain float shader used by the "Mandelbrot (GPU)" type.  Pixels whose
+ * delta outgrows the orbit are rebased onto the start of the reference.
+ *
+ * The zoom runs down to about 1e-30 (float deltas would go denormal below
+ * that) and then moves on to the next target, whose orbit is already ready.
+ */
+class DeepMandelbrotItem : public QQuickItem
+{
+    Q_OBJECT
+    QML_ELEMENT
+
+    Q_PROPERTY(bool  running       READ isRunning     WRITE setRunning       NOTIFY runningChanged)
+    Q_PROPERTY(int   colorScheme   READ colorScheme   WRITE setColorScheme   NOTIFY colorSchemeChanged)
+    Q_PROPERTY(qreal audioLevel    READ audioLevel    WRITE setAudioLevel    NOTIFY audioLevelChanged)
+    Q_PROPERTY(qreal zoomSpeed     READ zoomSpeed     WRITE setZoomSpeed     NOTIFY zoomSpeedChanged)
+    Q_PROPERTY(int   maxIterations READ maxIterations WRITE setMaxIterations NOTIFY maxIterationsChanged)
+    Q_PROPERTY(int   target        READ target        NOTIFY targetChanged)
+    Q_PROPERTY(qreal depth         READ depth         NOTIFY depthChanged)
+
+public:
+    explicit DeepMandelbrotItem(QQuickItem *parent = nullptr);
+    ~DeepMandelbrotItem() override;
+
+    bool  isRunning()     const { return m_running; }
+    int   colorScheme()   const { return m_colorScheme; }
+    qreal audioLevel()    const { return m_audioLevel; }
+    qreal zoomSpeed()     const { return m_zoomSpeed; }
+    int   maxIterations() const { return m_maxIterations; }
+    int   target()        const { return m_target; }
+    qreal depth()         const { return m_depth; }
+
+    void setRunning(bool running);
+    void setColorScheme(int scheme);
+    void setAudioLevel(qreal level);
+    void setZoomSpeed(qreal halvingsPerSecond);
+    void setMaxIterations(int iterations);
+
+signals:
+    void runningChanged();
+    void colorSchemeChanged();
+    void audioLevelChanged();
+    void zoomSpeedChanged();
+    void maxIterationsChanged();
+    void targetChanged();
+    void depthChanged();
+
+protected:
+    QSGNode *updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *data) override;
+    void itemChange(ItemChange change, const ItemChangeData &value) override;
+
+private:
+    void onFrameSwapped();
+
+    QMetaObject::Connection m_frameConnection;
+
+    bool  m_running       = true;
+    int   m_colorScheme   = 0;
+    qreal m_audioLevel    = 0.0;
+    qreal m_zoomSpeed     = 0.6;    // view halvings per second at silence
+    int   m_maxIterations = 4096;   // upper bound; the shader ramps up with depth
+    int   m_target        = 0;      // last values published on the GUI thread
+    qreal m_depth         = 0.0;    // log10 of the magnification
+
+    // Shared with the worker threads computing reference orbits
+    std::shared_ptr<OrbitCache> m_orbits;
+
+    // Zoom state, touched only inside updatePaintNode() (GUI blocked)
+    int           m_zoomTarget = 0;
+    double        m_halvings   = 0.0;   // view scale = START_SCALE * 2^-halvings
+    double        m_angle      = 0.0;
+    QElapsedTimer m_clock;
+    std::atomic<int>    m_liveTarget{0};   // written by the render thread
+    std::atomic<double> m_liveDepth{0.0};
+};
@@ -0,0 +1,141 @@
+/*
+ * SPDX-FileCopyrightText: 2026 VitexSoftware <vitex@vitexsoftware.cz>
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "frameclock.h"
+
+#include <QDebug>
+#include <QQuickItem>
+#include <QQuickWindow>
+#include <QScreen>
+#include <algorithm>
+
+FrameClock::FrameClock(QObject *parent)
+    : QObject(parent)
+{
+    m_clock.start();
+}
+
+void FrameClock::setRunning(bool running)
+{
+    if (m_running == running)
+        return;
+    m_running = running;
+    if (m_running) {
+        // Resume without a jump in delta
+        m_lastTickNs = m_clock.nsecsElapsed();
+        requestFrames();
+    }
+    emit runningChanged();
+}
+
+void FrameClock::setTargetFps(qreal fps)
+{
+    fps = std::max<qreal>(0.0, fps);
+    if (qFuzzyCompare(m_targetFps, fps))
+        return;
+    m_targetFps = fps;
+    emit targetFpsChanged();
+}
+
+void FrameClock::registerItem(QQuickItem *item)
+{
+    if (!item || m_items.contains(item))
+        return;
+    m_items.append(item);
+    connect(item, &QQuickItem::windowChanged, this, &FrameClock::updateWindows);
+    connect(item, &QObject::destroyed, this, &FrameClock::updateWindows, Qt::QueuedConnection);
+    updateWindows();
+}
+
+bool FrameClock::isDue(qreal fps) const
+{
+    if (fps <= 0.0)
+        return true;
+    const qreal tickRate = m_refreshRate / divisor();
+    const qint64 every   = std::max<qint64>(1, qRound64(tickRate / fps));
+    return m_frameIndex % every == 0;
+}
+
+void FrameClock::updateWindows()
+{
+    m_items.removeAll(nullptr);
+    m_windows.clear();
+    for (const auto &item : std::as_const(m_items)) {
+        QQuickWindow *window = item->window();
+        if (window && !m_windows.contains(window))
+            m_windows.append(window);
+    }
+
+    QQuickWindow *driver = m_windows.isEmpty() ? nullptr : m_windows.first().data();
+    if (driver == m_driver)
+        return;
+
+    disconnect(m_animatingConnection);
+    disconnect(m_screenConnection);
+    m_driver = driver;
+    if (!m_driver)
+        return;
+
+    // afterAnimating is emitted on the GUI thread once per frame, right before
+    // the scene graph is synchronised — the natural point to advance QML state
+    m_animatingConnection = connect(m_driver, &QQuickWindow::afterAnimating,
+                                    this, &FrameClock::onAfterAnimating);
+    m_screenConnection = connect(m_driver, &QWindow::screenChanged,
+                                 this, &FrameClock::updateRefreshRate);
+    updateRefreshRate();
+    qDebug() << "FrameClock: pacing from window" << m_driver << "at" << m_refreshRate << "Hz";
+
+    m_lastTickNs = m_clock.nsecsElapsed();
+    requestFrames();
+}
+
+void FrameClock::updateRefreshRate()
+{
+    const QScreen *screen = m_driver ? m_driver->screen() : nullptr;
+    const qreal rate = screen && screen->refreshRate() > 1.0 ? screen->refreshRate() : 60.0;
+    if (qFuzzyCompare(m_refreshRate, rate))
+        return;
+    m_refreshRate = rate;
+    emit refreshRateChanged();
+}
+
+int FrameClock::divisor() const
+{
+    if (m_targetFps <= 0.0 || m_targetFps >= m_refreshRate)
+        return 1;
+    return std::max(1, qRound(m_refreshRate / m_targetFps));
+}
+
+void FrameClock::onAfterAnimating()
+{
+    if (!m_running)
+        return;
+
+    if (++m_displayFrames % static_cast<quint64>(divisor()) == 0) {
+        const qint64 now = m_clock.nsecsElapsed();
+        m_delta      = (now - m_lastTickNs) / 1e9;
+        m_time       = now / 1e9;
+        m_lastTickNs = now;
+        ++m_frameIndex;
+        emit tick();
+    }
+
+    // Keep the render loop going; the next afterAnimating is the next tick
+    requestFrames();
+}
+
+void FrameClock::requestFrames()
+{
+    if (!m_running)
+        return;
+    // Windows nobody can see (covered, locked, minimised) are left idle;
+    // the frame Qt renders when one is exposed again restarts the loop
+    for (const auto &window : std::as_const(m_windows)) {
+        if (window && window->isExposed())
+            window->update();
+    }
+}
+
+#include "frameclock.moc"
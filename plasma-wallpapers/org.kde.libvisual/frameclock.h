@@ -0,0 +1,97 @@
+/*
+ * SPDX-FileCopyrightText: 2026 VitexSoftware <vitex@vitexsoftware.cz>
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <QtQml/qqml.h>
+
+class QQuickItem;
+class QQuickWindow;
+
+/**
+ * Frame-synchronous animation clock shared by every visualization.
+ *
+ * Instead of free-running QML Timers the clock ticks from
+ * QQuickWindow::afterAnimating of the window its registered items live in,
+ * i.e. exactly once per frame the scene graph actually prepares, in step
+ * with vsync.  time/delta are taken from a monotonic clock at that moment,
+ * so animations advance by real elapsed time rather than an assumed 16 ms.
+ *
+ * targetFps divides the display rate (e.g. 30 on a 60 Hz screen ticks every
+ * other frame); isDue() offers the same division per consumer for modes that
+ * only need to repaint at a lower rate.
+ *
+ * Usage from QML:
+ *     Component.onCompleted: FrameClock.registerItem(root)
+ *     property real t: FrameClock.time
+ */
+class FrameClock : public QObject
+{
+    Q_OBJECT
+    QML_ELEMENT
+    QML_SINGLETON
+
+    Q_PROPERTY(bool   running     READ isRunning   WRITE setRunning   NOTIFY runningChanged)
+    Q_PROPERTY(qreal  targetFps   READ targetFps   WRITE setTargetFps NOTIFY targetFpsChanged)
+    Q_PROPERTY(qreal  refreshRate READ refreshRate NOTIFY refreshRateChanged)
+    Q_PROPERTY(double time        READ time        NOTIFY tick)
+    Q_PROPERTY(double delta       READ delta       NOTIFY tick)
+    Q_PROPERTY(qint64 frameIndex  READ frameIndex  NOTIFY tick)
+
+public:
+    explicit FrameClock(QObject *parent = nullptr);
+
+    bool   isRunning()   const { return m_running; }
+    qreal  targetFps()   const { return m_targetFps; }
+    qreal  refreshRate() const { return m_refreshRate; }
+    double time()        const { return m_time; }
+    double delta()       const { return m_delta; }
+    qint64 frameIndex()  const { return m_frameIndex; }
+
+    void setRunning(bool running);
+    void setTargetFps(qreal fps);
+
+    // Ties the clock to the window the item is (or will be) shown in.  Several
+    // items/windows may register; the first live window paces the clock and
+    // all of them are asked for a new frame after every tick.
+    Q_INVOKABLE void registerItem(QQuickItem *item);
+
+    // True on the ticks a consumer wanting fps repaints should act on
+    Q_INVOKABLE bool isDue(qreal fps) const;
+
+signals:
+    void tick();
+    void runningChanged();
+    void targetFpsChanged();
+    void refreshRateChanged();
+
+private:
+    void updateWindows();
+    void updateRefreshRate();
+    void onAfterAnimating();
+    void requestFrames();
+    int  divisor() const;
+
+    QList<QPointer<QQuickItem>>   m_items;
+    QList<QPointer<QQuickWindow>> m_windows;
+    QPointer<QQuickWindow>        m_driver;
+    QMetaObject::Connection       m_animatingConnection;
+    QMetaObject::Connection       m_screenConnection;
+
+    bool   m_running     = true;
+    qreal  m_targetFps   = 0.0;    // 0 = every display frame
+    qreal  m_refreshRate = 60.0;
+    double m_time        = 0.0;    // seconds since the clock started
+    double m_delta       = 0.0;    // seconds since the previous tick
+    qint64 m_frameIndex  = 0;      // ticks emitted so far
+
+    QElapsedTimer m_clock;
+    qint64        m_lastTickNs    = 0;
+    quint64       m_displayFrames = 0;   // afterAnimating calls, before division
+};
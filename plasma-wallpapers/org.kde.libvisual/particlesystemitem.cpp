@@ -0,0 +1,540 @@
+/*
+ * SPDX-FileCopyrightText: 2026 VitexSoftware <vitex@vitexsoftware.cz>
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "particlesystemitem.h"
+#include "audiovisualizer.h"
+
+#include <QQuickWindow>
+#include <QSGGeometry>
+#include <QSGGeometryNode>
+#include <QSGMaterial>
+#include <QSGMaterialShader>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define PARTICLES_USE_SSE2 1
+#endif
+
+// ---------------------------------------------------------------------------
+// ParticleStore — structure of arrays, 32-byte aligned, padded to 8 lanes
+// ---------------------------------------------------------------------------
+
+struct ParticleStore
+{
+    static constexpr size_t ALIGNMENT = 32;
+
+    explicit ParticleStore(int requested)
+        : capacity((requested + 7) & ~7)
+    {
+        for (float **array : {&px, &py, &vx, &vy, &life, &decay, &size})
+            *array = allocate<float>();
+        color = allocate<quint32>();
+    }
+
+    ~ParticleStore()
+    {
+        for (float *array : {px, py, vx, vy, life, decay, size})
+            qFreeAligned(array);
+        qFreeAligned(color);
+    }
+
+    ParticleStore(const ParticleStore &) = delete;
+    ParticleStore &operator=(const ParticleStore &) = delete;
+
+    // Removes particle i by moving the last live particle into its slot
+    void removeAt(int i)
+    {
+        const int last = --count;
+        px[i]    = px[last];
+        py[i]    = py[last];
+        vx[i]    = vx[last];
+        vy[i]    = vy[last];
+        life[i]  = life[last];
+        decay[i] = decay[last];
+        size[i]  = size[last];
+        color[i] = color[last];
+    }
+
+    const int capacity;
+    int       count = 0;
+
+    float   *px    = nullptr;   // position, item pixels
+    float   *py    = nullptr;
+    float   *vx    = nullptr;   // velocity, item pixels per second
+    float   *vy    = nullptr;
+    float   *life  = nullptr;   // 1 at birth, dead at 0
+    float   *decay = nullptr;   // life lost per second
+    float   *size  = nullptr;   // sprite diameter at birth
+    quint32 *color = nullptr;   // 0xAABBGGRR, alpha is applied from life
+
+private:
+    template<typename T>
+    T *allocate()
+    {
+        void *p = qMallocAligned(sizeof(T) * capacity, ALIGNMENT);
+        std::memset(p, 0, sizeof(T) * capacity);
+        return static_cast<T *>(p);
+    }
+};
+
+namespace {
+
+constexpr int   VERTICES_PER_PARTICLE = 4;
+constexpr int   INDICES_PER_PARTICLE  = 6;
+constexpr int   GEOMETRY_CHUNK        = 1024;   // particles; limits reallocations
+constexpr float MAX_STEP              = 0.05f;  // seconds; clamps stalls
+
+// Euler step over the whole store:
+//   v = v * damping + g * dt;  p += v * dt * speed;  life -= decay * dt
+// Lanes past count are padding and are integrated harmlessly.
+void integrate(ParticleStore &s, float dt, float gx, float gy, float damping, float speed)
+{
+    const int   lanes = (s.count + 3) & ~3;
+    const float step  = dt * speed;
+#ifdef PARTICLES_USE_SSE2
+    const __m128 vDt   = _mm_set1_ps(dt);
+    const __m128 vStep = _mm_set1_ps(step);
+    const __m128 vDamp = _mm_set1_ps(damping);
+    const __m128 vGx   = _mm_set1_ps(gx * dt);
+    const __m128 vGy   = _mm_set1_ps(gy * dt);
+    for (int i = 0; i < lanes; i += 4) {
+        __m128 vx = _mm_add_ps(_mm_mul_ps(_mm_load_ps(s.vx + i), vDamp), vGx);
+        __m128 vy = _mm_add_ps(_mm_mul_ps(_mm_load_ps(s.vy + i), vDamp), vGy);
+        _mm_store_ps(s.vx + i, vx);
+        _mm_store_ps(s.vy + i, vy);
+        _mm_store_ps(s.px + i, _mm_add_ps(_mm_load_ps(s.px + i), _mm_mul_ps(vx, vStep)));
+        _mm_store_ps(s.py + i, _mm_add_ps(_mm_load_ps(s.py + i), _mm_mul_ps(vy, vStep)));
+        _mm_store_ps(s.life + i, _mm_sub_ps(_mm_load_ps(s.life + i),
+                                            _mm_mul_ps(_mm_load_ps(s.decay + i), vDt)));
+    }
+#else
+    for (int i = 0; i < lanes; ++i) {
+        s.vx[i] = s.vx[i] * damping + gx * dt;
+        s.vy[i] = s.vy[i] * damping + gy * dt;
+        s.px[i] += s.vx[i] * step;
+        s.py[i] += s.vy[i] * step;
+        s.life[i] -= s.decay[i] * dt;
+    }
+#endif
+}
+
+quint32 packColor(const QColor &c)
+{
+    return quint32(c.red()) | quint32(c.green()) << 8 | quint32(c.blue()) << 16 | 0xff000000u;
+}
+
+struct SpriteVertex {
+    float x;
+    float y;
+    float u;        // corner in [-1, 1], the fragment shader makes it round
+    float v;
+    uchar r, g, b, a;
+};
+
+const QSGGeometry::AttributeSet &spriteAttributes()
+{
+    static const QSGGeometry::Attribute attrs[] = {
+        QSGGeometry::Attribute::createWithAttributeType(0, 2, QSGGeometry::FloatType,
+                                                        QSGGeometry::PositionAttribute),
+        QSGGeometry::Attribute::createWithAttributeType(1, 2, QSGGeometry::FloatType,
+                                                        QSGGeometry::TexCoordAttribute),
+        QSGGeometry::Attribute::createWithAttributeType(2, 4, QSGGeometry::UnsignedByteType,
+                                                        QSGGeometry::ColorAttribute),
+    };
+    static const QSGGeometry::AttributeSet set = {3, sizeof(SpriteVertex), attrs};
+    return set;
+}
+
+// ---------------------------------------------------------------------------
+// Material + shader — soft round sprite from the quad corner coordinate
+// ---------------------------------------------------------------------------
+
+class ParticleMaterial : public QSGMaterial
+{
+public:
+    ParticleMaterial() { setFlag(Blending); }
+
+    QSGMaterialType *type() const override
+    {
+        static QSGMaterialType materialType;
+        return &materialType;
+    }
+
+    QSGMaterialShader *createShader(QSGRendererInterface::RenderMode) const override;
+
+    int compare(const QSGMaterial *) const override { return 0; }   // stateless
+};
+
+class ParticleShader : public QSGMaterialShader
+{
+public:
+    ParticleShader()
+    {
+        setShaderFileName(VertexStage,   QStringLiteral(":/audiovisualizer/shaders/particle.vert.qsb"));
+        setShaderFileName(FragmentStage, QStringLiteral(":/audiovisualizer/shaders/particle.frag.qsb"));
+    }
+
+    // std140 layout: mat4 qt_Matrix, float qt_Opacity
+    bool updateUniformData(RenderState &state, QSGMaterial *, QSGMaterial *) override
+    {
+        QByteArray *buf = state.uniformData();
+        bool changed = false;
+        if (state.isMatrixDirty()) {
+            std::memcpy(buf->data(), state.combinedMatrix().constData(), 64);
+            changed = true;
+        }
+        if (state.isOpacityDirty()) {
+            const float opacity = state.opacity();
+            std::memcpy(buf->data() + 64, &opacity, 4);
+            changed = true;
+        }
+        return changed;
+    }
+};
+
+QSGMaterialShader *ParticleMaterial::createShader(QSGRendererInterface::RenderMode) const
+{
+    return new ParticleShader;
+}
+
+class ParticleNode : public QSGGeometryNode
+{
+public:
+    ParticleNode()
+        : m_geometry(spriteAttributes(), 0, 0, QSGGeometry::UnsignedIntType)
+    {
+        m_geometry.setDrawingMode(QSGGeometry::DrawTriangles);
+        m_geometry.setVertexDataPattern(QSGGeometry::DynamicPattern);
+        m_geometry.setIndexDataPattern(QSGGeometry::StaticPattern);
+        setGeometry(&m_geometry);
+        setMaterial(&m_material);
+    }
+
+    // Grows/shrinks in GEOMETRY_CHUNK steps; the index buffer is only
+    // rewritten (and re-uploaded) when the chunk count changes.  Unused
+    // quads in the last chunk are collapsed to zero area.
+    SpriteVertex *reserve(int particles)
+    {
+        const int quads = std::max(GEOMETRY_CHUNK, (particles + GEOMETRY_CHUNK - 1) / GEOMETRY_CHUNK * GEOMETRY_CHUNK);
+        if (quads != m_quads) {
+            m_quads = quads;
+            m_geometry.allocate(quads * VERTICES_PER_PARTICLE, quads * INDICES_PER_PARTICLE);
+            quint32 *idx = m_geometry.indexDataAsUInt();
+            for (int q = 0; q < quads; ++q) {
+                const quint32 base = quint32(q) * VERTICES_PER_PARTICLE;
+                const quint32 quad[INDICES_PER_PARTICLE] = {base, base + 1, base + 2, base + 2, base + 1, base + 3};
+                std::memcpy(idx + q * INDICES_PER_PARTICLE, quad, sizeof(quad));
+            }
+            markDirty(QSGNode::DirtyGeometry);
+        }
+        return static_cast<SpriteVertex *>(m_geometry.vertexData());
+    }
+
+    int quadCapacity() const { return m_quads; }
+
+private:
+    QSGGeometry      m_geometry;
+    ParticleMaterial m_material;
+    int              m_quads = 0;
+};
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// ParticleSystemItem — Qt main thread (properties) / render thread (simulation)
+// ---------------------------------------------------------------------------
+
+ParticleSystemItem::ParticleSystemItem(QQuickItem *parent)
+    : QQuickItem(parent)
+    , m_rng(QRandomGenerator::securelySeeded())
+{
+    setFlag(ItemHasContents, true);
+    m_spectrum.assign(static_cast<size_t>(AudioVisualizer::spectrumSize()), 0.0f);
+}
+
+ParticleSystemItem::~ParticleSystemItem() = default;
+
+void ParticleSystemItem::setAudioSource(AudioVisualizer *source)
+{
+    if (m_audioSource == source)
+        return;
+    m_audioSource = source;
+    emit audioSourceChanged();
+}
+
+void ParticleSystemItem::setRunning(bool running)
+{
+    if (m_running == running)
+        return;
+    m_running = running;
+    emit runningChanged();
+    update();
+}
+
+void ParticleSystemItem::setMode(Mode mode)
+{
+    if (m_mode == mode)
+        return;
+    m_mode = mode;
+    emit modeChanged();
+    update();
+}
+
+void ParticleSystemItem::setMaxParticles(int count)
+{
+    count = qBound(64, count, 200000);
+    if (m_maxParticles == count)
+        return;
+    m_maxParticles = count;
+    emit maxParticlesChanged();
+    update();
+}
+
+void ParticleSystemItem::setEmissionRate(qreal perSecond)
+{
+    perSecond = std::max(0.0, perSecond);
+    if (qFuzzyCompare(m_emissionRate, perSecond))
+        return;
+    m_emissionRate = perSecond;
+    emit emissionRateChanged();
+}
+
+void ParticleSystemItem::setBurstSize(int count)
+{
+    count = std::max(1, count);
+    if (m_burstSize == count)
+        return;
+    m_burstSize = count;
+    emit burstSizeChanged();
+}
+
+void ParticleSystemItem::setBeatThreshold(qreal level)
+{
+    if (qFuzzyCompare(m_beatThreshold, level))
+        return;
+    m_beatThreshold = level;
+    emit beatThresholdChanged();
+}
+
+void ParticleSystemItem::setParticleSize(qreal size)
+{
+    size = std::max(0.5, size);
+    if (qFuzzyCompare(m_particleSize, size))
+        return;
+    m_particleSize = size;
+    emit particleSizeChanged();
+}
+
+void ParticleSystemItem::setSensitivity(qreal sensitivity)
+{
+    if (qFuzzyCompare(m_sensitivity, sensitivity))
+        return;
+    m_sensitivity = sensitivity;
+    emit sensitivityChanged();
+}
+
+void ParticleSystemItem::setColor(const QColor &color)
+{
+    if (m_color == color)
+        return;
+    m_color = color;
+    emit colorChanged();
+}
+
+void ParticleSystemItem::setHueSpread(qreal spread)
+{
+    spread = qBound(0.0, spread, 1.0);
+    if (qFuzzyCompare(m_hueSpread, spread))
+        return;
+    m_hueSpread = spread;
+    emit hueSpreadChanged();
+}
+
+void ParticleSystemItem::itemChange(ItemChange change, const ItemChangeData &value)
+{
+    if (change == ItemSceneChange) {
+        disconnect(m_frameConnection);
+        // frameSwapped is emitted on the render thread; the queued connection
+        // brings us back to the GUI thread to schedule the next step
+        if (value.window)
+            m_frameConnection = connect(value.window, &QQuickWindow::frameSwapped,
+                                        this, &ParticleSystemItem::onFrameSwapped,
+                                        Qt::QueuedConnection);
+    } else if (change == ItemVisibleHasChanged && value.boolValue) {
+        update();   // restart the frame loop after being hidden
+    }
+    QQuickItem::itemChange(change, value);
+}
+
+void ParticleSystemItem::onFrameSwapped()
+{
+    const int live = m_liveCount.load(std::memory_order_relaxed);
+    if (live != m_particleCount) {
+        m_particleCount = live;
+        emit particleCountChanged();
+    }
+    if (m_running && isVisible())
+        update();
+}
+
+// Render thread (GUI blocked): the same bass/mid/treble split as main.qml
+void ParticleSystemItem::updateBands()
+{
+    if (!m_audioSource) {
+        m_bass = m_mid = m_treble = 0.0f;
+        return;
+    }
+    m_audioSource->spectrumRing()->readLatest(m_spectrum.data(), AudioVisualizer::spectrumSize());
+    auto band = [this](int first, int last) {
+        float sum = 0.0f;
+        for (int i = first; i < last; ++i)
+            sum += m_spectrum[static_cast<size_t>(i)];
+        return std::clamp(sum / (last - first) * static_cast<float>(m_sensitivity), 0.0f, 1.0f);
+    };
+    m_bass   = band(0, 16);
+    m_mid    = band(16, 40);
+    m_treble = band(40, 64);
+}
+
+void ParticleSystemItem::spawn(float x, float y, float vx, float vy, float lifetime, float hue)
+{
+    ParticleStore &s = *m_store;
+    if (s.count >= std::min(s.capacity, m_maxParticles))
+        return;
+    const int i = s.count++;
+    s.px[i]    = x;
+    s.py[i]    = y;
+    s.vx[i]    = vx;
+    s.vy[i]    = vy;
+    s.life[i]  = 1.0f;
+    s.decay[i] = 1.0f / lifetime;
+    s.size[i]  = static_cast<float>(m_particleSize) * (0.6f + 0.8f * static_cast<float>(m_rng.generateDouble()));
+    s.color[i] = packColor(QColor::fromHsvF(hue, m_color.hsvSaturationF(), m_color.valueF()));
+}
+
+void ParticleSystemItem::emitParticles(float dt)
+{
+    const float w      = static_cast<float>(width());
+    const float h      = static_cast<float>(height());
+    const float minDim = std::min(w, h);
+    const float twoPi  = 6.28318530718f;
+    const float spread = static_cast<float>(m_hueSpread);
+    const float baseHue = std::max(0.0f, static_cast<float>(m_color.hsvHueF()));
+    auto random = [this] { return static_cast<float>(m_rng.generateDouble()); };
+    auto jitterHue = [&](float hue) {
+        const float h2 = hue + (random() - 0.5f) * spread;
+        return h2 - std::floor(h2);
+    };
+
+    if (m_mode == Starfield) {
+        // Stream from the centre; overall level raises both rate and speed
+        const float level = (m_bass + m_mid + m_treble) / 3.0f;
+        m_emitDebt += static_cast<float>(m_emissionRate) * (0.25f + 0.75f * level) * dt;
+        const int n = static_cast<int>(m_emitDebt);
+        m_emitDebt -= n;
+        for (int k = 0; k < n; ++k) {
+            const float angle = random() * twoPi;
+            const float speed = minDim * (0.03f + 0.15f * random());
+            spawn(w * 0.5f, h * 0.5f, std::cos(angle) * speed, std::sin(angle) * speed,
+                  2.0f + 3.0f * random(), jitterHue(baseHue));
+        }
+        return;
+    }
+
+    // Fireworks: one burst per bass beat, at most every 0.3 s
+    m_sinceBeat += dt;
+    if (m_bass <= static_cast<float>(m_beatThreshold) || m_sinceBeat < 0.3f)
+        return;
+    m_sinceBeat = 0.0f;
+    const float bx  = w * (0.2f + 0.6f * random());
+    const float by  = h * (0.2f + 0.5f * random());
+    const float hue = spread > 0.0f ? random() : baseHue;
+    for (int k = 0; k < m_burstSize; ++k) {
+        const float angle = random() * twoPi;
+        const float speed = minDim * (0.05f + 0.15f * random()) * (1.0f + 2.0f * m_bass);
+        spawn(bx, by, std::cos(angle) * speed, std::sin(angle) * speed - minDim * 0.05f,
+              1.6f + 0.8f * random(), hue);
+    }
+}
+
+void ParticleSystemItem::simulate(float dt)
+{
+    ParticleStore &s = *m_store;
+    const float minDim = static_cast<float>(std::min(width(), height()));
+
+    if (m_mode == Starfield) {
+        // Outward acceleration fakes perspective; loud passages speed everything up
+        const float level = (m_bass + m_mid + m_treble) / 3.0f;
+        integrate(s, dt, 0.0f, 0.0f, 1.0f + 1.2f * dt, 1.0f + 3.0f * level);
+    } else {
+        integrate(s, dt, 0.0f, minDim * 0.08f, 1.0f - 0.4f * dt, 1.0f);
+    }
+
+    // Cull the dead and the ones that left the item
+    const float margin = static_cast<float>(m_particleSize) * 4.0f;
+    const float maxX   = static_cast<float>(width()) + margin;
+    const float maxY   = static_cast<float>(height()) + margin;
+    for (int i = 0; i < s.count;) {
+        if (s.life[i] <= 0.0f || s.px[i] < -margin || s.py[i] < -margin || s.px[i] > maxX || s.py[i] > maxY)
+            s.removeAt(i);
+        else
+            ++i;
+    }
+}
+
+QSGNode *ParticleSystemItem::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *)
+{
+    auto *node = static_cast<ParticleNode *>(oldNode);
+    if (!node)
+        node = new ParticleNode;
+
+    if (!m_store || m_store->capacity < m_maxParticles)
+        m_store = std::make_unique<ParticleStore>(m_maxParticles);
+    ParticleStore &s = *m_store;
+    s.count = std::min(s.count, m_maxParticles);
+
+    const float dt = m_clock.isValid() ? std::min(m_clock.restart() / 1000.0f, MAX_STEP) : 0.0f;
+    if (!m_clock.isValid())
+        m_clock.start();
+
+    if (m_running && dt > 0.0f) {
+        updateBands();
+        simulate(dt);
+        emitParticles(dt);
+    }
+    m_liveCount.store(s.count, std::memory_order_relaxed);
+
+    SpriteVertex *v = node->reserve(s.count);
+    const bool starfield = m_mode == Starfield;
+    for (int i = 0; i < s.count; ++i) {
+        const float life = std::clamp(s.life[i], 0.0f, 1.0f);
+        // Stars fade in and grow as they approach; sparks shrink and fade out
+        const float alpha  = starfield ? std::min(1.0f, (1.0f - life) * 4.0f) : life;
+        const float radius = 0.5f * s.size[i] * (starfield ? 1.0f + 3.0f * (1.0f - life) : 0.5f + life);
+        const quint32 c = s.color[i];
+        const uchar r = uchar((c & 0xff) * alpha);
+        const uchar g = uchar(((c >> 8) & 0xff) * alpha);
+        const uchar b = uchar(((c >> 16) & 0xff) * alpha);
+        const uchar a = uchar(255.0f * alpha);
+        const float x = s.px[i];
+        const float y = s.py[i];
+        v[0] = {x - radius, y - radius, -1.0f, -1.0f, r, g, b, a};
+        v[1] = {x + radius, y - radius,  1.0f, -1.0f, r, g, b, a};
+        v[2] = {x - radius, y + radius, -1.0f,  1.0f, r, g, b, a};
+        v[3] = {x + radius, y + radius,  1.0f,  1.0f, r, g, b, a};
+        v += VERTICES_PER_PARTICLE;
+    }
+    // Collapse the unused tail of the current chunk
+    const int unused = (node->quadCapacity() - s.count) * VERTICES_PER_PARTICLE;
+    std::memset(static_cast<void *>(v), 0, sizeof(SpriteVertex) * unused);
+
+    node->markDirty(QSGNode::DirtyGeometry);
+    return node;
+}
+
+#include "particlesystemitem.moc"
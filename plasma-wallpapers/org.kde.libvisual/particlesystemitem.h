@@ -0,0 +1,138 @@
+/*
+ * SPDX-FileCopyrightText: 2026 VitexSoftware <vitex@vitexsoftware.cz>
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <QColor>
+#include <QElapsedTimer>
+#include <QPointer>
+#include <QQuickItem>
+#include <QRandomGenerator>
+#include <QtQml/qqml.h>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+class AudioVisualizer;
+struct ParticleStore;
+
+/**
+ * Audio-reactive particle system simulated in C++ and drawn by one node.
+ *
+ * Particle state is kept as a structure of arrays (positions, velocities,
+ * lifetimes, sizes and colours in separate 32-byte aligned arrays) so the
+ * integration step runs four particles per SSE instruction.  Emitters are
+ * driven by bass/mid/treble levels taken from the AudioVisualizer spectrum
+ * ring.  All live particles become soft round sprites in a single indexed
+ * geometry, i.e. one draw call whatever the particle count.
+ *
+ * The item animates on its own from QQuickWindow::frameSwapped while it is
+ * visible and running; no QML timers or bindings are involved per particle.
+ */
+class ParticleSystemItem : public QQuickItem
+{
+    Q_OBJECT
+    QML_ELEMENT
+
+    Q_PROPERTY(AudioVisualizer *audioSource READ audioSource WRITE setAudioSource NOTIFY audioSourceChanged)
+    Q_PROPERTY(bool   running       READ isRunning     WRITE setRunning       NOTIFY runningChanged)
+    Q_PROPERTY(Mode   mode          READ mode          WRITE setMode          NOTIFY modeChanged)
+    Q_PROPERTY(int    maxParticles  READ maxParticles  WRITE setMaxParticles  NOTIFY maxParticlesChanged)
+    Q_PROPERTY(qreal  emissionRate  READ emissionRate  WRITE setEmissionRate  NOTIFY emissionRateChanged)
+    Q_PROPERTY(int    burstSize     READ burstSize     WRITE setBurstSize     NOTIFY burstSizeChanged)
+    Q_PROPERTY(qreal  beatThreshold READ beatThreshold WRITE setBeatThreshold NOTIFY beatThresholdChanged)
+    Q_PROPERTY(qreal  particleSize  READ particleSize  WRITE setParticleSize  NOTIFY particleSizeChanged)
+    Q_PROPERTY(qreal  sensitivity   READ sensitivity   WRITE setSensitivity   NOTIFY sensitivityChanged)
+    Q_PROPERTY(QColor color         READ color         WRITE setColor         NOTIFY colorChanged)
+    Q_PROPERTY(qreal  hueSpread     READ hueSpread     WRITE setHueSpread     NOTIFY hueSpreadChanged)
+    Q_PROPERTY(int    particleCount READ particleCount NOTIFY particleCountChanged)
+
+public:
+    enum Mode {
+        Starfield, // continuous stream flying outward from the centre, rate follows the overall level
+        Fireworks  // bursts at random points on bass beats, pulled down by gravity
+    };
+    Q_ENUM(Mode)
+
+    explicit ParticleSystemItem(QQuickItem *parent = nullptr);
+    ~ParticleSystemItem() override;
+
+    AudioVisualizer *audioSource() const { return m_audioSource; }
+    bool   isRunning()     const { return m_running; }
+    Mode   mode()          const { return m_mode; }
+    int    maxParticles()  const { return m_maxParticles; }
+    qreal  emissionRate()  const { return m_emissionRate; }
+    int    burstSize()     const { return m_burstSize; }
+    qreal  beatThreshold() const { return m_beatThreshold; }
+    qreal  particleSize()  const { return m_particleSize; }
+    qreal  sensitivity()   const { return m_sensitivity; }
+    QColor color()         const { return m_color; }
+    qreal  hueSpread()     const { return m_hueSpread; }
+    int    particleCount() const { return m_particleCount; }
+
+    void setAudioSource(AudioVisualizer *source);
+    void setRunning(bool running);
+    void setMode(Mode mode);
+    void setMaxParticles(int count);
+    void setEmissionRate(qreal perSecond);
+    void setBurstSize(int count);
+    void setBeatThreshold(qreal level);
+    void setParticleSize(qreal size);
+    void setSensitivity(qreal sensitivity);
+    void setColor(const QColor &color);
+    void setHueSpread(qreal spread);
+
+signals:
+    void audioSourceChanged();
+    void runningChanged();
+    void modeChanged();
+    void maxParticlesChanged();
+    void emissionRateChanged();
+    void burstSizeChanged();
+    void beatThresholdChanged();
+    void particleSizeChanged();
+    void sensitivityChanged();
+    void colorChanged();
+    void hueSpreadChanged();
+    void particleCountChanged();
+
+protected:
+    QSGNode *updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *data) override;
+    void itemChange(ItemChange change, const ItemChangeData &value) override;
+
+private:
+    void onFrameSwapped();
+    void updateBands();
+    void emitParticles(float dt);
+    void spawn(float x, float y, float vx, float vy, float lifetime, float hue);
+    void simulate(float dt);
+
+    QPointer<AudioVisualizer> m_audioSource;
+    QMetaObject::Connection   m_frameConnection;
+
+    bool   m_running       = true;
+    Mode   m_mode          = Starfield;
+    int    m_maxParticles  = 20000;
+    qreal  m_emissionRate  = 3000.0;   // particles per second at full level
+    int    m_burstSize     = 400;
+    qreal  m_beatThreshold = 0.5;
+    qreal  m_particleSize  = 2.5;      // logical pixels
+    qreal  m_sensitivity   = 1.0;
+    QColor m_color         = QColor(200, 220, 255);
+    qreal  m_hueSpread     = 0.0;      // 0 = all particles in color, 1 = any hue
+    int    m_particleCount = 0;        // last value published on the GUI thread
+
+    // Simulation state, touched only inside updatePaintNode() (GUI blocked)
+    std::unique_ptr<ParticleStore> m_store;
+    std::vector<float> m_spectrum;
+    float              m_bass   = 0.0f;
+    float              m_mid    = 0.0f;
+    float              m_treble = 0.0f;
+    float              m_emitDebt = 0.0f;   // fractional particles carried to the next frame
+    float              m_sinceBeat = 0.0f;
+    QElapsedTimer      m_clock;
+    QRandomGenerator   m_rng;
+    std::atomic<int>   m_liveCount{0};  // written by the render thread
+};
@@ -0,0 +1,354 @@
+/*
+ * SPDX-FileCopyrightText: 2026 VitexSoftware <vitex@vitexsoftware.cz>
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "presetmodel.h"
+
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThreadPool>
+#include <algorithm>
+#include <iterator>
+
+namespace {
+
+constexpr int BATCH_SIZE = 256;   // presets per queued delivery to the GUI thread
+
+const QString PRESET_SEPARATOR = QStringLiteral(" - ");
+
+// Milkdrop packs name presets "Author - Title" or "Category - Author - Title"
+PresetModel::Preset parsePreset(const QString &fileName)
+{
+    PresetModel::Preset preset;
+    preset.fileName = fileName;
+    preset.name     = QFileInfo(fileName).completeBaseName();
+
+    const QStringList parts = preset.name.split(PRESET_SEPARATOR);
+    if (parts.size() >= 3) {
+        preset.category = parts.at(0).trimmed();
+        preset.author   = parts.at(1).trimmed();
+    } else if (parts.size() == 2) {
+        preset.author = parts.at(0).trimmed();
+    }
+
+    // The name already contains author and category
+    preset.haystack = PresetModel::foldCase(preset.name);
+    preset.trigrams = PresetModel::trigramsOf(preset.haystack);
+    return preset;
+}
+
+std::vector<int> intersect(const std::vector<int> &a, const std::vector<int> &b)
+{
+    std::vector<int> out;
+    out.reserve(std::min(a.size(), b.size()));
+    std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(out));
+    return out;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// PresetScan — one directory load on a QThreadPool worker
+// ---------------------------------------------------------------------------
+
+class PresetScan : public std::enable_shared_from_this<PresetScan>
+{
+public:
+    PresetScan(PresetModel *model, const QString &path)
+        : m_model(model)
+        , m_path(path)
+    {
+    }
+
+    void start()
+    {
+        QThreadPool::globalInstance()->start([self = shared_from_this()] { self->run(); });
+    }
+
+    // Called by the model before it forgets this scan or is destroyed; once
+    // it returns the worker will not post anything else
+    void cancel()
+    {
+        QMutexLocker lock(&m_mutex);
+        m_model = nullptr;
+    }
+
+private:
+    void run()
+    {
+        // Same listing and order as ProjectMItem::scanPresets(), so row
+        // positions in the unfiltered model are projectM playlist indices
+        const QStringList files = QDir(m_path).entryList(
+            {QStringLiteral("*.milk"), QStringLiteral("*.prjm")}, QDir::Files, QDir::Name);
+
+        std::vector<PresetModel::Preset> batch;
+        batch.reserve(BATCH_SIZE);
+        for (const QString &file : files) {
+            batch.push_back(parsePreset(file));
+            if (batch.size() == BATCH_SIZE) {
+                if (!deliver(std::move(batch), false))
+                    return;
+                batch = {};
+                batch.reserve(BATCH_SIZE);
+            }
+        }
+        deliver(std::move(batch), true);
+    }
+
+    bool deliver(std::vector<PresetModel::Preset> batch, bool last)
+    {
+        QMutexLocker lock(&m_mutex);
+        if (!m_model)
+            return false;
+        // Held lock keeps the model alive while posting; if it is destroyed
+        // before the event is delivered Qt drops the event with it
+        auto presets = std::make_shared<std::vector<PresetModel::Preset>>(std::move(batch));
+        PresetModel *model = m_model;
+        QMetaObject::invokeMethod(model, [model, scan = this, presets, last] {
+            model->deliverBatch(scan, std::move(*presets), last);
+        }, Qt::QueuedConnection);
+        return true;
+    }
+
+    QMutex        m_mutex;
+    PresetModel  *m_model;
+    const QString m_path;
+};
+
+// ---------------------------------------------------------------------------
+// PresetModel — Qt main thread
+// ---------------------------------------------------------------------------
+
+PresetModel::PresetModel(QObject *parent)
+    : QAbstractListModel(parent)
+{
+}
+
+PresetModel::~PresetModel()
+{
+    if (m_scan)
+        m_scan->cancel();
+}
+
+QString PresetModel::foldCase(const QString &text)
+{
+    return text.toCaseFolded();
+}
+
+std::vector<quint64> PresetModel::trigramsOf(const QString &folded)
+{
+    std::vector<quint64> keys;
+    if (folded.size() < 3)
+        return keys;
+    keys.reserve(folded.size() - 2);
+    for (qsizetype i = 0; i + 2 < folded.size(); ++i) {
+        keys.push_back(quint64(folded.at(i).unicode()) << 32
+                       | quint64(folded.at(i + 1).unicode()) << 16
+                       | quint64(folded.at(i + 2).unicode()));
+    }
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    return keys;
+}
+
+void PresetModel::setPath(const QString &path)
+{
+    if (m_path == path)
+        return;
+    m_path = path;
+    emit pathChanged();
+    reload();
+}
+
+void PresetModel::setFilter(const QString &filter)
+{
+    if (m_filter == filter)
+        return;
+
+    // Typing more characters can only remove rows: refine the visible set
+    // instead of querying everything again
+    const QString folded    = foldCase(filter);
+    const bool    narrowing = !m_terms.isEmpty() && folded.startsWith(foldCase(m_filter));
+
+    m_filter = filter;
+    m_terms  = folded.split(QLatin1Char(' '), Qt::SkipEmptyParts);
+
+    std::vector<int> rows = query(narrowing ? &m_rows : nullptr);
+    beginResetModel();
+    m_rows = std::move(rows);
+    endResetModel();
+
+    emit filterChanged();
+    emit countChanged();
+}
+
+void PresetModel::reload()
+{
+    const bool wasLoading = isLoading();
+    if (m_scan) {
+        m_scan->cancel();
+        m_scan.reset();
+    }
+
+    beginResetModel();
+    m_presets.clear();
+    m_rows.clear();
+    m_index.clear();
+    endResetModel();
+    emit countChanged();
+    emit totalCountChanged();
+
+    if (!m_path.isEmpty()) {
+        m_scan = std::make_shared<PresetScan>(this, m_path);
+        m_scan->start();
+    }
+    if (wasLoading != isLoading())
+        emit loadingChanged();
+}
+
+void PresetModel::deliverBatch(const PresetScan *scan, std::vector<Preset> batch, bool last)
+{
+    // Batches of a scan superseded by a newer path are already queued; drop them
+    if (scan != m_scan.get())
+        return;
+
+    const int first = totalCount();
+    m_presets.reserve(m_presets.size() + batch.size());
+    for (Preset &preset : batch) {
+        const int presetIndex = totalCount();
+        for (quint64 key : preset.trigrams)
+            m_index[key].push_back(presetIndex);   // stays ascending
+        m_presets.push_back(std::move(preset));
+    }
+
+    std::vector<int> added;
+    for (int i = first; i < totalCount(); ++i) {
+        if (matches(i))
+            added.push_back(i);
+    }
+    if (!added.empty()) {
+        beginInsertRows(QModelIndex(), count(), count() + static_cast<int>(added.size()) - 1);
+        m_rows.insert(m_rows.end(), added.begin(), added.end());
+        endInsertRows();
+        emit countChanged();
+    }
+    if (!batch.empty())
+        emit totalCountChanged();
+
+    if (last) {
+        qDebug() << "PresetModel: loaded" << totalCount() << "presets from" << m_path;
+        m_scan.reset();
+        emit loadingChanged();
+    }
+}
+
+bool PresetModel::matches(int presetIndex) const
+{
+    const QString &haystack = m_presets[presetIndex].haystack;
+    for (const QString &term : m_terms) {
+        if (!haystack.contains(term))
+            return false;
+    }
+    return true;
+}
+
+// Presets containing every trigram of term — a superset of the real matches
+std::vector<int> PresetModel::candidatesFor(const QString &term) const
+{
+    std::vector<const std::vector<int> *> lists;
+    for (quint64 key : trigramsOf(term)) {
+        const auto it = m_index.constFind(key);
+        if (it == m_index.constEnd())
+            return {};
+        lists.push_back(&it.value());
+    }
+    std::sort(lists.begin(), lists.end(),
+              [](const auto *a, const auto *b) { return a->size() < b->size(); });
+
+    std::vector<int> result = *lists.front();
+    for (size_t i = 1; i < lists.size() && !result.empty(); ++i)
+        result = intersect(result, *lists[i]);
+    return result;
+}
+
+std::vector<int> PresetModel::query(const std::vector<int> *within) const
+{
+    std::vector<int> result;
+    bool seeded = false;
+    if (within) {
+        result = *within;
+        seeded = true;
+    }
+    for (const QString &term : m_terms) {
+        if (term.size() < 3)
+            continue;   // too short for the index; checked below
+        std::vector<int> candidates = candidatesFor(term);
+        result = seeded ? intersect(result, candidates) : std::move(candidates);
+        seeded = true;
+        if (result.empty())
+            return result;
+    }
+    if (!seeded) {
+        result.resize(m_presets.size());
+        for (size_t i = 0; i < result.size(); ++i)
+            result[i] = static_cast<int>(i);
+    }
+
+    result.erase(std::remove_if(result.begin(), result.end(),
+                                [this](int i) { return !matches(i); }),
+                 result.end());
+    return result;
+}
+
+int PresetModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : count();
+}
+
+QVariant PresetModel::data(const QModelIndex &index, int role) const
+{
+    if (!checkIndex(index, CheckIndexOption::IndexIsValid | CheckIndexOption::ParentIsInvalid))
+        return {};
+
+    const int presetIndex = m_rows[index.row()];
+    const Preset &preset  = m_presets[presetIndex];
+    switch (role) {
+    case Qt::DisplayRole:
+    case NameRole:        return preset.name;
+    case FileNameRole:    return preset.fileName;
+    case AuthorRole:      return preset.author;
+    case CategoryRole:    return preset.category;
+    case PresetIndexRole: return presetIndex;
+    }
+    return {};
+}
+
+QHash<int, QByteArray> PresetModel::roleNames() const
+{
+    return {
+        {NameRole,        QByteArrayLiteral("name")},
+        {FileNameRole,    QByteArrayLiteral("fileName")},
+        {AuthorRole,      QByteArrayLiteral("author")},
+        {CategoryRole,    QByteArrayLiteral("category")},
+        {PresetIndexRole, QByteArrayLiteral("presetIndex")},
+    };
+}
+
+int PresetModel::rowOf(int presetIndex) const
+{
+    const auto it = std::lower_bound(m_rows.begin(), m_rows.end(), presetIndex);
+    return it != m_rows.end() && *it == presetIndex ? static_cast<int>(it - m_rows.begin()) : -1;
+}
+
+QString PresetModel::nameOf(int presetIndex) const
+{
+    if (presetIndex < 0 || presetIndex >= totalCount())
+        return {};
+    return m_presets[presetIndex].name;
+}
+
+#include "presetmodel.moc"
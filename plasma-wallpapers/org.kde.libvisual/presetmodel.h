@@ -0,0 +1,112 @@
+/*
+ * SPDX-FileCopyrightText: 2026 VitexSoftware <vitex@vitexsoftware.cz>
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <QAbstractListModel>
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QtQml/qqml.h>
+#include <memory>
+#include <vector>
+
+class PresetScan;
+
+/**
+ * ProjectM preset list for the configuration dialog.
+ *
+ * The preset directory is listed and parsed on a QThreadPool worker and the
+ * rows arrive in batches, so the dialog is usable immediately even with
+ * thousands of presets; a view on top only creates delegates for what is
+ * on screen.  Rows keep the order of ProjectMItem's scan, so presetIndex is
+ * the value stored in the projectMPreset setting.
+ *
+ * Every preset is also entered into a trigram index over its name, author
+ * and category as its batch arrives.  A filter term of three or more
+ * characters is answered from the posting lists; a filter that extends the
+ * previous one only narrows the rows already visible.
+ */
+class PresetModel : public QAbstractListModel
+{
+    Q_OBJECT
+    QML_ELEMENT
+
+    Q_PROPERTY(QString path       READ path       WRITE setPath   NOTIFY pathChanged)
+    Q_PROPERTY(QString filter     READ filter     WRITE setFilter NOTIFY filterChanged)
+    Q_PROPERTY(bool    loading    READ isLoading  NOTIFY loadingChanged)
+    Q_PROPERTY(int     count      READ count      NOTIFY countChanged)
+    Q_PROPERTY(int     totalCount READ totalCount NOTIFY totalCountChanged)
+
+public:
+    enum Roles {
+        NameRole = Qt::UserRole + 1, // file name without extension
+        FileNameRole,
+        AuthorRole,
+        CategoryRole,
+        PresetIndexRole              // position in the unfiltered list
+    };
+    Q_ENUM(Roles)
+
+    struct Preset {
+        QString fileName;
+        QString name;
+        QString author;
+        QString category;
+        QString haystack;                // case-folded name, author and category
+        std::vector<quint64> trigrams;   // distinct trigrams of haystack
+    };
+
+    explicit PresetModel(QObject *parent = nullptr);
+    ~PresetModel() override;
+
+    QString path()       const { return m_path; }
+    QString filter()     const { return m_filter; }
+    bool    isLoading()  const { return m_scan != nullptr; }
+    int     count()      const { return static_cast<int>(m_rows.size()); }
+    int     totalCount() const { return static_cast<int>(m_presets.size()); }
+
+    void setPath(const QString &path);
+    void setFilter(const QString &filter);
+
+    int      rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    // Visible row of a preset, or -1 when it is filtered out / not loaded yet
+    Q_INVOKABLE int     rowOf(int presetIndex) const;
+    Q_INVOKABLE QString nameOf(int presetIndex) const;
+
+    // Case folding and trigram keys shared by the loader and the query side
+    static QString              foldCase(const QString &text);
+    static std::vector<quint64> trigramsOf(const QString &folded);
+
+signals:
+    void pathChanged();
+    void filterChanged();
+    void loadingChanged();
+    void countChanged();
+    void totalCountChanged();
+
+private:
+    friend class PresetScan;
+
+    void reload();
+    // Queued from the scan's worker; the last batch ends the load
+    void deliverBatch(const PresetScan *scan, std::vector<Preset> batch, bool last);
+    bool matches(int presetIndex) const;
+    std::vector<int> candidatesFor(const QString &term) const;
+    std::vector<int> query(const std::vector<int> *within) const;
+
+    QString m_path;
+    QString m_filter;
+    QStringList m_terms;                      // folded, whitespace separated filter terms
+
+    std::vector<Preset> m_presets;            // every loaded preset, scan order
+    std::vector<int>    m_rows;               // presets passing the filter, ascending
+    QHash<quint64, std::vector<int>> m_index; // trigram → ascending preset indices
+
+    std::shared_ptr<PresetScan> m_scan;       // running load, null when idle
+};
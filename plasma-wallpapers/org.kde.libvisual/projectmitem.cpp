@@ -4,19 +4,37 @@
  */
 
 #include "projectmitem.h"
+#include "audiovisualizer.h"
 
 #include <QDebug>
 #include <QDir>
+#include <QElapsedTimer>
 #include <QMutexLocker>
 #include <QOpenGLFramebufferObject>
 #include <QOpenGLFramebufferObjectFormat>
+#include <QQuickWindow>
+#include <QScreen>
 #include <QSize>
 #include <QVector>
+#include <algorithm>
+#include <memory>
+#include <vector>
 
 #ifdef HAVE_PROJECTM
 #  include <libprojectM/projectM.hpp>
 #endif
 
+namespace
+{
+// Automatic render scale steps; cost follows the pixel count
+constexpr qreal kScaleLadder[] = {1.0, 0.75, 0.5, 1.0 / 3.0, 0.25};
+constexpr int   kScaleSteps    = sizeof(kScaleLadder) / sizeof(kScaleLadder[0]);
+constexpr int   kScaleWindow   = 60;     // frames per decision
+constexpr int   kProbeWindows  = 10;     // on-time windows before probing up
+constexpr qreal kLateFactor    = 1.2;    // mean interval over this × period is late
+constexpr qint64 kMaxGapNs     = 250000000;  // longer gaps are pauses, not frames
+} // namespace
+
 // ---------------------------------------------------------------------------
 // ProjectMRenderer — lives on the render thread
 // ---------------------------------------------------------------------------
@@ -37,8 +55,19 @@ public:
     {
         auto *item = static_cast<ProjectMItem *>(fbo);
 
-        // Copy waveform under mutex
-        {
+        // Direct PCM link: grab the capture ring once, drain it in render()
+        auto ring = item->m_audioSource ? item->m_audioSource->pcmRing()
+                                        : std::shared_ptr<const SampleRing>();
+        if (ring != m_pcmRing) {
+            m_pcmRing = std::move(ring);
+            if (m_pcmRing) {
+                m_pcmCursor = m_pcmRing->writePosition();
+                m_pcm.resize(static_cast<size_t>(m_pcmRing->capacity()));
+            }
+        }
+
+        // Legacy QML path: copy waveform under mutex
+        if (!m_pcmRing) {
             QMutexLocker lk(&item->m_mutex);
             m_waveform = item->m_waveform;
         }
@@ -56,6 +85,26 @@ public:
         m_shuffleEnabled = item->m_shuffleEnabled;
         m_presetDuration = item->m_presetDuration;
 
+        // Render scale: the FBO no longer follows the item, so a new item
+        // size or scale means a new FBO
+        const QQuickWindow *win = item->window();
+        const qreal dpr = win ? win->effectiveDevicePixelRatio() : 1.0;
+        const QSize itemPixels = (item->size() * dpr).toSize();
+        if (win && win->screen() && win->screen()->refreshRate() > 0)
+            m_framePeriodNs = static_cast<qint64>(1e9 / win->screen()->refreshRate());
+        const bool automatic = item->m_renderScale <= 0.0;
+        if (automatic != m_autoScale) {
+            m_autoScale = automatic;
+            resetScaleStats();
+        }
+        const qreal scale = automatic ? kScaleLadder[m_scaleStep]
+                                      : std::clamp<qreal>(item->m_renderScale, 0.25, 1.0);
+        if (itemPixels != m_itemPixels || !qFuzzyCompare(scale, m_scale)) {
+            m_itemPixels = itemPixels;
+            m_scale = scale;
+            invalidateFramebufferObject();
+        }
+
         // If a specific preset was requested, apply it next render
         int requestedIndex = item->m_presetIndex;
         if (requestedIndex != m_appliedPresetIndex) {
@@ -66,15 +115,20 @@ public:
 
     QOpenGLFramebufferObject *createFramebufferObject(const QSize &size) override
     {
+        // size is the item's pixel size; the texture is stretched over it
+        const QSize scaled(std::max(16, qRound(size.width() * m_scale)),
+                           std::max(16, qRound(size.height() * m_scale)));
+
         QOpenGLFramebufferObjectFormat fmt;
         fmt.setAttachment(QOpenGLFramebufferObject::CombinedDepthStencil);
-        auto *fbo = new QOpenGLFramebufferObject(size, fmt);
+        auto *fbo = new QOpenGLFramebufferObject(scaled, fmt);
 
 #ifdef HAVE_PROJECTM
         if (m_pm)
-            m_pm->projectM_resetGL(size.width(), size.height());
+            m_pm->projectM_resetGL(scaled.width(), scaled.height());
 #endif
-        m_size = size;
+        m_size = scaled;
+        resetScaleStats();
         return fbo;
     }
 
@@ -95,8 +149,13 @@ public:
                 m_pendingPresetIndex = -1;
             }
 
-            // Feed PCM to projectM
-            if (!m_waveform.isEmpty()) {
+            // Feed PCM to projectM — everything captured since the last frame
+            if (m_pcmRing) {
+                const int n = m_pcmRing->read(m_pcmCursor, m_pcm.data(),
+                                              static_cast<int>(m_pcm.size()));
+                if (n > 0)
+                    m_pm->pcm()->addPCMfloat(m_pcm.data(), n);
+            } else if (!m_waveform.isEmpty()) {
                 QVector<float> pcm;
                 pcm.reserve(m_waveform.size());
                 for (const QVariant &v : std::as_const(m_waveform))
@@ -106,16 +165,70 @@ public:
 
             m_pm->renderFrame();
         }
+        updateAutoScale();
 #else
         // Stub: clear to black so the FBO is not garbage
         glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT);
 #endif
-        // Request continuous rendering
-        update();
+        // No update() here: the item asks for the next frame after the swap,
+        // and only while somebody can see it
     }
 
 private:
+    void resetScaleStats()
+    {
+        m_frameClock.invalidate();
+        m_intervalTotalNs = 0;
+        m_intervals = 0;
+    }
+
+    // Frames are requested right after each swap, so the time between two
+    // render() calls is the frame time actually achieved
+    void updateAutoScale()
+    {
+        if (!m_autoScale)
+            return;
+        if (!m_frameClock.isValid()) {
+            m_frameClock.start();
+            return;
+        }
+        const qint64 interval = m_frameClock.nsecsElapsed();
+        m_frameClock.restart();
+        if (interval > kMaxGapNs)
+            return;
+        m_intervalTotalNs += interval;
+        if (++m_intervals < kScaleWindow)
+            return;
+
+        const bool late = m_intervalTotalNs / m_intervals > kLateFactor * m_framePeriodNs;
+        m_intervalTotalNs = 0;
+        m_intervals = 0;
+
+        int step = m_scaleStep;
+        if (late) {
+            // A failed probe up waits twice as long before the next one
+            if (m_probing)
+                m_probeAfter = std::min(m_probeAfter * 2, 16 * kProbeWindows);
+            m_probing = false;
+            m_onTimeWindows = 0;
+            step = std::min(step + 1, kScaleSteps - 1);
+        } else if (m_probing) {
+            m_probing = false;
+            m_probeAfter = kProbeWindows;
+        } else if (step > 0 && ++m_onTimeWindows >= m_probeAfter) {
+            m_onTimeWindows = 0;
+            m_probing = true;
+            --step;
+        }
+
+        if (step != m_scaleStep) {
+            m_scaleStep = step;
+            m_scale = kScaleLadder[step];
+            invalidateFramebufferObject();
+        }
+    }
+
     void initProjectM()
     {
 #ifdef HAVE_PROJECTM
@@ -153,12 +266,26 @@ private:
 #endif
 
     QVariantList m_waveform;
+    std::shared_ptr<const SampleRing> m_pcmRing;
+    std::vector<float> m_pcm;        // sized once per ring, reused every frame
+    quint64      m_pcmCursor         = 0;
     QString      m_presetPath        = QStringLiteral("/usr/share/projectM/presets");
     bool         m_shuffleEnabled    = true;
     int          m_presetDuration    = 30;
     int          m_pendingPresetIndex = -1;
     int          m_appliedPresetIndex = -1;
-    QSize        m_size;
+    QSize        m_size;                // FBO size, after scaling
+    QSize        m_itemPixels;
+    qreal        m_scale             = 1.0;
+    bool         m_autoScale         = true;
+    int          m_scaleStep         = 0;
+    int          m_onTimeWindows     = 0;
+    int          m_probeAfter        = kProbeWindows;
+    bool         m_probing           = false;
+    qint64       m_framePeriodNs     = 16666667;
+    qint64       m_intervalTotalNs   = 0;
+    int          m_intervals         = 0;
+    QElapsedTimer m_frameClock;
 };
 
 // ---------------------------------------------------------------------------
@@ -169,6 +296,7 @@ ProjectMItem::ProjectMItem(QQuickItem *parent)
     : QQuickFramebufferObject(parent)
 {
     setMirrorVertically(true);  // GL origin is bottom-left; Qt origin is top-left
+    setTextureFollowsItemSize(false);  // the renderer sizes the FBO (renderScale)
     scanPresets();
 }
 
@@ -177,6 +305,44 @@ QQuickFramebufferObject::Renderer *ProjectMItem::createRenderer() const
     return new ProjectMRenderer();
 }
 
+void ProjectMItem::itemChange(ItemChange change, const ItemChangeData &value)
+{
+    if (change == ItemSceneChange) {
+        disconnect(m_frameConnection);
+        disconnect(m_visibilityConnection);
+        if (value.window) {
+            // frameSwapped is emitted on the render thread; queue it back to
+            // the GUI thread, where update() may be called
+            m_frameConnection = connect(value.window, &QQuickWindow::frameSwapped,
+                                        this, &ProjectMItem::onFrameSwapped,
+                                        Qt::QueuedConnection);
+            // Restores the loop when a minimised or hidden view comes back
+            m_visibilityConnection = connect(value.window, &QWindow::visibilityChanged, this, [this] {
+                if (canAnimate())
+                    update();
+            });
+        }
+    } else if (change == ItemVisibleHasChanged && value.boolValue) {
+        update();   // restart the frame loop after being hidden
+    }
+    QQuickFramebufferObject::itemChange(change, value);
+}
+
+bool ProjectMItem::canAnimate() const
+{
+    const QQuickWindow *win = window();
+    return isVisible() && win && win->isExposed()
+        && win->visibility() != QWindow::Hidden && win->visibility() != QWindow::Minimized;
+}
+
+void ProjectMItem::onFrameSwapped()
+{
+    // An unexposed window stops the loop; the frame Qt renders when it is
+    // exposed again restarts it
+    if (canAnimate())
+        update();
+}
+
 void ProjectMItem::setWaveform(const QVariantList &waveform)
 {
     {
@@ -187,6 +353,15 @@ void ProjectMItem::setWaveform(const QVariantList &waveform)
     update();
 }
 
+void ProjectMItem::setAudioSource(AudioVisualizer *source)
+{
+    if (m_audioSource == source)
+        return;
+    m_audioSource = source;
+    emit audioSourceChanged();
+    update();
+}
+
 void ProjectMItem::setPresetPath(const QString &path)
 {
     if (m_presetPath == path)
@@ -223,6 +398,16 @@ void ProjectMItem::setPresetIndex(int index)
     update();
 }
 
+void ProjectMItem::setRenderScale(qreal scale)
+{
+    scale = scale <= 0.0 ? 0.0 : std::clamp<qreal>(scale, 0.25, 1.0);
+    if (qFuzzyCompare(m_renderScale + 1.0, scale + 1.0))
+        return;
+    m_renderScale = scale;
+    emit renderScaleChanged();
+    update();
+}
+
 void ProjectMItem::scanPresets()
 {
     m_presetNames = QDir(m_presetPath)
@@ -7,21 +7,36 @@
 
 #include <QDir>
 #include <QMutex>
+#include <QPointer>
 #include <QQuickFramebufferObject>
 #include <QStringList>
 #include <QVariantList>
 #include <QtQml/qqml.h>
 
+class AudioVisualizer;
 class ProjectMRenderer;
 
 /**
  * QQuickFramebufferObject that wraps a projectM instance.
  *
- * Audio PCM is fed each frame from the waveform property (a QVariantList of
- * floats in [-1, 1]).  Preset selection, shuffle and duration are all
+ * Audio PCM is pulled on the render thread straight from the capture ring of
+ * the AudioVisualizer assigned to audioSource, so projectM receives every
+ * sample captured since the previous frame without any QML marshalling.  The
+ * older waveform property (a QVariantList of floats in [-1, 1]) is still
+ * honoured when no audioSource is set.  Preset selection, shuffle and duration are all
  * configurable via QML properties.  When libprojectM is not present at build
  * time (HAVE_PROJECTM not defined) the item renders a solid black frame so
  * that the QML type always exists and main.qml compiles cleanly.
+ *
+ * The next frame is requested after each swap, and only while the item is
+ * visible and its window exposed, so nothing is rendered behind a
+ * fullscreen window, a lock screen or a minimised desktop view.
+ *
+ * renderScale sets the resolution projectM renders at as a fraction of the
+ * item's pixel size (0.25–1); the scene graph stretches the texture over
+ * the item.  At 0 (the default) the scale adapts: it drops while frames
+ * miss the screen's refresh period and probes upwards again once they
+ * have been on time for a while.
  */
 class ProjectMItem : public QQuickFramebufferObject
 {
@@ -29,11 +44,13 @@ class ProjectMItem : public QQuickFramebufferObject
     QML_ELEMENT
 
     Q_PROPERTY(QVariantList waveform       WRITE setWaveform                          NOTIFY waveformChanged)
+    Q_PROPERTY(AudioVisualizer *audioSource READ audioSource WRITE setAudioSource     NOTIFY audioSourceChanged)
     Q_PROPERTY(QString      presetPath     READ  presetPath  WRITE setPresetPath      NOTIFY presetPathChanged)
     Q_PROPERTY(bool         shuffleEnabled READ  shuffleEnabled WRITE setShuffleEnabled NOTIFY shuffleEnabledChanged)
     Q_PROPERTY(int          presetDuration READ  presetDuration WRITE setPresetDuration NOTIFY presetDurationChanged)
     Q_PROPERTY(int          presetIndex    READ  presetIndex  WRITE setPresetIndex    NOTIFY presetIndexChanged)
     Q_PROPERTY(QStringList  presetNames    READ  presetNames                          NOTIFY presetNamesChanged)
+    Q_PROPERTY(qreal        renderScale    READ  renderScale WRITE setRenderScale     NOTIFY renderScaleChanged)
 
     friend class ProjectMRenderer;
 
@@ -42,34 +59,49 @@ public:
 
     Renderer *createRenderer() const override;
 
+    AudioVisualizer *audioSource() const { return m_audioSource; }
     QString     presetPath()     const { return m_presetPath; }
     bool        shuffleEnabled() const { return m_shuffleEnabled; }
     int         presetDuration() const { return m_presetDuration; }
     int         presetIndex()    const { return m_presetIndex; }
     QStringList presetNames()    const { return m_presetNames; }
+    qreal       renderScale()    const { return m_renderScale; }
 
     void setWaveform(const QVariantList &waveform);
+    void setAudioSource(AudioVisualizer *source);
     void setPresetPath(const QString &path);
     void setShuffleEnabled(bool enabled);
     void setPresetDuration(int seconds);
     void setPresetIndex(int index);
+    void setRenderScale(qreal scale);
+
+protected:
+    void itemChange(ItemChange change, const ItemChangeData &value) override;
 
 signals:
     void waveformChanged();
+    void audioSourceChanged();
     void presetPathChanged();
     void shuffleEnabledChanged();
     void presetDurationChanged();
     void presetIndexChanged();
     void presetNamesChanged();
+    void renderScaleChanged();
 
 private:
     void scanPresets();
+    void onFrameSwapped();
+    bool canAnimate() const;
 
     mutable QMutex m_mutex;
     QVariantList   m_waveform;
+    QPointer<AudioVisualizer> m_audioSource;
     QString        m_presetPath     = QStringLiteral("/usr/share/projectM/presets");
     bool           m_shuffleEnabled = true;
     int            m_presetDuration = 30;
     int            m_presetIndex    = -1;
     QStringList    m_presetNames;
+    qreal          m_renderScale    = 0.0;   // 0 = automatic
+    QMetaObject::Connection m_frameConnection;
+    QMetaObject::Connection m_visibilityConnection;
 };
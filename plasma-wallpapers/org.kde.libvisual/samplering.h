@@ -0,0 +1,112 @@
+/*
+ * SPDX-FileCopyrightText: 2026 VitexSoftware <vitex@vitexsoftware.cz>
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <QtGlobal>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
+
+/**
+ * Single-producer / multi-reader float ring used to hand captured audio from
+ * the PulseAudio callback thread to consumers on other threads (the Qt Quick
+ * render thread in particular) without a mutex and without allocating.
+ *
+ * The producer only ever advances a monotonically increasing 64-bit write
+ * position.  Every reader keeps its own cursor, so several consumers can drain
+ * the same ring independently.  A reader that falls more than one ring behind
+ * skips forward and loses the oldest samples instead of reading torn data.
+ */
+class SampleRing
+{
+public:
+    // capacity is rounded up to the next power of two
+    explicit SampleRing(int capacity)
+    {
+        int cap = 1;
+        while (cap < capacity)
+            cap <<= 1;
+        m_capacity = cap;
+        m_mask     = static_cast<quint64>(cap - 1);
+        m_data.reset(new float[cap]());
+    }
+
+    int capacity() const { return m_capacity; }
+
+    quint64 writePosition() const { return m_writePos.load(std::memory_order_acquire); }
+
+    // Producer side — PA callback thread only
+    void write(const float *src, int count)
+    {
+        if (count <= 0)
+            return;
+        if (count > m_capacity) {
+            src  += count - m_capacity;
+            count = m_capacity;
+        }
+        const quint64 pos   = m_writePos.load(std::memory_order_relaxed);
+        const int     start = static_cast<int>(pos & m_mask);
+        const int     first = std::min(count, m_capacity - start);
+        std::memcpy(m_data.get() + start, src, sizeof(float) * first);
+        if (first < count)
+            std::memcpy(m_data.get(), src + first, sizeof(float) * (count - first));
+        m_writePos.store(pos + count, std::memory_order_release);
+    }
+
+    // Copies every sample written since *cursor (at most maxCount, oldest
+    // first) and advances the cursor.  Returns the number of samples copied.
+    int read(quint64 &cursor, float *dst, int maxCount) const
+    {
+        const quint64 end = writePosition();
+        if (cursor > end)
+            cursor = end;
+        // Keep half a ring of headroom so the producer cannot lap the copy
+        const quint64 window = static_cast<quint64>(m_capacity / 2);
+        if (end - cursor > window)
+            cursor = end - window;
+
+        const int n = static_cast<int>(std::min<quint64>(end - cursor, static_cast<quint64>(maxCount)));
+        copyOut(cursor, dst, n);
+
+        // Producer overtook us while copying — discard rather than hand out torn data
+        if (writePosition() - cursor > static_cast<quint64>(m_capacity)) {
+            cursor = writePosition();
+            return 0;
+        }
+        cursor += static_cast<quint64>(n);
+        return n;
+    }
+
+    // Copies the newest count samples (zero-padded at the front if the ring
+    // has not been filled yet).  Returns the write position they end at.
+    quint64 readLatest(float *dst, int count) const
+    {
+        const quint64 end   = writePosition();
+        const int     avail = static_cast<int>(std::min<quint64>(end, static_cast<quint64>(std::min(count, m_capacity))));
+        std::fill(dst, dst + (count - avail), 0.0f);
+        copyOut(end - static_cast<quint64>(avail), dst + (count - avail), avail);
+        return end;
+    }
+
+private:
+    void copyOut(quint64 from, float *dst, int n) const
+    {
+        if (n <= 0)
+            return;
+        const int start = static_cast<int>(from & m_mask);
+        const int first = std::min(n, m_capacity - start);
+        std::memcpy(dst, m_data.get() + start, sizeof(float) * first);
+        if (first < n)
+            std::memcpy(dst + first, m_data.get(), sizeof(float) * (n - first));
+    }
+
+    std::unique_ptr<float[]> m_data;
+    int                      m_capacity = 0;
+    quint64                  m_mask     = 0;
+    std::atomic<quint64>     m_writePos{0};
+};
@@ -0,0 +1,97 @@
+#version 440
+
+layout(location = 0) in vec2 texCoord;
+layout(location = 0) out vec4 fragColor;
+
+// Must match DeepMandelbrotShader::updateUniformData() in deepmandelbrotitem.cpp
+layout(std140, binding = 0) uniform buf {
+    mat4  qt_Matrix;
+    float qt_Opacity;
+    float scale;        // half the view height in the complex plane
+    float aspect;       // item width / height
+    float angle;        // view rotation, radians
+    float intensity;
+    int   refLength;    // valid iterations in the orbit texture
+    int   orbitRows;
+    int   maxIter;
+    int   colorScheme;
+} ubuf;
+
+// Reference orbit Z_n at texel (n % ORBIT_WIDTH, n / ORBIT_WIDTH), nearest filtering
+layout(binding = 1) uniform sampler2D orbit;
+
+const int ORBIT_WIDTH = 1024;
+const int MAX_ITER    = 4096;   // loop bound for the shader compiler, = MAX_ORBIT
+
+vec2 reference(int n) {
+    int row = n / ORBIT_WIDTH;
+    int col = n - row * ORBIT_WIDTH;
+    return texture(orbit, vec2((float(col) + 0.5) / float(ORBIT_WIDTH),
+                               (float(row) + 0.5) / float(ubuf.orbitRows))).xy;
+}
+
+// Same palettes as mandelbrot.frag
+vec3 colorForScheme(float ratio, float intensity) {
+    if (ubuf.colorScheme == 0) {          // Rainbow Spectrum
+        vec3 rgb = clamp(abs(mod(ratio * 6.0 + vec3(0.0, 4.0, 2.0), 6.0) - 3.0) - 1.0, 0.0, 1.0);
+        float sat = 0.8 + intensity * 0.2;
+        float val = 0.5 + intensity * 0.5;
+        return val * mix(vec3(1.0), rgb, sat);
+    } else if (ubuf.colorScheme == 1) {   // Blue Gradient
+        return vec3(0.1 + intensity * 0.3, 0.3 + intensity * 0.5, 0.5 + intensity * 0.5);
+    } else if (ubuf.colorScheme == 2) {   // Fire
+        return vec3(0.8 + intensity * 0.2, 0.3 * intensity, 0.1 * intensity);
+    } else if (ubuf.colorScheme == 3) {   // Plasma
+        return vec3(0.5 + intensity * 0.5, 0.2 * intensity, 0.5 + intensity * 0.5);
+    }
+    float gray = 0.3 + intensity * 0.7;   // Monochrome
+    return vec3(gray);
+}
+
+void main() {
+    // Pixel offset from the reference point c, y up, rotated with the view
+    vec2 p = (texCoord - 0.5) * 2.0 * vec2(ubuf.aspect, -1.0);
+    float s = sin(ubuf.angle);
+    float c = cos(ubuf.angle);
+    vec2 dc = vec2(c * p.x - s * p.y, s * p.x + c * p.y) * ubuf.scale;
+
+    // Perturbation: z_n = Z_n + dz_n, dz_{n+1} = (2 Z_n + dz_n) dz_n + dc
+    vec2  Z  = vec2(0.0);
+    vec2  dz = vec2(0.0);
+    int   n  = 0;
+    int   iteration = 0;
+    float mag2  = 0.0;
+    int   limit = min(ubuf.maxIter, MAX_ITER);
+
+    for (int i = 0; i < MAX_ITER; ++i) {
+        if (i >= limit) break;
+        vec2 t = 2.0 * Z + dz;
+        dz = vec2(t.x * dz.x - t.y * dz.y, t.x * dz.y + t.y * dz.x) + dc;
+        ++n;
+        Z = reference(n);
+        vec2 z = Z + dz;
+        mag2 = dot(z, z);
+        iteration = i + 1;
+        if (mag2 > 1024.0) break;
+        // Rebase onto Z_0 = 0 once the full orbit is smaller than the delta
+        // (the delta would lose all precision) or the reference runs out
+        if (mag2 < dot(dz, dz) || n >= ubuf.refLength - 1) {
+            dz = z;
+            Z  = vec2(0.0);
+            n  = 0;
+        }
+    }
+
+    if (iteration >= limit) {
+        // Interior of the set — black
+        fragColor = vec4(0.0, 0.0, 0.0, 1.0) * ubuf.qt_Opacity;
+        return;
+    }
+
+    // Continuous escape count, banded so the single-colour schemes still
+    // show structure at any depth
+    float nu    = float(iteration) + 1.0 - log2(log2(mag2) * 0.5);
+    float ratio = fract(nu / 64.0);
+    float shade = 0.35 + 0.65 * (0.5 + 0.5 * cos(6.2831853 * nu / 16.0));
+    fragColor = vec4(colorForScheme(ratio, ubuf.intensity * shade) * shade, 1.0) * ubuf.qt_Opacity;
+}
@@ -0,0 +1,18 @@
+#version 440
+
+layout(location = 0) in vec2 corner;
+layout(location = 1) in vec4 color;     // premultiplied, opacity applied
+layout(location = 0) out vec4 fragColor;
+
+// Must match ParticleShader::updateUniformData() in particlesystemitem.cpp
+layout(std140, binding = 0) uniform buf {
+    mat4  qt_Matrix;
+    float qt_Opacity;
+} ubuf;
+
+void main() {
+    // Soft round sprite: bright core, smooth falloff to the quad's inscribed circle
+    float d = length(corner);
+    float falloff = 1.0 - smoothstep(0.35, 1.0, d);
+    fragColor = color * falloff;
+}
@@ -0,0 +1,18 @@
+#version 440
+
+layout(location = 0) in vec4 qt_VertexPosition;
+layout(location = 1) in vec2 vertexCorner;
+layout(location = 2) in vec4 vertexColor;
+layout(location = 0) out vec2 corner;
+layout(location = 1) out vec4 color;
+
+layout(std140, binding = 0) uniform buf {
+    mat4  qt_Matrix;
+    float qt_Opacity;
+} ubuf;
+
+void main() {
+    corner      = vertexCorner;
+    color       = vertexColor * ubuf.qt_Opacity;
+    gl_Position = ubuf.qt_Matrix * qt_VertexPosition;
+}
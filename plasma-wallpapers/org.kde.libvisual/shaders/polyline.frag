@@ -0,0 +1,30 @@
+#version 440
+
+layout(location = 0) in float across;
+layout(location = 0) out vec4 fragColor;
+
+// Must match PolylineShader::updateUniformData() in waveformitem.cpp
+layout(std140, binding = 0) uniform buf {
+    mat4  qt_Matrix;
+    float qt_Opacity;
+    float halfWidth;   // core half width, logical pixels
+    float glowWidth;   // glow reach beyond the core edge
+    float glow;        // glow intensity, 0 disables it
+    vec4  color;       // premultiplied
+} ubuf;
+
+void main() {
+    float d = abs(across);
+
+    // Solid core with a one-pixel anti-aliased edge
+    float core = 1.0 - smoothstep(ubuf.halfWidth - 0.5, ubuf.halfWidth + 0.5, d);
+
+    // Quadratic falloff over glowWidth beyond the core edge
+    float g = 0.0;
+    if (ubuf.glowWidth > 0.0) {
+        float t = clamp((d - ubuf.halfWidth) / ubuf.glowWidth, 0.0, 1.0);
+        g = (1.0 - t) * (1.0 - t) * ubuf.glow;
+    }
+
+    fragColor = ubuf.color * max(core, g) * ubuf.qt_Opacity;
+}
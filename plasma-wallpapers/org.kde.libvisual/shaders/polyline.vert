@@ -0,0 +1,19 @@
+#version 440
+
+layout(location = 0) in vec4  qt_VertexPosition;
+layout(location = 1) in float vertexAcross;
+layout(location = 0) out float across;
+
+layout(std140, binding = 0) uniform buf {
+    mat4  qt_Matrix;
+    float qt_Opacity;
+    float halfWidth;
+    float glowWidth;
+    float glow;
+    vec4  color;
+} ubuf;
+
+void main() {
+    across      = vertexAcross;
+    gl_Position = ubuf.qt_Matrix * qt_VertexPosition;
+}
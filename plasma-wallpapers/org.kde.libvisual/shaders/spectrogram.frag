@@ -0,0 +1,44 @@
+#version 440
+
+layout(location = 0) in vec2 texCoord;
+layout(location = 0) out vec4 fragColor;
+
+// Must match SpectrogramShader::updateUniformData() in spectrogramitem.cpp
+layout(std140, binding = 0) uniform buf {
+    mat4  qt_Matrix;
+    float qt_Opacity;
+    float rowOffset;    // V of the newest history row; scrolling happens here
+    float gain;
+    int   colorScheme;
+} ubuf;
+
+// One row per analysis hop, written as a ring by SpectrogramTexture
+layout(binding = 1) uniform sampler2D history;
+
+// Same palettes as getColorForValue() in main.qml, except Rainbow: that one
+// goes once around the hue circle, so quiet and loud would both be red; here
+// it runs from blue (quiet) to red (loud)
+vec3 colorForScheme(float value, float intensity) {
+    if (ubuf.colorScheme == 0) {          // Rainbow Spectrum
+        float h = (1.0 - value) * 4.0;    // hue sextant: 4 is blue, 0 red
+        vec3 rgb = clamp(abs(mod(h + vec3(0.0, 4.0, 2.0), 6.0) - 3.0) - 1.0, 0.0, 1.0);
+        float sat = 0.8 + intensity * 0.2;
+        float val = 0.5 + intensity * 0.5;
+        return val * mix(vec3(1.0), rgb, sat);
+    } else if (ubuf.colorScheme == 1) {   // Blue Gradient
+        return vec3(0.1 + intensity * 0.3, 0.3 + intensity * 0.5, 0.5 + intensity * 0.5);
+    } else if (ubuf.colorScheme == 2) {   // Fire
+        return vec3(0.8 + intensity * 0.2, 0.3 * intensity, 0.1 * intensity);
+    } else if (ubuf.colorScheme == 3) {   // Plasma
+        return vec3(0.5 + intensity * 0.5, 0.2 * intensity, 0.5 + intensity * 0.5);
+    }
+    float gray = 0.3 + intensity * 0.7;   // Monochrome
+    return vec3(gray);
+}
+
+void main() {
+    // Newest row at the top; older rows scroll down and wrap around the ring
+    float v   = fract(ubuf.rowOffset - texCoord.y);
+    float mag = clamp(texture(history, vec2(texCoord.x, v)).r * ubuf.gain, 0.0, 1.0);
+    fragColor = vec4(colorForScheme(mag, mag) * mag, 1.0) * ubuf.qt_Opacity;
+}
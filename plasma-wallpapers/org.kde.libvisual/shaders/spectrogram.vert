@@ -0,0 +1,18 @@
+#version 440
+
+layout(location = 0) in vec4 qt_VertexPosition;
+layout(location = 1) in vec2 qt_VertexTexCoord;
+layout(location = 0) out vec2 texCoord;
+
+layout(std140, binding = 0) uniform buf {
+    mat4  qt_Matrix;
+    float qt_Opacity;
+    float rowOffset;
+    float gain;
+    int   colorScheme;
+} ubuf;
+
+void main() {
+    texCoord    = qt_VertexTexCoord;
+    gl_Position = ubuf.qt_Matrix * qt_VertexPosition;
+}
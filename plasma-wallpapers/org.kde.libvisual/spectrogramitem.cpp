@@ -0,0 +1,330 @@
+/*
+ * SPDX-FileCopyrightText: 2026 VitexSoftware <vitex@vitexsoftware.cz>
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "spectrogramitem.h"
+#include "audiovisualizer.h"
+
+#include <QDebug>
+#include <QSGGeometry>
+#include <QSGGeometryNode>
+#include <QSGMaterial>
+#include <QSGMaterialShader>
+#include <QSGTexture>
+#include <QVarLengthArray>
+#include <algorithm>
+#include <cstring>
+#include <rhi/qrhi.h>
+
+// ---------------------------------------------------------------------------
+// SpectrogramTexture — ring of history rows, one sub-image upload per hop
+// ---------------------------------------------------------------------------
+
+namespace {
+
+class SpectrogramTexture : public QSGTexture
+{
+public:
+    SpectrogramTexture(int width, int rows)
+        : m_width(width)
+        , m_rows(rows)
+        , m_staging(static_cast<size_t>(width) * rows, 0)
+    {
+        m_dirtyRows.reserve(static_cast<size_t>(rows));
+        setFiltering(QSGTexture::Linear);
+        setHorizontalWrapMode(QSGTexture::ClampToEdge);
+        setVerticalWrapMode(QSGTexture::ClampToEdge);  // wrap is done in the shader
+    }
+
+    ~SpectrogramTexture() override
+    {
+        if (m_texture)
+            m_texture->deleteLater();
+    }
+
+    qint64       comparisonKey()   const override { return qint64(quintptr(this)); }
+    QRhiTexture *rhiTexture()      const override { return m_texture; }
+    QSize        textureSize()     const override { return {m_width, m_rows}; }
+    bool         hasAlphaChannel() const override { return false; }
+    bool         hasMipmaps()      const override { return false; }
+
+    int width() const { return m_width; }
+    int rows()  const { return m_rows; }
+
+    // Texture V coordinate of the newest row's centre; the shader samples
+    // fract(rowOffset - y) so y = 0 shows the newest hop.
+    float rowOffset() const { return (m_head - 0.5f) / m_rows; }
+
+    // Stage one analysis hop of count bins into the next ring row.  When the
+    // row is narrower than the hop each texel keeps the peak of its share of
+    // bins, so the whole frequency range stays visible at any width.
+    void pushRow(const float *magnitudes, int count)
+    {
+        quint8 *dst = m_staging.data() + static_cast<size_t>(m_head) * m_width;
+        for (int i = 0; i < m_width; ++i) {
+            const int first = i * count / m_width;
+            const int last  = std::max(first + 1, (i + 1) * count / m_width);
+            const float peak = *std::max_element(magnitudes + first, magnitudes + last);
+            dst[i] = static_cast<quint8>(std::clamp(peak, 0.0f, 1.0f) * 255.0f + 0.5f);
+        }
+
+        if (m_dirtyRows.size() < static_cast<size_t>(m_rows))
+            m_dirtyRows.push_back(m_head);
+        m_head = (m_head + 1) % m_rows;
+    }
+
+    void commitTextureOperations(QRhi *rhi, QRhiResourceUpdateBatch *resourceUpdates) override
+    {
+        if (!m_texture) {
+            const bool r8 = rhi->isTextureFormatSupported(QRhiTexture::R8);
+            m_bytesPerTexel = r8 ? 1 : 4;
+            m_texture = rhi->newTexture(r8 ? QRhiTexture::R8 : QRhiTexture::RGBA8,
+                                        QSize(m_width, m_rows));
+            if (!m_texture->create()) {
+                qWarning() << "SpectrogramItem: failed to create history texture";
+                delete m_texture;
+                m_texture = nullptr;
+                return;
+            }
+            // First upload covers the whole ring once, zero-filled
+            const QByteArray clear(m_width * m_rows * m_bytesPerTexel, '\0');
+            QRhiTextureSubresourceUploadDescription full(clear.constData(), quint32(clear.size()));
+            resourceUpdates->uploadTexture(m_texture, QRhiTextureUploadEntry(0, 0, full));
+        }
+
+        if (m_dirtyRows.empty())
+            return;
+
+        QVarLengthArray<QRhiTextureUploadEntry, 16> entries;
+        for (int row : m_dirtyRows) {
+            const quint8 *src = m_staging.data() + static_cast<size_t>(row) * m_width;
+            QByteArray bytes;
+            if (m_bytesPerTexel == 1) {
+                bytes = QByteArray(reinterpret_cast<const char *>(src), m_width);
+            } else {
+                bytes.resize(m_width * 4);
+                for (int i = 0; i < m_width; ++i)
+                    std::memset(bytes.data() + i * 4, src[i], 4);
+            }
+            QRhiTextureSubresourceUploadDescription desc(bytes);
+            desc.setSourceSize(QSize(m_width, 1));
+            desc.setDestinationTopLeft(QPoint(0, row));
+            entries.append(QRhiTextureUploadEntry(0, 0, desc));
+        }
+        m_dirtyRows.clear();
+
+        QRhiTextureUploadDescription upload;
+        upload.setEntries(entries.cbegin(), entries.cend());
+        resourceUpdates->uploadTexture(m_texture, upload);
+    }
+
+private:
+    int                 m_width;
+    int                 m_rows;
+    int                 m_head = 0;           // next row to be written
+    int                 m_bytesPerTexel = 1;
+    std::vector<quint8> m_staging;            // CPU copy of the ring, row-major
+    std::vector<int>    m_dirtyRows;          // rows staged since the last commit
+    QRhiTexture        *m_texture = nullptr;
+};
+
+// ---------------------------------------------------------------------------
+// Material + shader — samples the ring with a wrap offset and colour maps it
+// ---------------------------------------------------------------------------
+
+class SpectrogramMaterial : public QSGMaterial
+{
+public:
+    SpectrogramMaterial() { setFlag(Blending); }
+
+    QSGMaterialType *type() const override
+    {
+        static QSGMaterialType materialType;
+        return &materialType;
+    }
+
+    QSGMaterialShader *createShader(QSGRendererInterface::RenderMode) const override;
+
+    int compare(const QSGMaterial *other) const override
+    {
+        // One spectrogram per material; never batch two of them together
+        return this == other ? 0 : (this < other ? -1 : 1);
+    }
+
+    std::unique_ptr<SpectrogramTexture> texture;
+    float gain        = 1.0f;
+    int   colorScheme = 0;
+};
+
+class SpectrogramShader : public QSGMaterialShader
+{
+public:
+    SpectrogramShader()
+    {
+        setShaderFileName(VertexStage,   QStringLiteral(":/audiovisualizer/shaders/spectrogram.vert.qsb"));
+        setShaderFileName(FragmentStage, QStringLiteral(":/audiovisualizer/shaders/spectrogram.frag.qsb"));
+    }
+
+    // std140 layout: mat4 qt_Matrix, float qt_Opacity, float rowOffset,
+    // float gain, int colorScheme
+    bool updateUniformData(RenderState &state, QSGMaterial *newMaterial, QSGMaterial *) override
+    {
+        auto *mat = static_cast<SpectrogramMaterial *>(newMaterial);
+        QByteArray *buf = state.uniformData();
+        if (state.isMatrixDirty())
+            std::memcpy(buf->data(), state.combinedMatrix().constData(), 64);
+        if (state.isOpacityDirty()) {
+            const float opacity = state.opacity();
+            std::memcpy(buf->data() + 64, &opacity, 4);
+        }
+        const float offset = mat->texture->rowOffset();
+        std::memcpy(buf->data() + 68, &offset, 4);
+        std::memcpy(buf->data() + 72, &mat->gain, 4);
+        std::memcpy(buf->data() + 76, &mat->colorScheme, 4);
+        return true;
+    }
+
+    void updateSampledImage(RenderState &state, int binding, QSGTexture **texture,
+                            QSGMaterial *newMaterial, QSGMaterial *) override
+    {
+        if (binding != 1)
+            return;
+        auto *mat = static_cast<SpectrogramMaterial *>(newMaterial);
+        mat->texture->commitTextureOperations(state.rhi(), state.resourceUpdateBatch());
+        *texture = mat->texture.get();
+    }
+};
+
+QSGMaterialShader *SpectrogramMaterial::createShader(QSGRendererInterface::RenderMode) const
+{
+    return new SpectrogramShader;
+}
+
+class SpectrogramNode : public QSGGeometryNode
+{
+public:
+    SpectrogramNode(int width, int rows)
+        : m_geometry(QSGGeometry::defaultAttributes_TexturedPoint2D(), 4)
+    {
+        m_material.texture = std::make_unique<SpectrogramTexture>(width, rows);
+        setGeometry(&m_geometry);
+        setMaterial(&m_material);
+    }
+
+    SpectrogramTexture  *texture()  { return m_material.texture.get(); }
+    SpectrogramMaterial *material() { return &m_material; }
+
+    QRectF rect;
+
+private:
+    QSGGeometry         m_geometry;
+    SpectrogramMaterial m_material;
+};
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// SpectrogramItem — Qt main thread (properties) / render thread (paint node)
+// ---------------------------------------------------------------------------
+
+SpectrogramItem::SpectrogramItem(QQuickItem *parent)
+    : QQuickItem(parent)
+{
+    setFlag(ItemHasContents, true);
+}
+
+SpectrogramItem::~SpectrogramItem() = default;
+
+void SpectrogramItem::setAudioSource(AudioVisualizer *source)
+{
+    if (m_audioSource == source)
+        return;
+    disconnect(m_spectrumConnection);
+    m_audioSource = source;
+    // Repaint once per analysis hop rather than on a timer
+    if (source)
+        m_spectrumConnection = connect(source, &AudioVisualizer::spectrumChanged,
+                                       this, &QQuickItem::update);
+    emit audioSourceChanged();
+    update();
+}
+
+void SpectrogramItem::setHistoryLength(int rows)
+{
+    rows = qBound(16, rows, 4096);
+    if (m_historyLength == rows)
+        return;
+    m_historyLength = rows;
+    emit historyLengthChanged();
+    update();
+}
+
+void SpectrogramItem::setBinCount(int bins)
+{
+    bins = qBound(8, bins, AudioVisualizer::spectrumSize());
+    if (m_binCount == bins)
+        return;
+    m_binCount = bins;
+    emit binCountChanged();
+    update();
+}
+
+void SpectrogramItem::setColorScheme(int scheme)
+{
+    if (m_colorScheme == scheme)
+        return;
+    m_colorScheme = scheme;
+    emit colorSchemeChanged();
+    update();
+}
+
+void SpectrogramItem::setGain(qreal gain)
+{
+    if (qFuzzyCompare(m_gain, gain))
+        return;
+    m_gain = gain;
+    emit gainChanged();
+    update();
+}
+
+QSGNode *SpectrogramItem::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *)
+{
+    auto *node = static_cast<SpectrogramNode *>(oldNode);
+    if (node && (node->texture()->width() != m_binCount || node->texture()->rows() != m_historyLength)) {
+        delete node;
+        node = nullptr;
+    }
+    if (!node)
+        node = new SpectrogramNode(m_binCount, m_historyLength);
+
+    const QRectF rect = boundingRect();
+    if (node->rect != rect) {
+        node->rect = rect;
+        QSGGeometry::updateTexturedRectGeometry(node->geometry(), rect, QRectF(0, 0, 1, 1));
+        node->markDirty(QSGNode::DirtyGeometry);
+    }
+
+    // Pull every hop published since the previous frame, one texture row each
+    auto ring = m_audioSource ? m_audioSource->spectrumRing() : std::shared_ptr<const SampleRing>();
+    if (ring != m_ring) {
+        m_ring = std::move(ring);
+        if (m_ring)
+            m_ringCursor = m_ring->writePosition();
+    }
+    if (m_ring) {
+        const int rowSize = AudioVisualizer::spectrumSize();
+        m_staging.resize(static_cast<size_t>(m_historyLength) * rowSize);
+        const int n = m_ring->read(m_ringCursor, m_staging.data(), static_cast<int>(m_staging.size()));
+        for (int off = 0; off + rowSize <= n; off += rowSize)
+            node->texture()->pushRow(m_staging.data() + off, rowSize);
+    }
+
+    SpectrogramMaterial *mat = node->material();
+    mat->gain        = static_cast<float>(m_gain);
+    mat->colorScheme = m_colorScheme;
+    node->markDirty(QSGNode::DirtyMaterial);
+    return node;
+}
+
+#include "spectrogramitem.moc"
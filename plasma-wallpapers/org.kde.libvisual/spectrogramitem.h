@@ -0,0 +1,75 @@
+/*
+ * SPDX-FileCopyrightText: 2026 VitexSoftware <vitex@vitexsoftware.cz>
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <QPointer>
+#include <QQuickItem>
+#include <QtQml/qqml.h>
+#include <memory>
+#include <vector>
+
+class AudioVisualizer;
+class SampleRing;
+
+/**
+ * Scrolling waterfall spectrogram drawn entirely by the scene graph.
+ *
+ * Spectrum history lives in a GPU ring texture of historyLength rows.  Each
+ * analysis hop published by the AudioVisualizer uploads exactly one new row
+ * as a sub-image update; scrolling is done in the fragment shader through a
+ * wrap offset uniform.  Per-frame cost is therefore constant regardless of
+ * how much history is visible — newest row at the top, oldest at the bottom.
+ */
+class SpectrogramItem : public QQuickItem
+{
+    Q_OBJECT
+    QML_ELEMENT
+
+    Q_PROPERTY(AudioVisualizer *audioSource   READ audioSource   WRITE setAudioSource   NOTIFY audioSourceChanged)
+    Q_PROPERTY(int              historyLength READ historyLength WRITE setHistoryLength NOTIFY historyLengthChanged)
+    Q_PROPERTY(int              binCount      READ binCount      WRITE setBinCount      NOTIFY binCountChanged)
+    Q_PROPERTY(int              colorScheme   READ colorScheme   WRITE setColorScheme   NOTIFY colorSchemeChanged)
+    Q_PROPERTY(qreal            gain          READ gain          WRITE setGain          NOTIFY gainChanged)
+
+public:
+    explicit SpectrogramItem(QQuickItem *parent = nullptr);
+    ~SpectrogramItem() override;
+
+    AudioVisualizer *audioSource()   const { return m_audioSource; }
+    int              historyLength() const { return m_historyLength; }
+    int              binCount()      const { return m_binCount; }
+    int              colorScheme()   const { return m_colorScheme; }
+    qreal            gain()          const { return m_gain; }
+
+    void setAudioSource(AudioVisualizer *source);
+    void setHistoryLength(int rows);
+    void setBinCount(int bins);
+    void setColorScheme(int scheme);
+    void setGain(qreal gain);
+
+signals:
+    void audioSourceChanged();
+    void historyLengthChanged();
+    void binCountChanged();
+    void colorSchemeChanged();
+    void gainChanged();
+
+protected:
+    QSGNode *updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *data) override;
+
+private:
+    QPointer<AudioVisualizer> m_audioSource;
+    QMetaObject::Connection   m_spectrumConnection;
+    int   m_historyLength = 256;
+    int   m_binCount      = 128;
+    int   m_colorScheme   = 0;
+    qreal m_gain          = 1.0;
+
+    // Render-thread state, touched only inside updatePaintNode()
+    std::shared_ptr<const SampleRing> m_ring;
+    quint64            m_ringCursor = 0;
+    std::vector<float> m_staging;
+};
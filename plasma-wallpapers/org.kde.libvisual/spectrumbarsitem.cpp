@@ -0,0 +1,314 @@
+/*
+ * SPDX-FileCopyrightText: 2026 VitexSoftware <vitex@vitexsoftware.cz>
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "spectrumbarsitem.h"
+#include "audiovisualizer.h"
+
+#include <QSGGeometry>
+#include <QSGGeometryNode>
+#include <QSGVertexColorMaterial>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr int VERTICES_PER_QUAD = 6;   // two triangles, DrawTriangles
+constexpr qreal PEAK_CAP_HEIGHT = 3.0; // logical pixels
+constexpr int SIMULATED_BINS = 64;     // the bar layout the QML analyser had
+
+// Simulated magnitude of bin i: each band level moves its own run of bins
+float simulatedLevel(int i, double t, const QVector4D &bands)
+{
+    const float band = i < 12 ? bands.x() : i < 24 ? bands.y() : i < 40 ? bands.z() : bands.w();
+    const double baseAmp = 0.3 + 0.7 * band;
+    const double randomFactor = std::abs(std::sin(t * (4.0 + i * 0.15) + i * 0.8));
+    return static_cast<float>(std::max(0.2, baseAmp * randomFactor * (0.7 + 0.5 * std::sin(t * 6.0 + i * 0.3))));
+}
+
+// QSGVertexColorMaterial expects premultiplied colours
+inline void setVertex(QSGGeometry::ColoredPoint2D &v, float x, float y, const QColor &c)
+{
+    const float a = static_cast<float>(c.alphaF());
+    v.set(x, y,
+          static_cast<uchar>(c.red()   * a),
+          static_cast<uchar>(c.green() * a),
+          static_cast<uchar>(c.blue()  * a),
+          static_cast<uchar>(c.alpha()));
+}
+
+// Writes one axis-aligned quad with a vertical gradient (top → bottom)
+inline QSGGeometry::ColoredPoint2D *writeQuad(QSGGeometry::ColoredPoint2D *v,
+                                              float x0, float y0, float x1, float y1,
+                                              const QColor &top, const QColor &bottom)
+{
+    setVertex(v[0], x0, y0, top);
+    setVertex(v[1], x1, y0, top);
+    setVertex(v[2], x0, y1, bottom);
+    setVertex(v[3], x1, y0, top);
+    setVertex(v[4], x1, y1, bottom);
+    setVertex(v[5], x0, y1, bottom);
+    return v + VERTICES_PER_QUAD;
+}
+
+inline QColor mixColor(const QColor &a, const QColor &b, float t)
+{
+    return QColor::fromRgbF(a.redF()   + (b.redF()   - a.redF())   * t,
+                            a.greenF() + (b.greenF() - a.greenF()) * t,
+                            a.blueF()  + (b.blueF()  - a.blueF())  * t,
+                            a.alphaF() + (b.alphaF() - a.alphaF()) * t);
+}
+
+} // namespace
+
+SpectrumBarsItem::SpectrumBarsItem(QQuickItem *parent)
+    : QQuickItem(parent)
+{
+    setFlag(ItemHasContents, true);
+    m_spectrum.assign(static_cast<size_t>(AudioVisualizer::spectrumSize()), 0.0f);
+    m_clock.start();
+}
+
+void SpectrumBarsItem::setAudioSource(AudioVisualizer *source)
+{
+    if (m_audioSource == source)
+        return;
+    disconnect(m_spectrumConnection);
+    m_audioSource = source;
+    // Rebuild once per analysis hop instead of per-bar bindings every frame
+    if (source)
+        m_spectrumConnection = connect(source, &AudioVisualizer::spectrumChanged,
+                                       this, &QQuickItem::update);
+    emit audioSourceChanged();
+    update();
+}
+
+void SpectrumBarsItem::setSimulated(bool simulated)
+{
+    if (m_simulated == simulated)
+        return;
+    m_simulated = simulated;
+    emit simulatedChanged();
+    update();
+}
+
+void SpectrumBarsItem::setTime(qreal seconds)
+{
+    if (qFuzzyCompare(m_time, seconds))
+        return;
+    m_time = seconds;
+    emit timeChanged();
+    // Also with live audio: peaks decay between analysis hops
+    update();
+}
+
+void SpectrumBarsItem::setBandLevels(const QVector4D &levels)
+{
+    if (m_bandLevels == levels)
+        return;
+    m_bandLevels = levels;
+    emit bandLevelsChanged();
+    if (m_simulated && !m_audioSource)
+        update();
+}
+
+void SpectrumBarsItem::setBarCount(int count)
+{
+    count = qBound(1, count, 1024);
+    if (m_barCount == count)
+        return;
+    m_barCount = count;
+    emit barCountChanged();
+    update();
+}
+
+void SpectrumBarsItem::setSpectrumBins(int bins)
+{
+    bins = qBound(1, bins, AudioVisualizer::spectrumSize());
+    if (m_spectrumBins == bins)
+        return;
+    m_spectrumBins = bins;
+    emit spectrumBinsChanged();
+    update();
+}
+
+void SpectrumBarsItem::setSpacing(qreal spacing)
+{
+    spacing = qBound(0.0, spacing, 0.95);
+    if (qFuzzyCompare(m_spacing, spacing))
+        return;
+    m_spacing = spacing;
+    emit spacingChanged();
+    update();
+}
+
+void SpectrumBarsItem::setGain(qreal gain)
+{
+    if (qFuzzyCompare(m_gain, gain))
+        return;
+    m_gain = gain;
+    emit gainChanged();
+    update();
+}
+
+void SpectrumBarsItem::setMinimumLevel(qreal level)
+{
+    level = qBound(0.0, level, 1.0);
+    if (qFuzzyCompare(m_minimumLevel, level))
+        return;
+    m_minimumLevel = level;
+    emit minimumLevelChanged();
+    update();
+}
+
+void SpectrumBarsItem::setBottomColor(const QColor &color)
+{
+    if (m_bottomColor == color)
+        return;
+    m_bottomColor = color;
+    emit gradientChanged();
+    update();
+}
+
+void SpectrumBarsItem::setTopColor(const QColor &color)
+{
+    if (m_topColor == color)
+        return;
+    m_topColor = color;
+    emit gradientChanged();
+    update();
+}
+
+void SpectrumBarsItem::setHueAcrossBars(bool enabled)
+{
+    if (m_hueAcrossBars == enabled)
+        return;
+    m_hueAcrossBars = enabled;
+    emit gradientChanged();
+    update();
+}
+
+void SpectrumBarsItem::setPeaksVisible(bool visible)
+{
+    if (m_peaksVisible == visible)
+        return;
+    m_peaksVisible = visible;
+    emit peaksChanged();
+    update();
+}
+
+void SpectrumBarsItem::setPeakColor(const QColor &color)
+{
+    if (m_peakColor == color)
+        return;
+    m_peakColor = color;
+    emit peaksChanged();
+    update();
+}
+
+void SpectrumBarsItem::setPeakDecay(qreal perSecond)
+{
+    if (qFuzzyCompare(m_peakDecay, perSecond))
+        return;
+    m_peakDecay = perSecond;
+    emit peaksChanged();
+    update();
+}
+
+// Render thread (GUI blocked): fold the newest spectrum row into bar levels
+void SpectrumBarsItem::updateLevels()
+{
+    const size_t bars = static_cast<size_t>(m_barCount);
+    if (m_levels.size() != bars) {
+        m_levels.assign(bars, 0.0f);
+        m_peaks.assign(bars, 0.0f);
+    }
+
+    // Bins the bars are spread across: the live spectrum, else the simulation
+    int bins = m_spectrumBins;
+    if (m_audioSource) {
+        m_audioSource->spectrumRing()->readLatest(m_spectrum.data(), AudioVisualizer::spectrumSize());
+    } else if (m_simulated) {
+        bins = std::min(SIMULATED_BINS, AudioVisualizer::spectrumSize());
+        for (int b = 0; b < bins; ++b)
+            m_spectrum[static_cast<size_t>(b)] = simulatedLevel(b, m_time, m_bandLevels);
+    } else {
+        std::fill(m_spectrum.begin(), m_spectrum.end(), 0.0f);
+    }
+
+    const float dt    = static_cast<float>(m_clock.restart()) / 1000.0f;
+    const float decay = static_cast<float>(m_peakDecay) * std::min(dt, 0.25f);
+    const float gain  = static_cast<float>(m_gain);
+    const float floor = static_cast<float>(m_minimumLevel);
+
+    for (int i = 0; i < m_barCount; ++i) {
+        const int first = i * bins / m_barCount;
+        const int last  = std::max(first + 1, (i + 1) * bins / m_barCount);
+        float sum = 0.0f;
+        for (int b = first; b < last; ++b)
+            sum += m_spectrum[static_cast<size_t>(b)];
+        const float level = std::clamp(sum / (last - first) * gain, floor, 1.0f);
+
+        m_levels[static_cast<size_t>(i)] = level;
+        float &peak = m_peaks[static_cast<size_t>(i)];
+        peak = std::max(level, peak - decay);
+    }
+}
+
+QSGNode *SpectrumBarsItem::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *)
+{
+    auto *node = static_cast<QSGGeometryNode *>(oldNode);
+    if (!node) {
+        node = new QSGGeometryNode;
+        auto *geometry = new QSGGeometry(QSGGeometry::defaultAttributes_ColoredPoint2D(), 0);
+        geometry->setDrawingMode(QSGGeometry::DrawTriangles);
+        geometry->setVertexDataPattern(QSGGeometry::DynamicPattern);
+        node->setGeometry(geometry);
+        node->setFlag(QSGNode::OwnsGeometry);
+        node->setMaterial(new QSGVertexColorMaterial);
+        node->setFlag(QSGNode::OwnsMaterial);
+    }
+
+    updateLevels();
+
+    // Reuse the vertex buffer; it is only reallocated when the bar layout changes
+    QSGGeometry *geometry = node->geometry();
+    const int quadsPerBar = m_peaksVisible ? 2 : 1;
+    const int vertexCount = m_barCount * quadsPerBar * VERTICES_PER_QUAD;
+    if (geometry->vertexCount() != vertexCount)
+        geometry->allocate(vertexCount);
+
+    const float w     = static_cast<float>(width());
+    const float h     = static_cast<float>(height());
+    const float slot  = w / m_barCount;
+    const float barW  = slot * static_cast<float>(1.0 - m_spacing);
+    const float inset = (slot - barW) * 0.5f;
+    const float capH  = static_cast<float>(PEAK_CAP_HEIGHT);
+
+    auto *v = geometry->vertexDataAsColoredPoint2D();
+    for (int i = 0; i < m_barCount; ++i) {
+        const float level = m_levels[static_cast<size_t>(i)];
+        const float x0    = i * slot + inset;
+        const float x1    = x0 + barW;
+
+        QColor top = m_topColor;
+        if (m_hueAcrossBars)
+            top = QColor::fromHsvF(static_cast<float>(i) / m_barCount,
+                                   m_topColor.hsvSaturationF(), m_topColor.valueF(),
+                                   m_topColor.alphaF());
+        // Short bars fade toward the bottom colour, like the old per-bar intensity
+        top = mixColor(m_bottomColor, top, level);
+        v = writeQuad(v, x0, h * (1.0f - level), x1, h, top, m_bottomColor);
+
+        if (m_peaksVisible) {
+            const float py = std::max(0.0f, h * (1.0f - m_peaks[static_cast<size_t>(i)]) - capH);
+            v = writeQuad(v, x0, py, x1, py + capH, m_peakColor, m_peakColor);
+        }
+    }
+
+    node->markDirty(QSGNode::DirtyGeometry);
+    return node;
+}
+
+#include "spectrumbarsitem.moc"
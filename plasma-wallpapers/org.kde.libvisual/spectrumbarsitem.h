@@ -0,0 +1,132 @@
+/*
+ * SPDX-FileCopyrightText: 2026 VitexSoftware <vitex@vitexsoftware.cz>
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <QColor>
+#include <QElapsedTimer>
+#include <QPointer>
+#include <QQuickItem>
+#include <QVector4D>
+#include <QtQml/qqml.h>
+#include <vector>
+
+class AudioVisualizer;
+
+/**
+ * Spectrum bar analyser rendered as a single QSGGeometryNode.
+ *
+ * All bars (and their optional peak caps) are triangles in one vertex-coloured
+ * geometry whose vertex buffer is allocated once per barCount and rewritten in
+ * place on each analysis hop, so the whole analyser is one draw call with no
+ * per-bar QML items or bindings.  Magnitudes are read straight from the
+ * AudioVisualizer spectrum ring instead of the QVariantList property.
+ *
+ * Peaks fall with elapsed time, measured between paints.  The item repaints on
+ * each analysis hop and whenever time changes, so binding time to the frame
+ * clock keeps peaks falling while no hops arrive.  Without an audio source and
+ * with simulated set, the bars follow a spectrum simulated from time and
+ * bandLevels (bass, mid, treble, overall) instead of silence.
+ */
+class SpectrumBarsItem : public QQuickItem
+{
+    Q_OBJECT
+    QML_ELEMENT
+
+    Q_PROPERTY(AudioVisualizer *audioSource  READ audioSource  WRITE setAudioSource  NOTIFY audioSourceChanged)
+    Q_PROPERTY(bool      simulated  READ simulated  WRITE setSimulated  NOTIFY simulatedChanged)
+    Q_PROPERTY(qreal     time       READ time       WRITE setTime       NOTIFY timeChanged)
+    Q_PROPERTY(QVector4D bandLevels READ bandLevels WRITE setBandLevels NOTIFY bandLevelsChanged)
+    Q_PROPERTY(int    barCount      READ barCount      WRITE setBarCount      NOTIFY barCountChanged)
+    Q_PROPERTY(int    spectrumBins  READ spectrumBins  WRITE setSpectrumBins  NOTIFY spectrumBinsChanged)
+    Q_PROPERTY(qreal  spacing       READ spacing       WRITE setSpacing       NOTIFY spacingChanged)
+    Q_PROPERTY(qreal  gain          READ gain          WRITE setGain          NOTIFY gainChanged)
+    Q_PROPERTY(qreal  minimumLevel  READ minimumLevel  WRITE setMinimumLevel  NOTIFY minimumLevelChanged)
+    Q_PROPERTY(QColor bottomColor   READ bottomColor   WRITE setBottomColor   NOTIFY gradientChanged)
+    Q_PROPERTY(QColor topColor      READ topColor      WRITE setTopColor      NOTIFY gradientChanged)
+    Q_PROPERTY(bool   hueAcrossBars READ hueAcrossBars WRITE setHueAcrossBars NOTIFY gradientChanged)
+    Q_PROPERTY(bool   peaksVisible  READ peaksVisible  WRITE setPeaksVisible  NOTIFY peaksChanged)
+    Q_PROPERTY(QColor peakColor     READ peakColor     WRITE setPeakColor     NOTIFY peaksChanged)
+    Q_PROPERTY(qreal  peakDecay     READ peakDecay     WRITE setPeakDecay     NOTIFY peaksChanged)
+
+public:
+    explicit SpectrumBarsItem(QQuickItem *parent = nullptr);
+
+    AudioVisualizer *audioSource() const { return m_audioSource; }
+    bool      simulated()  const { return m_simulated; }
+    qreal     time()       const { return m_time; }
+    QVector4D bandLevels() const { return m_bandLevels; }
+    int    barCount()      const { return m_barCount; }
+    int    spectrumBins()  const { return m_spectrumBins; }
+    qreal  spacing()       const { return m_spacing; }
+    qreal  gain()          const { return m_gain; }
+    qreal  minimumLevel()  const { return m_minimumLevel; }
+    QColor bottomColor()   const { return m_bottomColor; }
+    QColor topColor()      const { return m_topColor; }
+    bool   hueAcrossBars() const { return m_hueAcrossBars; }
+    bool   peaksVisible()  const { return m_peaksVisible; }
+    QColor peakColor()     const { return m_peakColor; }
+    qreal  peakDecay()     const { return m_peakDecay; }
+
+    void setAudioSource(AudioVisualizer *source);
+    void setSimulated(bool simulated);
+    void setTime(qreal seconds);
+    void setBandLevels(const QVector4D &levels);
+    void setBarCount(int count);
+    void setSpectrumBins(int bins);
+    void setSpacing(qreal spacing);
+    void setGain(qreal gain);
+    void setMinimumLevel(qreal level);
+    void setBottomColor(const QColor &color);
+    void setTopColor(const QColor &color);
+    void setHueAcrossBars(bool enabled);
+    void setPeaksVisible(bool visible);
+    void setPeakColor(const QColor &color);
+    void setPeakDecay(qreal perSecond);
+
+signals:
+    void audioSourceChanged();
+    void simulatedChanged();
+    void timeChanged();
+    void bandLevelsChanged();
+    void barCountChanged();
+    void spectrumBinsChanged();
+    void spacingChanged();
+    void gainChanged();
+    void minimumLevelChanged();
+    void gradientChanged();
+    void peaksChanged();
+
+protected:
+    QSGNode *updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *data) override;
+
+private:
+    void updateLevels();
+
+    QPointer<AudioVisualizer> m_audioSource;
+    QMetaObject::Connection   m_spectrumConnection;
+
+    bool      m_simulated = false;
+    qreal     m_time      = 0.0;   // seconds
+    QVector4D m_bandLevels;        // bass, mid, treble, overall; 0..1
+
+    int    m_barCount      = 64;
+    int    m_spectrumBins  = 64;
+    qreal  m_spacing       = 0.2;
+    qreal  m_gain          = 1.0;
+    qreal  m_minimumLevel  = 0.05;
+    QColor m_bottomColor   = QColor(40, 80, 160);
+    QColor m_topColor      = QColor(120, 220, 255);
+    bool   m_hueAcrossBars = false;
+    bool   m_peaksVisible  = true;
+    QColor m_peakColor     = QColor(255, 255, 255);
+    qreal  m_peakDecay     = 0.6;   // fraction of full height per second
+
+    // Bar state, refreshed on the render thread in updatePaintNode()
+    std::vector<float> m_spectrum;
+    std::vector<float> m_levels;
+    std::vector<float> m_peaks;
+    QElapsedTimer      m_clock;
+};
@@ -0,0 +1,101 @@
+/*
+ * SPDX-FileCopyrightText: 2026 VitexSoftware <vitex@vitexsoftware.cz>
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "visualizationregistry.h"
+
+#include <QDebug>
+#include <iterator>
+
+namespace {
+
+// Indexed by visualizationType; keep in sync with the combo box in config.qml
+constexpr VisualizationRegistry::Entry ENTRIES[] = {
+    { 0, "Spectrum",          "SpectrumBars.qml"     },
+    { 1, "Waveform",          "Waveform.qml"         },
+    { 2, "Lissajous",         "Oscilloscope.qml"     },
+    { 3, "Circular Burst",    "CircularBurst.qml"    },
+    { 4, "Circular Spectrum", "CircularSpectrum.qml" },
+    { 5, "Plasma",            "Plasma.qml"           },
+    { 6, "Starfield",         "Starfield.qml"        },
+    { 7, "Fireworks",         "Fireworks.qml"        },
+    { 8, "Matrix Rain",       "MatrixRain.qml"       },
+    { 9, "DNA Helix",         "DnaHelix.qml"         },
+    {10, "Particle Storm",    "ParticleStorm.qml"    },
+    {11, "Ripple Effect",     "RippleEffect.qml"     },
+    {12, "Tunnel Vision",     "TunnelVision.qml"     },
+    {13, "Spiral Galaxy",     "SpiralGalaxy.qml"     },
+    {14, "Lightning",         "Lightning.qml"        },
+    {15, "Mandelbrot (GPU)",  "Mandelbrot.qml"       },
+    {16, "Geometric Dance",   "GeometricDance.qml"   },
+    {17, "Audio Bars 3D",     "AudioBars3D.qml"      },
+    {18, "Kaleidoscope",      "Kaleidoscope.qml"     },
+    {19, "ProjectM",          "ProjectM.qml"         },
+    {20, "Spectrogram",       "Spectrogram.qml"      },
+    {21, "Deep Zoom",         "DeepMandelbrot.qml"   },
+};
+
+constexpr bool indexedByType()
+{
+    for (size_t i = 0; i < std::size(ENTRIES); ++i) {
+        if (ENTRIES[i].type != static_cast<int>(i))
+            return false;
+    }
+    return true;
+}
+static_assert(indexedByType(), "ENTRIES must be ordered by visualization type without gaps");
+
+constexpr int DEFAULT_TYPE = 0;
+
+} // namespace
+
+VisualizationRegistry::VisualizationRegistry(QObject *parent)
+    : QObject(parent)
+{
+}
+
+const VisualizationRegistry::Entry *VisualizationRegistry::find(int type)
+{
+    if (type < 0 || type >= static_cast<int>(std::size(ENTRIES)))
+        return nullptr;
+    return &ENTRIES[type];
+}
+
+int VisualizationRegistry::count() const
+{
+    return static_cast<int>(std::size(ENTRIES));
+}
+
+QStringList VisualizationRegistry::names() const
+{
+    QStringList list;
+    list.reserve(count());
+    for (const Entry &entry : ENTRIES)
+        list.append(QString::fromLatin1(entry.name));
+    return list;
+}
+
+bool VisualizationRegistry::contains(int type) const
+{
+    return find(type) != nullptr;
+}
+
+QString VisualizationRegistry::nameFor(int type) const
+{
+    const Entry *entry = find(type);
+    return entry ? QString::fromLatin1(entry->name) : QStringLiteral("?");
+}
+
+QString VisualizationRegistry::fileFor(int type) const
+{
+    const Entry *entry = find(type);
+    if (!entry) {
+        qWarning() << "VisualizationRegistry: unknown visualization type" << type
+                   << "- falling back to" << ENTRIES[DEFAULT_TYPE].name;
+        entry = &ENTRIES[DEFAULT_TYPE];
+    }
+    return QString::fromLatin1(entry->file);
+}
+
+#include "visualizationregistry.moc"
@@ -0,0 +1,49 @@
+/*
+ * SPDX-FileCopyrightText: 2026 VitexSoftware <vitex@vitexsoftware.cz>
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QtQml/qqml.h>
+
+/**
+ * Catalogue of the wallpaper's visualization types.
+ *
+ * Maps the numeric visualizationType stored in the configuration to a display
+ * name and to the QML file (relative to contents/ui/visualizations/) that
+ * implements it.  The wallpaper's VisualizationHost uses it to instantiate
+ * only the selected type through a Loader instead of declaring every type up
+ * front and toggling visibility.
+ */
+class VisualizationRegistry : public QObject
+{
+    Q_OBJECT
+    QML_ELEMENT
+    QML_SINGLETON
+
+    Q_PROPERTY(int         count READ count CONSTANT)
+    Q_PROPERTY(QStringList names READ names CONSTANT)
+
+public:
+    struct Entry {
+        int         type;
+        const char *name;
+        const char *file;
+    };
+
+    explicit VisualizationRegistry(QObject *parent = nullptr);
+
+    int         count() const;
+    QStringList names() const;
+
+    Q_INVOKABLE bool    contains(int type) const;
+    Q_INVOKABLE QString nameFor(int type) const;
+    // QML file name, or the default type's file for unknown types
+    Q_INVOKABLE QString fileFor(int type) const;
+
+    static const Entry *find(int type);
+};
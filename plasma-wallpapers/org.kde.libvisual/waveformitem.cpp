@@ -0,0 +1,450 @@
+/*
+ * SPDX-FileCopyrightText: 2026 VitexSoftware <vitex@vitexsoftware.cz>
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "waveformitem.h"
+#include "audiovisualizer.h"
+
+#include <QSGGeometry>
+#include <QSGGeometryNode>
+#include <QSGMaterial>
+#include <QSGMaterialShader>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+// ---------------------------------------------------------------------------
+// Vertex layout + material — distance-to-centre drives core and glow
+// ---------------------------------------------------------------------------
+
+namespace {
+
+constexpr float MITER_LIMIT = 2.0f;   // cap on the mitre stretch at sharp turns
+constexpr float AA_MARGIN   = 1.0f;   // extra pixel so the core edge can fade out
+
+struct LineVertex {
+    float x;
+    float y;
+    float across;   // signed distance from the centre line, logical pixels
+};
+
+const QSGGeometry::AttributeSet &lineAttributes()
+{
+    static const QSGGeometry::Attribute attrs[] = {
+        QSGGeometry::Attribute::createWithAttributeType(0, 2, QSGGeometry::FloatType,
+                                                        QSGGeometry::PositionAttribute),
+        QSGGeometry::Attribute::createWithAttributeType(1, 1, QSGGeometry::FloatType,
+                                                        QSGGeometry::UnknownAttribute),
+    };
+    static const QSGGeometry::AttributeSet set = {2, sizeof(LineVertex), attrs};
+    return set;
+}
+
+class PolylineMaterial : public QSGMaterial
+{
+public:
+    PolylineMaterial() { setFlag(Blending); }
+
+    QSGMaterialType *type() const override
+    {
+        static QSGMaterialType materialType;
+        return &materialType;
+    }
+
+    QSGMaterialShader *createShader(QSGRendererInterface::RenderMode) const override;
+
+    int compare(const QSGMaterial *other) const override
+    {
+        auto *o = static_cast<const PolylineMaterial *>(other);
+        if (color != o->color)
+            return color.rgba() < o->color.rgba() ? -1 : 1;
+        if (halfWidth != o->halfWidth)
+            return halfWidth < o->halfWidth ? -1 : 1;
+        if (glowWidth != o->glowWidth)
+            return glowWidth < o->glowWidth ? -1 : 1;
+        if (glow != o->glow)
+            return glow < o->glow ? -1 : 1;
+        return 0;
+    }
+
+    QColor color;
+    float  halfWidth = 1.0f;
+    float  glowWidth = 0.0f;
+    float  glow      = 0.0f;
+};
+
+class PolylineShader : public QSGMaterialShader
+{
+public:
+    PolylineShader()
+    {
+        setShaderFileName(VertexStage,   QStringLiteral(":/audiovisualizer/shaders/polyline.vert.qsb"));
+        setShaderFileName(FragmentStage, QStringLiteral(":/audiovisualizer/shaders/polyline.frag.qsb"));
+    }
+
+    // std140 layout: mat4 qt_Matrix, float qt_Opacity, float halfWidth,
+    // float glowWidth, float glow, vec4 color (premultiplied)
+    bool updateUniformData(RenderState &state, QSGMaterial *newMaterial, QSGMaterial *) override
+    {
+        auto *mat = static_cast<PolylineMaterial *>(newMaterial);
+        QByteArray *buf = state.uniformData();
+        if (state.isMatrixDirty())
+            std::memcpy(buf->data(), state.combinedMatrix().constData(), 64);
+        if (state.isOpacityDirty()) {
+            const float opacity = state.opacity();
+            std::memcpy(buf->data() + 64, &opacity, 4);
+        }
+        std::memcpy(buf->data() + 68, &mat->halfWidth, 4);
+        std::memcpy(buf->data() + 72, &mat->glowWidth, 4);
+        std::memcpy(buf->data() + 76, &mat->glow, 4);
+        const float a = static_cast<float>(mat->color.alphaF());
+        const float color[4] = {
+            static_cast<float>(mat->color.redF())   * a,
+            static_cast<float>(mat->color.greenF()) * a,
+            static_cast<float>(mat->color.blueF())  * a,
+            a,
+        };
+        std::memcpy(buf->data() + 80, color, 16);
+        return true;
+    }
+};
+
+QSGMaterialShader *PolylineMaterial::createShader(QSGRendererInterface::RenderMode) const
+{
+    return new PolylineShader;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// WaveformItem — Qt main thread (properties) / render thread (paint node)
+// ---------------------------------------------------------------------------
+
+WaveformItem::WaveformItem(QQuickItem *parent)
+    : QQuickItem(parent)
+{
+    setFlag(ItemHasContents, true);
+}
+
+void WaveformItem::setAudioSource(AudioVisualizer *source)
+{
+    if (m_audioSource == source)
+        return;
+    disconnect(m_audioConnection);
+    m_audioSource = source;
+    // One rebuild per analysis hop; the PCM ring advances at the same cadence
+    if (source)
+        m_audioConnection = connect(source, &AudioVisualizer::spectrumChanged,
+                                    this, &QQuickItem::update);
+    emit audioSourceChanged();
+    update();
+}
+
+void WaveformItem::setFigure(Figure figure)
+{
+    if (m_figure == figure)
+        return;
+    m_figure = figure;
+    emit figureChanged();
+    update();
+}
+
+void WaveformItem::setTime(qreal seconds)
+{
+    if (qFuzzyCompare(m_time, seconds))
+        return;
+    m_time = seconds;
+    emit timeChanged();
+    if (simulating())
+        update();
+}
+
+void WaveformItem::setBandLevels(const QVector4D &levels)
+{
+    if (m_bandLevels == levels)
+        return;
+    m_bandLevels = levels;
+    emit bandLevelsChanged();
+    if (simulating())
+        update();
+}
+
+void WaveformItem::setSource(Source source)
+{
+    if (m_source == source)
+        return;
+    m_source = source;
+    emit sourceChanged();
+    update();
+}
+
+void WaveformItem::setShape(Shape shape)
+{
+    if (m_shape == shape)
+        return;
+    m_shape = shape;
+    emit shapeChanged();
+    update();
+}
+
+void WaveformItem::setSampleCount(int count)
+{
+    count = qBound(2, count, 4096);
+    if (m_sampleCount == count)
+        return;
+    m_sampleCount = count;
+    emit sampleCountChanged();
+    update();
+}
+
+void WaveformItem::setAmplitude(qreal amplitude)
+{
+    if (qFuzzyCompare(m_amplitude, amplitude))
+        return;
+    m_amplitude = amplitude;
+    emit amplitudeChanged();
+    update();
+}
+
+void WaveformItem::setRadius(qreal radius)
+{
+    radius = qBound(0.0, radius, 1.0);
+    if (qFuzzyCompare(m_radius, radius))
+        return;
+    m_radius = radius;
+    emit radiusChanged();
+    update();
+}
+
+void WaveformItem::setLineWidth(qreal width)
+{
+    width = std::max(0.5, width);
+    if (qFuzzyCompare(m_lineWidth, width))
+        return;
+    m_lineWidth = width;
+    emit lineWidthChanged();
+    update();
+}
+
+void WaveformItem::setGlowWidth(qreal width)
+{
+    width = std::max(0.0, width);
+    if (qFuzzyCompare(m_glowWidth, width))
+        return;
+    m_glowWidth = width;
+    emit glowWidthChanged();
+    update();
+}
+
+void WaveformItem::setGlow(qreal glow)
+{
+    glow = qBound(0.0, glow, 1.0);
+    if (qFuzzyCompare(m_glow, glow))
+        return;
+    m_glow = glow;
+    emit glowChanged();
+    update();
+}
+
+void WaveformItem::setColor(const QColor &color)
+{
+    if (m_color == color)
+        return;
+    m_color = color;
+    emit colorChanged();
+    update();
+}
+
+// Render thread (GUI blocked): one value per curve point, waveform in [-1, 1],
+// spectrum in [0, 1]; left/right pairs in [-1, 1] for stereo
+void WaveformItem::updateValues()
+{
+    const size_t points = static_cast<size_t>(m_sampleCount);
+    m_values.resize(m_source == Stereo ? points * 2 : points);
+
+    if (!m_audioSource) {
+        if (simulating())
+            simulateFigure();
+        else
+            std::fill(m_values.begin(), m_values.end(), 0.0f);
+        return;
+    }
+
+    if (m_source == Waveform) {
+        m_audioSource->pcmRing()->readLatest(m_values.data(), m_sampleCount);
+        return;
+    }
+    if (m_source == Stereo) {
+        m_audioSource->stereoRing()->readLatest(m_values.data(), m_sampleCount * 2);
+        return;
+    }
+
+    // Spectrum: linear interpolation across the bins, so any point count works
+    const int bins = AudioVisualizer::spectrumSize();
+    m_raw.resize(static_cast<size_t>(bins));
+    m_audioSource->spectrumRing()->readLatest(m_raw.data(), bins);
+    const float step = points > 1 ? static_cast<float>(bins - 1) / (points - 1) : 0.0f;
+    for (size_t i = 0; i < points; ++i) {
+        const float pos  = i * step;
+        const int   b    = std::min(static_cast<int>(pos), bins - 2);
+        const float frac = pos - b;
+        m_values[i] = m_raw[b] + (m_raw[b + 1] - m_raw[b]) * frac;
+    }
+}
+
+// Render thread: left/right pairs of the simulated figure, one per point
+void WaveformItem::simulateFigure()
+{
+    const int    n     = m_sampleCount;
+    const double t     = m_time;
+    const double twoPi = 6.28318530718;
+    for (int i = 0; i < n; ++i) {
+        double x;
+        double y;
+        if (m_figure == BassTrebleFigure) {
+            const double a = twoPi * 2.0 * i / n + t * 3.0;
+            x = m_bandLevels.x() * std::sin(a * 2.0 + t * 2.0) * (0.8 + 0.2 * std::sin(a * 0.5));
+            y = m_bandLevels.z() * std::cos(a * 3.0 + t * 1.5) * (0.8 + 0.2 * std::cos(a * 0.3));
+        } else {
+            const double a = twoPi * 3.0 * i / n + t * 4.0;
+            x = m_bandLevels.y() * std::cos(a * 1.5 + t * 3.0);
+            y = m_bandLevels.w() * std::sin(a * 2.5 + t * 2.0);
+        }
+        m_values[static_cast<size_t>(2 * i)]     = static_cast<float>(x);
+        m_values[static_cast<size_t>(2 * i + 1)] = static_cast<float>(y);
+    }
+}
+
+// Maps the values to item coordinates (interleaved x, y in m_points)
+void WaveformItem::buildCurve()
+{
+    const int   n    = m_sampleCount;
+    const float w    = static_cast<float>(width());
+    const float h    = static_cast<float>(height());
+    const float amp  = static_cast<float>(m_amplitude);
+    const bool  wave = m_source == Waveform;
+    m_points.resize(static_cast<size_t>(n) * 2);
+
+    if (m_source == Stereo) {
+        // Left channel across, right channel up; a mono signal is the diagonal
+        const float cx     = w * 0.5f;
+        const float cy     = h * 0.5f;
+        const float extent = std::min(w, h) * 0.5f * amp;
+        for (int i = 0; i < n; ++i) {
+            m_points[2 * i]     = cx + extent * m_values[static_cast<size_t>(2 * i)];
+            m_points[2 * i + 1] = cy - extent * m_values[static_cast<size_t>(2 * i + 1)];
+        }
+        return;
+    }
+
+    if (m_shape == Linear) {
+        // Waveform swings around the middle, spectrum rises from the bottom
+        const float base   = wave ? h * 0.5f : h;
+        const float extent = wave ? h * 0.5f * amp : -h * amp;
+        for (int i = 0; i < n; ++i) {
+            m_points[2 * i]     = w * i / (n - 1);
+            m_points[2 * i + 1] = base - extent * m_values[static_cast<size_t>(i)];
+        }
+        return;
+    }
+
+    const float cx     = w * 0.5f;
+    const float cy     = h * 0.5f;
+    const float halfR  = std::min(w, h) * 0.5f;
+    const float base   = halfR * static_cast<float>(m_radius);
+    const float extent = (halfR - base) * amp;
+    const float twoPi  = 6.28318530718f;
+    for (int i = 0; i < n; ++i) {
+        const float angle = twoPi * i / n - twoPi * 0.25f;   // start at 12 o'clock
+        const float r     = std::max(0.0f, base + extent * m_values[static_cast<size_t>(i)]);
+        m_points[2 * i]     = cx + std::cos(angle) * r;
+        m_points[2 * i + 1] = cy + std::sin(angle) * r;
+    }
+}
+
+QSGNode *WaveformItem::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *)
+{
+    auto *node = static_cast<QSGGeometryNode *>(oldNode);
+    if (!node) {
+        node = new QSGGeometryNode;
+        auto *geometry = new QSGGeometry(lineAttributes(), 0);
+        geometry->setDrawingMode(QSGGeometry::DrawTriangleStrip);
+        geometry->setVertexDataPattern(QSGGeometry::DynamicPattern);
+        node->setGeometry(geometry);
+        node->setFlag(QSGNode::OwnsGeometry);
+        node->setMaterial(new PolylineMaterial);
+        node->setFlag(QSGNode::OwnsMaterial);
+    }
+
+    updateValues();
+    buildCurve();
+
+    // Radial curves are closed: repeat the first point to seal the strip
+    const bool closed      = m_shape == Radial && m_source != Stereo;
+    const int  n           = m_sampleCount;
+    const int  vertexCount = (closed ? n + 1 : n) * 2;
+    QSGGeometry *geometry  = node->geometry();
+    if (geometry->vertexCount() != vertexCount)
+        geometry->allocate(vertexCount);
+
+    const float halfWidth = static_cast<float>(m_lineWidth) * 0.5f;
+    const float reach     = halfWidth + static_cast<float>(m_glowWidth) + AA_MARGIN;
+    const float *p        = m_points.data();
+    auto *v = static_cast<LineVertex *>(geometry->vertexData());
+
+    auto direction = [&](int from, int to, float &dx, float &dy) {
+        dx = p[2 * to] - p[2 * from];
+        dy = p[2 * to + 1] - p[2 * from + 1];
+        const float len = std::sqrt(dx * dx + dy * dy);
+        if (len > 1e-6f) {
+            dx /= len;
+            dy /= len;
+        } else {
+            dx = 1.0f;
+            dy = 0.0f;
+        }
+    };
+
+    for (int k = 0; k < vertexCount / 2; ++k) {
+        const int i    = k % n;
+        const int prev = closed ? (i + n - 1) % n : std::max(i - 1, 0);
+        const int next = closed ? (i + 1) % n : std::min(i + 1, n - 1);
+
+        // Mitred normal: bisector of the adjacent segment normals, stretched
+        // so the strip keeps its width through turns (capped for spikes)
+        float ix, iy, ox, oy;
+        direction(prev, i, ix, iy);
+        direction(i, next, ox, oy);
+        if (i == prev) { ix = ox; iy = oy; }
+        if (i == next) { ox = ix; oy = iy; }
+        float nx = -(iy + oy);
+        float ny = ix + ox;
+        const float len = std::sqrt(nx * nx + ny * ny);
+        if (len > 1e-6f) {
+            nx /= len;
+            ny /= len;
+        } else {
+            nx = -oy;
+            ny = ox;
+        }
+        const float cosHalf = std::max(nx * -oy + ny * ox, 1.0f / MITER_LIMIT);
+        const float offset  = reach / cosHalf;
+
+        const float x = p[2 * i];
+        const float y = p[2 * i + 1];
+        v[2 * k]     = {x + nx * offset, y + ny * offset,  reach};
+        v[2 * k + 1] = {x - nx * offset, y - ny * offset, -reach};
+    }
+
+    auto *mat = static_cast<PolylineMaterial *>(node->material());
+    mat->color     = m_color;
+    mat->halfWidth = halfWidth;
+    mat->glowWidth = static_cast<float>(m_glowWidth);
+    mat->glow      = static_cast<float>(m_glow);
+
+    node->markDirty(QSGNode::DirtyGeometry | QSGNode::DirtyMaterial);
+    return node;
+}
+
+#include "waveformitem.moc"
@@ -0,0 +1,150 @@
+/*
+ * SPDX-FileCopyrightText: 2026 VitexSoftware <vitex@vitexsoftware.cz>
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <QColor>
+#include <QPointer>
+#include <QQuickItem>
+#include <QVector4D>
+#include <QtQml/qqml.h>
+#include <vector>
+
+class AudioVisualizer;
+
+/**
+ * Thick, glowing polyline generated on the GPU from audio snapshots.
+ *
+ * The line is one triangle strip: every curve point becomes two vertices
+ * offset along the (mitred) normal by half the line width plus the glow
+ * width.  Each vertex also carries its signed distance from the centre line,
+ * which the fragment shader turns into an anti-aliased core and a soft glow
+ * falloff — no CPU rasterisation, no full-screen texture upload.
+ *
+ * The curve follows either the newest PCM samples (oscilloscope) or the newest
+ * spectrum row, laid out horizontally across the item or around a circle, or
+ * plots the newest stereo frames left against right (XY scope).  Without an
+ * audio source a Stereo curve traces the simulated figure instead, moved by
+ * time and bandLevels (bass, mid, treble, overall), so the fallback needs no
+ * per-point values from QML.
+ */
+class WaveformItem : public QQuickItem
+{
+    Q_OBJECT
+    QML_ELEMENT
+
+    Q_PROPERTY(AudioVisualizer *audioSource READ audioSource WRITE setAudioSource NOTIFY audioSourceChanged)
+    Q_PROPERTY(Figure    figure     READ figure     WRITE setFigure     NOTIFY figureChanged)
+    Q_PROPERTY(qreal     time       READ time       WRITE setTime       NOTIFY timeChanged)
+    Q_PROPERTY(QVector4D bandLevels READ bandLevels WRITE setBandLevels NOTIFY bandLevelsChanged)
+    Q_PROPERTY(Source source      READ source      WRITE setSource      NOTIFY sourceChanged)
+    Q_PROPERTY(Shape  shape       READ shape       WRITE setShape       NOTIFY shapeChanged)
+    Q_PROPERTY(int    sampleCount READ sampleCount WRITE setSampleCount NOTIFY sampleCountChanged)
+    Q_PROPERTY(qreal  amplitude   READ amplitude   WRITE setAmplitude   NOTIFY amplitudeChanged)
+    Q_PROPERTY(qreal  radius      READ radius      WRITE setRadius      NOTIFY radiusChanged)
+    Q_PROPERTY(qreal  lineWidth   READ lineWidth   WRITE setLineWidth   NOTIFY lineWidthChanged)
+    Q_PROPERTY(qreal  glowWidth   READ glowWidth   WRITE setGlowWidth   NOTIFY glowWidthChanged)
+    Q_PROPERTY(qreal  glow        READ glow        WRITE setGlow        NOTIFY glowChanged)
+    Q_PROPERTY(QColor color       READ color       WRITE setColor       NOTIFY colorChanged)
+
+public:
+    enum Source {
+        Waveform, // newest sampleCount PCM samples, centred on the baseline
+        Spectrum, // newest spectrum row resampled to sampleCount points
+        Stereo    // newest sampleCount stereo frames, left as X and right as Y;
+                  // the shape is ignored
+    };
+    Q_ENUM(Source)
+
+    enum Shape {
+        Linear, // left to right across the item
+        Radial  // closed loop around the item centre
+    };
+    Q_ENUM(Shape)
+
+    // Simulated Lissajous figures for a Stereo curve without an audio source
+    enum Figure {
+        NoFigure,         // silence: a dot in the centre
+        BassTrebleFigure, // bass across, treble up
+        MidPeakFigure     // mid across, overall level up
+    };
+    Q_ENUM(Figure)
+
+    explicit WaveformItem(QQuickItem *parent = nullptr);
+
+    AudioVisualizer *audioSource() const { return m_audioSource; }
+    Figure    figure()     const { return m_figure; }
+    qreal     time()       const { return m_time; }
+    QVector4D bandLevels() const { return m_bandLevels; }
+    Source source()      const { return m_source; }
+    Shape  shape()       const { return m_shape; }
+    int    sampleCount() const { return m_sampleCount; }
+    qreal  amplitude()   const { return m_amplitude; }
+    qreal  radius()      const { return m_radius; }
+    qreal  lineWidth()   const { return m_lineWidth; }
+    qreal  glowWidth()   const { return m_glowWidth; }
+    qreal  glow()        const { return m_glow; }
+    QColor color()       const { return m_color; }
+
+    void setAudioSource(AudioVisualizer *source);
+    void setFigure(Figure figure);
+    void setTime(qreal seconds);
+    void setBandLevels(const QVector4D &levels);
+    void setSource(Source source);
+    void setShape(Shape shape);
+    void setSampleCount(int count);
+    void setAmplitude(qreal amplitude);
+    void setRadius(qreal radius);
+    void setLineWidth(qreal width);
+    void setGlowWidth(qreal width);
+    void setGlow(qreal glow);
+    void setColor(const QColor &color);
+
+signals:
+    void audioSourceChanged();
+    void figureChanged();
+    void timeChanged();
+    void bandLevelsChanged();
+    void sourceChanged();
+    void shapeChanged();
+    void sampleCountChanged();
+    void amplitudeChanged();
+    void radiusChanged();
+    void lineWidthChanged();
+    void glowWidthChanged();
+    void glowChanged();
+    void colorChanged();
+
+protected:
+    QSGNode *updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *data) override;
+
+private:
+    void updateValues();
+    void simulateFigure();
+    bool simulating() const { return !m_audioSource && m_source == Stereo && m_figure != NoFigure; }
+    void buildCurve();
+
+    QPointer<AudioVisualizer> m_audioSource;
+    QMetaObject::Connection   m_audioConnection;
+
+    Figure    m_figure = NoFigure;
+    qreal     m_time   = 0.0;   // seconds
+    QVector4D m_bandLevels;     // bass, mid, treble, overall; 0..1
+
+    Source m_source      = Waveform;
+    Shape  m_shape       = Linear;
+    int    m_sampleCount = 512;
+    qreal  m_amplitude   = 0.8;    // fraction of the available half extent
+    qreal  m_radius      = 0.5;    // Radial: baseline radius, fraction of half the shorter side
+    qreal  m_lineWidth   = 2.0;    // logical pixels
+    qreal  m_glowWidth   = 6.0;    // logical pixels beyond each edge of the core
+    qreal  m_glow        = 0.5;    // glow intensity, 0 disables it
+    QColor m_color       = QColor(80, 230, 120);
+
+    // Render-thread scratch, touched only inside updatePaintNode()
+    std::vector<float> m_raw;
+    std::vector<float> m_values;   // one per point, two for Stereo
+    std::vector<float> m_points;   // interleaved x, y
+};
@@ -2,6 +2,9 @@
 #include <X11/Xlib.h>
 #include <X11/Xutil.h>
 #include <X11/Xatom.h>
+#include <X11/extensions/XShm.h>
+#include <sys/ipc.h>
+#include <sys/shm.h>
 #include <pulse/simple.h>
 #include <pulse/error.h>
 #include <iostream>
@@ -10,6 +13,7 @@
 #include <chrono>
 #include <atomic>
 #include <cstring>
+#include "src/pixel_convert.h"
 
 class SimpleVisualizerApp {
 private:
@@ -30,11 +34,21 @@ private:
     
     unsigned char* m_imageData;
 
+    // MIT-SHM: m_imageData lives in a segment shared with the X server
+    XShmSegmentInfo m_shmInfo;
+    bool m_useShm;
+    int m_shmCompletionType;
+    bool m_shmPending;
+
+    static bool s_shmAttachFailed;
+
 public:
     SimpleVisualizerApp() : m_display(nullptr), m_window(0), m_gc(nullptr), 
                            m_image(nullptr), m_video(nullptr), m_audio(nullptr), 
                            m_actor(nullptr), m_samplePool(nullptr), m_pulseAudio(nullptr), 
-                           m_running(false), m_imageData(nullptr) {
+                           m_running(false), m_imageData(nullptr),
+                           m_shmInfo{}, m_useShm(false), m_shmCompletionType(0),
+                           m_shmPending(false) {
     }
 
     ~SimpleVisualizerApp() {
@@ -75,12 +89,15 @@ public:
 
         m_gc = XCreateGC(m_display, m_window, 0, nullptr);
 
-        // Create image
+        // Create image — shared with the server when MIT-SHM is available
         int depth = DefaultDepth(m_display, screen);
-        m_imageData = new unsigned char[m_width * m_height * 4];
-        m_image = XCreateImage(m_display, DefaultVisual(m_display, screen),
-                              depth, ZPixmap, 0, (char*)m_imageData,
-                              m_width, m_height, 32, 0);
+        if (!XShmQueryExtension(m_display) || !createSharedImage(DefaultVisual(m_display, screen), depth)) {
+            std::cout << "MIT-SHM unavailable, using XPutImage" << std::endl;
+            m_imageData = new unsigned char[m_width * m_height * 4];
+            m_image = XCreateImage(m_display, DefaultVisual(m_display, screen),
+                                  depth, ZPixmap, 0, (char*)m_imageData,
+                                  m_width, m_height, 32, 0);
+        }
 
         // Initialize libvisual
         if (visual_init(&argc, &argv) != VISUAL_OK) {
@@ -155,7 +172,9 @@ public:
             // Check for X11 events
             while (XPending(m_display)) {
                 XNextEvent(m_display, &event);
-                if (event.type == KeyPress) {
+                if (m_useShm && event.type == m_shmCompletionType) {
+                    m_shmPending = false;
+                } else if (event.type == KeyPress) {
                     m_running = false;
                     break;
                 }
@@ -164,22 +183,19 @@ public:
             // Render visualization
             if (visual_actor_run(m_actor, m_audio) == VISUAL_OK) {
                 unsigned char* videoData = static_cast<unsigned char*>(visual_video_get_pixels(m_video));
-                
-                // Convert RGB to BGRA and copy to image data
-                for (int y = 0; y < m_height; ++y) {
-                    for (int x = 0; x < m_width; ++x) {
-                        int srcIndex = (y * m_width + x) * 3;
-                        int dstIndex = (y * m_width + x) * 4;
-                        
-                        m_imageData[dstIndex + 0] = videoData[srcIndex + 2]; // B
-                        m_imageData[dstIndex + 1] = videoData[srcIndex + 1]; // G
-                        m_imageData[dstIndex + 2] = videoData[srcIndex + 0]; // R
-                        m_imageData[dstIndex + 3] = 255;                     // A
-                    }
-                }
 
-                XPutImage(m_display, m_window, m_gc, m_image, 0, 0, 0, 0, m_width, m_height);
-                XFlush(m_display);
+                // The server may still be reading the previous frame
+                waitForShmCompletion();
+
+                // Convert RGB to BGRA straight into the image
+                FrameDescriptor frame;
+                frame.format = PixelFormat::RGB24;
+                frame.width  = m_width;
+                frame.height = m_height;
+                frame.stride = m_video->pitch;
+                convertFrame(videoData, frame, m_imageData, m_image->bytes_per_line, PixelFormat::BGRA32);
+
+                present();
             }
 
             std::this_thread::sleep_for(std::chrono::milliseconds(16)); // ~60 FPS
@@ -192,6 +208,78 @@ public:
     }
 
 private:
+    static int shmAttachErrorHandler(Display*, XErrorEvent*) {
+        s_shmAttachFailed = true;
+        return 0;
+    }
+
+    static Bool isShmCompletion(Display*, XEvent* event, XPointer arg) {
+        return event->type == *reinterpret_cast<int*>(arg);
+    }
+
+    bool createSharedImage(Visual* visual, int depth) {
+        m_image = XShmCreateImage(m_display, visual, depth, ZPixmap, nullptr,
+                                  &m_shmInfo, m_width, m_height);
+        if (!m_image) {
+            return false;
+        }
+
+        m_shmInfo.shmid = shmget(IPC_PRIVATE, m_image->bytes_per_line * m_image->height,
+                                 IPC_CREAT | 0600);
+        if (m_shmInfo.shmid < 0) {
+            XDestroyImage(m_image);
+            m_image = nullptr;
+            return false;
+        }
+        m_shmInfo.shmaddr = m_image->data = (char*)shmat(m_shmInfo.shmid, nullptr, 0);
+        m_shmInfo.readOnly = False;
+
+        // Attaching fails asynchronously on displays that cannot see the segment
+        bool attached = m_shmInfo.shmaddr != (char*)-1;
+        if (attached) {
+            s_shmAttachFailed = false;
+            XErrorHandler previous = XSetErrorHandler(shmAttachErrorHandler);
+            attached = XShmAttach(m_display, &m_shmInfo);
+            XSync(m_display, False);
+            XSetErrorHandler(previous);
+            attached = attached && !s_shmAttachFailed;
+        }
+        shmctl(m_shmInfo.shmid, IPC_RMID, nullptr);
+
+        if (!attached) {
+            if (m_shmInfo.shmaddr != (char*)-1) {
+                shmdt(m_shmInfo.shmaddr);
+            }
+            m_image->data = nullptr;
+            XDestroyImage(m_image);
+            m_image = nullptr;
+            return false;
+        }
+
+        m_imageData = (unsigned char*)m_shmInfo.shmaddr;
+        m_shmCompletionType = XShmGetEventBase(m_display) + ShmCompletion;
+        m_useShm = true;
+        return true;
+    }
+
+    void waitForShmCompletion() {
+        if (m_shmPending) {
+            XEvent event;
+            XIfEvent(m_display, &event, isShmCompletion, (XPointer)&m_shmCompletionType);
+            m_shmPending = false;
+        }
+    }
+
+    void present() {
+        if (m_useShm) {
+            XShmPutImage(m_display, m_window, m_gc, m_image, 0, 0, 0, 0, m_width, m_height, True);
+            m_shmPending = true;
+        } else {
+            XPutImage(m_display, m_window, m_gc, m_image, 0, 0, 0, 0, m_width, m_height);
+        }
+        XFlush(m_display);
+    }
+
     void audioLoop() {
         std::vector<int16_t> buffer(1024);
         
@@ -240,6 +328,14 @@ private:
 
         visual_quit();
 
+        if (m_useShm) {
+            waitForShmCompletion();
+            XShmDetach(m_display, &m_shmInfo);
+            XSync(m_display, False);
+            shmdt(m_shmInfo.shmaddr);
+            m_imageData = nullptr;
+        }
+
         if (m_image) {
             m_image->data = nullptr;
             XDestroyImage(m_image);
@@ -263,6 +359,8 @@ private:
     }
 };
 
+bool SimpleVisualizerApp::s_shmAttachFailed = false;
+
 int main(int argc, char* argv[]) {
     std::cout << "Simple LibVisual Desktop Background Visualizer" << std::endl;
     std::cout << "Press any key to exit..." << std::endl;
@@ -0,0 +1,264 @@
+#include "activity_monitor.h"
+#include <QDBusConnection>
+#include <QDBusMessage>
+#include <QDBusReply>
+#include <iostream>
+
+// After the Qt headers: Xlib's macros would break them
+#include <X11/Xlib.h>
+#include <X11/Xatom.h>
+#include <X11/extensions/dpms.h>
+
+namespace {
+
+// DPMS has no events; the power level is polled this often
+constexpr int DPMS_POLL_MS = 2000;
+
+const char* const SCREENSAVER_SERVICE   = "org.freedesktop.ScreenSaver";
+const char* const SCREENSAVER_INTERFACE = "org.freedesktop.ScreenSaver";
+
+// Windows we watch (the active window) can be destroyed at any time; the
+// resulting BadWindow errors on our connection are expected
+Display* g_monitorDisplay = nullptr;
+XErrorHandler g_previousErrorHandler = nullptr;
+
+int ignoreWindowErrors(Display* display, XErrorEvent* event) {
+    if (display == g_monitorDisplay && (event->error_code == BadWindow || event->error_code == BadDrawable)) {
+        return 0;
+    }
+    return g_previousErrorHandler ? g_previousErrorHandler(display, event) : 0;
+}
+
+} // namespace
+
+ActivityMonitor::ActivityMonitor(QObject* parent)
+    : QObject(parent), m_display(nullptr), m_root(0), m_notifier(nullptr),
+      m_dpmsTimer(new QTimer(this)), m_activeWindow(0), m_fullscreen(false),
+      m_fullscreenX(0), m_fullscreenY(0), m_fullscreenWidth(0), m_fullscreenHeight(0),
+      m_screenLocked(false), m_dpmsAvailable(false), m_displayOff(false),
+      m_atomActiveWindow(0), m_atomWmState(0), m_atomFullscreen(0) {
+    connect(m_dpmsTimer, &QTimer::timeout, this, &ActivityMonitor::pollDpms);
+}
+
+ActivityMonitor::~ActivityMonitor() {
+    if (m_display) {
+        XSetErrorHandler(g_previousErrorHandler);
+        g_monitorDisplay = nullptr;
+        XCloseDisplay(m_display);
+    }
+}
+
+bool ActivityMonitor::initialize() {
+    m_display = XOpenDisplay(nullptr);
+    if (!m_display) {
+        std::cerr << "Activity monitor: failed to open X11 display" << std::endl;
+        return false;
+    }
+    m_root = DefaultRootWindow(m_display);
+    g_monitorDisplay = m_display;
+    g_previousErrorHandler = XSetErrorHandler(ignoreWindowErrors);
+
+    m_atomActiveWindow = XInternAtom(m_display, "_NET_ACTIVE_WINDOW", False);
+    m_atomWmState      = XInternAtom(m_display, "_NET_WM_STATE", False);
+    m_atomFullscreen   = XInternAtom(m_display, "_NET_WM_STATE_FULLSCREEN", False);
+
+    XSelectInput(m_display, m_root, PropertyChangeMask);
+    trackActiveWindow();
+
+    int eventBase = 0, errorBase = 0;
+    m_dpmsAvailable = DPMSQueryExtension(m_display, &eventBase, &errorBase) && DPMSCapable(m_display);
+    if (m_dpmsAvailable) {
+        m_dpmsTimer->start(DPMS_POLL_MS);
+        pollDpms();
+    }
+
+    // KDE and GNOME lockers emit ActiveChanged on both paths; the state is
+    // idempotent, so listening on both is harmless
+    QDBusConnection bus = QDBusConnection::sessionBus();
+    for (const char* path : {"/ScreenSaver", "/org/freedesktop/ScreenSaver"}) {
+        bus.connect(QString::fromLatin1(SCREENSAVER_SERVICE), QString::fromLatin1(path),
+                    QString::fromLatin1(SCREENSAVER_INTERFACE), QStringLiteral("ActiveChanged"),
+                    this, SLOT(onScreenSaverActiveChanged(bool)));
+    }
+    const QDBusReply<bool> locked = bus.call(
+        QDBusMessage::createMethodCall(QString::fromLatin1(SCREENSAVER_SERVICE),
+                                       QStringLiteral("/org/freedesktop/ScreenSaver"),
+                                       QString::fromLatin1(SCREENSAVER_INTERFACE),
+                                       QStringLiteral("GetActive")),
+        QDBus::Block, 500);
+    if (locked.isValid()) {
+        m_screenLocked = locked.value();
+    }
+
+    m_notifier = new QSocketNotifier(ConnectionNumber(m_display), QSocketNotifier::Read, this);
+    connect(m_notifier, &QSocketNotifier::activated, this, &ActivityMonitor::processEvents);
+
+    std::cout << "Rendering suspends on fullscreen windows, screen lock"
+              << (m_dpmsAvailable ? " and DPMS power-down" : "") << std::endl;
+    processEvents();
+    return true;
+}
+
+int ActivityMonitor::addOutput(const std::string& name, unsigned long window,
+                               int x, int y, int width, int height) {
+    Output output{name, window, x, y, width, height, false, false};
+    m_outputs.push_back(output);
+    if (m_display) {
+        XSelectInput(m_display, window, VisibilityChangeMask);
+        XFlush(m_display);
+    }
+    evaluate();
+    return static_cast<int>(m_outputs.size()) - 1;
+}
+
+bool ActivityMonitor::isSuspended(int output) const {
+    return output >= 0 && output < static_cast<int>(m_outputs.size()) && m_outputs[output].suspended;
+}
+
+void ActivityMonitor::processEvents() {
+    while (XPending(m_display)) {
+        XEvent event;
+        XNextEvent(m_display, &event);
+        switch (event.type) {
+        case VisibilityNotify:
+            for (Output& output : m_outputs) {
+                if (output.window == event.xvisibility.window) {
+                    output.obscured = event.xvisibility.state == VisibilityFullyObscured;
+                }
+            }
+            break;
+        case PropertyNotify:
+            if (event.xproperty.window == m_root && event.xproperty.atom == m_atomActiveWindow) {
+                trackActiveWindow();
+            } else if (event.xproperty.window == m_activeWindow && event.xproperty.atom == m_atomWmState) {
+                updateFullscreen();
+            }
+            break;
+        case ConfigureNotify:
+            if (event.xconfigure.window == m_activeWindow) {
+                updateFullscreen();
+            }
+            break;
+        default:
+            break;
+        }
+    }
+    evaluate();
+}
+
+void ActivityMonitor::pollDpms() {
+    CARD16 level = DPMSModeOn;
+    BOOL enabled = False;
+    if (DPMSInfo(m_display, &level, &enabled)) {
+        m_displayOff = enabled && level != DPMSModeOn;
+    }
+    processEvents();
+}
+
+void ActivityMonitor::onScreenSaverActiveChanged(bool active) {
+    m_screenLocked = active;
+    evaluate();
+}
+
+void ActivityMonitor::trackActiveWindow() {
+    Window active = 0;
+    Atom type;
+    int format;
+    unsigned long count, remaining;
+    unsigned char* data = nullptr;
+    if (XGetWindowProperty(m_display, m_root, m_atomActiveWindow, 0, 1, False, XA_WINDOW,
+                           &type, &format, &count, &remaining, &data) == Success && data) {
+        if (count == 1) {
+            active = *reinterpret_cast<Window*>(data);
+        }
+        XFree(data);
+    }
+
+    if (active != m_activeWindow) {
+        if (m_activeWindow) {
+            XSelectInput(m_display, m_activeWindow, NoEventMask);
+        }
+        m_activeWindow = active;
+        if (m_activeWindow) {
+            // State changes and moves (the window manager reports moves of
+            // the frame with a synthetic ConfigureNotify)
+            XSelectInput(m_display, m_activeWindow, PropertyChangeMask | StructureNotifyMask);
+        }
+    }
+    updateFullscreen();
+}
+
+void ActivityMonitor::updateFullscreen() {
+    m_fullscreen = false;
+    if (!m_activeWindow) {
+        return;
+    }
+
+    Atom type;
+    int format;
+    unsigned long count, remaining;
+    unsigned char* data = nullptr;
+    if (XGetWindowProperty(m_display, m_activeWindow, m_atomWmState, 0, 64, False, XA_ATOM,
+                           &type, &format, &count, &remaining, &data) == Success && data) {
+        // Format-32 properties come back as longs
+        const Atom* states = reinterpret_cast<const Atom*>(data);
+        for (unsigned long i = 0; i < count; ++i) {
+            if (states[i] == m_atomFullscreen) {
+                m_fullscreen = true;
+            }
+        }
+        XFree(data);
+    }
+    if (!m_fullscreen) {
+        return;
+    }
+
+    XWindowAttributes attrs;
+    Window child;
+    int rootX = 0, rootY = 0;
+    if (!XGetWindowAttributes(m_display, m_activeWindow, &attrs) ||
+        !XTranslateCoordinates(m_display, m_activeWindow, m_root, 0, 0, &rootX, &rootY, &child)) {
+        m_fullscreen = false;
+        return;
+    }
+    m_fullscreenX = rootX;
+    m_fullscreenY = rootY;
+    m_fullscreenWidth = attrs.width;
+    m_fullscreenHeight = attrs.height;
+}
+
+void ActivityMonitor::evaluate() {
+    // A fullscreen window belongs to the output holding its centre
+    const int centreX = m_fullscreenX + m_fullscreenWidth / 2;
+    const int centreY = m_fullscreenY + m_fullscreenHeight / 2;
+
+    for (size_t i = 0; i < m_outputs.size(); ++i) {
+        Output& output = m_outputs[i];
+        const bool coveredByFullscreen = m_fullscreen &&
+            centreX >= output.x && centreX < output.x + output.width &&
+            centreY >= output.y && centreY < output.y + output.height;
+
+        const char* reason = nullptr;
+        if (m_displayOff) {
+            reason = "display powered down";
+        } else if (m_screenLocked) {
+            reason = "screen locked";
+        } else if (coveredByFullscreen) {
+            reason = "fullscreen window";
+        } else if (output.obscured) {
+            reason = "window obscured";
+        }
+
+        const bool suspended = reason != nullptr;
+        if (suspended == output.suspended) {
+            continue;
+        }
+        output.suspended = suspended;
+        if (suspended) {
+            std::cout << "Rendering on " << output.name << " suspended: " << reason << std::endl;
+        } else {
+            std::cout << "Rendering on " << output.name << " resumed" << std::endl;
+        }
+        emit suspendedChanged(static_cast<int>(i), suspended);
+    }
+}
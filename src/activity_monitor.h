@@ -0,0 +1,84 @@
+#ifndef ACTIVITY_MONITOR_H
+#define ACTIVITY_MONITOR_H
+
+#include <QObject>
+#include <QTimer>
+#include <QSocketNotifier>
+#include <string>
+#include <vector>
+
+// Xlib's own typedef; the header itself is kept out because its macros
+// clash with Qt
+typedef struct _XDisplay Display;
+
+/**
+ * Tells when nobody can see a background window, so its rendering can be
+ * suspended.
+ *
+ * An output counts as hidden while
+ *  - its window is fully obscured (VisibilityNotify; only reported without
+ *    a compositor),
+ *  - the active window is fullscreen (_NET_WM_STATE_FULLSCREEN) on it,
+ *  - the screen saver / locker is active (org.freedesktop.ScreenSaver
+ *    ActiveChanged on the session bus), or
+ *  - the monitors are powered down (DPMS standby, suspend or off).
+ *
+ * Uses its own display connection, serviced from the Qt event loop.
+ */
+class ActivityMonitor : public QObject {
+    Q_OBJECT
+
+public:
+    explicit ActivityMonitor(QObject* parent = nullptr);
+    ~ActivityMonitor();
+
+    bool initialize();
+
+    // Watches a background window covering the given root-window area.
+    // Returns the output index used by suspendedChanged().
+    int addOutput(const std::string& name, unsigned long window, int x, int y, int width, int height);
+    bool isSuspended(int output) const;
+
+signals:
+    void suspendedChanged(int output, bool suspended);
+
+private slots:
+    void processEvents();
+    void pollDpms();
+    void onScreenSaverActiveChanged(bool active);
+
+private:
+    struct Output {
+        std::string name;
+        unsigned long window;
+        int x, y, width, height;
+        bool obscured;
+        bool suspended;
+    };
+
+    void trackActiveWindow();
+    void updateFullscreen();
+    void evaluate();
+
+    Display* m_display;
+    unsigned long m_root;
+    QSocketNotifier* m_notifier;
+    QTimer* m_dpmsTimer;
+    std::vector<Output> m_outputs;
+
+    unsigned long m_activeWindow;
+    // Root-window area of the active window while it is fullscreen
+    bool m_fullscreen;
+    int m_fullscreenX, m_fullscreenY, m_fullscreenWidth, m_fullscreenHeight;
+
+    bool m_screenLocked;
+    bool m_dpmsAvailable;
+    bool m_displayOff;
+
+    // Interned atoms
+    unsigned long m_atomActiveWindow;
+    unsigned long m_atomWmState;
+    unsigned long m_atomFullscreen;
+};
+
+#endif // ACTIVITY_MONITOR_H
@@ -3,7 +3,7 @@
 #include <cstring>
 #include <algorithm>
 
-AudioInput::AudioInput() : m_pulseAudio(nullptr), m_running(false), m_shouldStop(false) {
+AudioInput::AudioInput() : m_pulseAudio(nullptr), m_running(false), m_shouldStop(false), m_latencyUs(0) {
 }
 
 AudioInput::~AudioInput() {
@@ -14,6 +14,34 @@ AudioInput::~AudioInput() {
 }
 
 bool AudioInput::initialize(const std::string& device) {
+    std::lock_guard<std::mutex> lock(m_controlMutex);
+    m_pulseAudio = openStream(device);
+    return m_pulseAudio != nullptr;
+}
+
+bool AudioInput::switchDevice(const std::string& device) {
+    std::lock_guard<std::mutex> lock(m_controlMutex);
+    // Opened first, so a device that fails leaves the old capture running
+    pa_simple* stream = openStream(device);
+    if (!stream) {
+        return false;
+    }
+
+    const bool wasRunning = m_running;
+    stopThread();
+    if (m_pulseAudio) {
+        pa_simple_free(m_pulseAudio);
+    }
+    m_pulseAudio = stream;
+    if (wasRunning) {
+        m_shouldStop = false;
+        m_running = true;
+        m_audioThread = std::thread(&AudioInput::audioThread, this);
+    }
+    return true;
+}
+
+pa_simple* AudioInput::openStream(const std::string& device) const {
     pa_sample_spec ss;
     ss.format = PA_SAMPLE_S16LE;
     ss.channels = CHANNELS;
@@ -29,7 +57,7 @@ bool AudioInput::initialize(const std::string& device) {
     int error;
     const char* deviceName = (device == "default") ? nullptr : device.c_str();
     
-    m_pulseAudio = pa_simple_new(
+    pa_simple* stream = pa_simple_new(
         nullptr,                    // server
         "libvisual-bg",             // application name
         PA_STREAM_RECORD,           // direction
@@ -41,15 +69,14 @@ bool AudioInput::initialize(const std::string& device) {
         &error                      // error code
     );
 
-    if (!m_pulseAudio) {
+    if (!stream) {
         std::cerr << "Failed to create PulseAudio connection: " << pa_strerror(error) << std::endl;
-        return false;
     }
-
-    return true;
+    return stream;
 }
 
 void AudioInput::start() {
+    std::lock_guard<std::mutex> lock(m_controlMutex);
     if (m_running || !m_pulseAudio) {
         return;
     }
@@ -60,6 +87,11 @@ void AudioInput::start() {
 }
 
 void AudioInput::stop() {
+    std::lock_guard<std::mutex> lock(m_controlMutex);
+    stopThread();
+}
+
+void AudioInput::stopThread() {
     if (!m_running) {
         return;
     }
@@ -96,6 +128,10 @@ void AudioInput::audioThread() {
             std::cerr << "Failed to read audio data: " << pa_strerror(error) << std::endl;
             break;
         }
+        const pa_usec_t latency = pa_simple_get_latency(m_pulseAudio, &error);
+        if (latency != static_cast<pa_usec_t>(-1)) {
+            m_latencyUs = latency + BUFFER_SIZE * 1000000ULL / SAMPLE_RATE;
+        }
 
         // Convert to float and call callback
         convertToFloat(buffer.data(), floatBuffer.data(), buffer.size());
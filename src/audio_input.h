@@ -5,8 +5,10 @@
 #include <pulse/error.h>
 #include <thread>
 #include <atomic>
+#include <cstdint>
 #include <vector>
 #include <functional>
+#include <mutex>
 #include <string>
 
 class AudioInput {
@@ -19,6 +21,15 @@ public:
     void stop();
     bool isRunning() const;
 
+    // Replaces the capture stream with one on another device, restarting
+    // the capture if it was running.  Safe against a concurrent start/stop.
+    bool switchDevice(const std::string& device);
+
+    // Age of the newest samples when they reach the callback: PulseAudio's
+    // capture latency plus the hop each read waits to fill.  Measured after
+    // every read; 0 before the first.
+    double latencyMs() const { return m_latencyUs / 1000.0; }
+
     // Set callback for audio data
     void setAudioCallback(std::function<void(const float*, size_t)> callback);
 
@@ -26,13 +37,21 @@ public:
     std::vector<std::string> getAvailableDevices();
 
 private:
+    // A new capture stream on device, or nullptr (reported on stderr)
+    pa_simple* openStream(const std::string& device) const;
+    // Expects m_controlMutex held
+    void stopThread();
+
     void audioThread();
     void convertToFloat(const int16_t* input, float* output, size_t samples);
 
     pa_simple* m_pulseAudio;
     std::thread m_audioThread;
+    // start/stop/switchDevice may come from different GUI handlers
+    std::mutex m_controlMutex;
     std::atomic<bool> m_running;
     std::atomic<bool> m_shouldStop;
+    std::atomic<uint64_t> m_latencyUs;
     
     std::function<void(const float*, size_t)> m_audioCallback;
     
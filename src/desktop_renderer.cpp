@@ -1,21 +1,244 @@
 #include "desktop_renderer.h"
+#include "frame_hash.h"
+#include "pixel_convert.h"
+#include <algorithm>
 #include <iostream>
 #include <cstring>
 #include <cstdlib>
+#include <cstdint>
+#include <sys/ipc.h>
+#include <sys/shm.h>
+
+namespace {
+
+// Client-side format/type that reads each engine pixel layout byte for byte,
+// so the driver copies rows as they are.  BGR layouts land with red and blue
+// exchanged; the presentation shader swaps them back.
+struct UploadFormat {
+    GLenum format;
+    GLenum type;
+    bool swapRedBlue;
+};
+
+UploadFormat uploadFormatFor(PixelFormat format) {
+    switch (format) {
+    case PixelFormat::RGB24:  return {GL_RGB,  GL_UNSIGNED_BYTE, false};
+    case PixelFormat::BGR24:  return {GL_RGB,  GL_UNSIGNED_BYTE, true};
+    case PixelFormat::RGBA32: return {GL_RGBA, GL_UNSIGNED_BYTE, false};
+    case PixelFormat::BGRA32: return {GL_RGBA, GL_UNSIGNED_BYTE, true};
+    // Indices go to the red channel (luminance before GL 3); the palette
+    // they pick from holds BGRA32 words
+    case PixelFormat::Indexed8: return {GL_RED, GL_UNSIGNED_BYTE, true};
+    }
+    return {GL_RGB, GL_UNSIGNED_BYTE, false};
+}
+
+// Expresses the frame stride through the unpack state.  Returns false when
+// neither a row length nor an alignment describes it.
+bool setUnpackLayout(const FrameDescriptor& frame) {
+    const int bpp = frame.bytesPerPixel();
+    if (frame.stride % bpp == 0) {
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, frame.stride / bpp);
+        return true;
+    }
+    const int packed = frame.width * bpp;
+    for (int alignment : {2, 4, 8}) {
+        if ((packed + alignment - 1) / alignment * alignment == frame.stride) {
+            glPixelStorei(GL_UNPACK_ALIGNMENT, alignment);
+            glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Rectangles covering the tiles whose hashes differ, one per run of
+// neighbouring dirty tiles in a tile row
+void dirtyRegions(const TileHashes& before, const TileHashes& after, int width, int height,
+                  std::vector<UploadRect>& regions) {
+    const int size = TileHashes::TILE_SIZE;
+    for (int row = 0; row < after.rows; ++row) {
+        const uint64_t* old = &before.tiles[static_cast<size_t>(row) * after.columns];
+        const uint64_t* now = &after.tiles[static_cast<size_t>(row) * after.columns];
+        for (int column = 0; column < after.columns; ++column) {
+            if (old[column] == now[column]) {
+                continue;
+            }
+            const int first = column;
+            while (column + 1 < after.columns && old[column + 1] != now[column + 1]) {
+                ++column;
+            }
+            const int x = first * size;
+            const int y = row * size;
+            regions.push_back({x, y, std::min((column + 1) * size, width) - x, std::min(size, height - y)});
+        }
+    }
+}
+
+// XShmAttach fails asynchronously (BadAccess on displays that cannot see our
+// segment); a temporary handler turns that error into a flag
+bool g_shmAttachFailed = false;
+
+int shmAttachErrorHandler(Display*, XErrorEvent*) {
+    g_shmAttachFailed = true;
+    return 0;
+}
+
+// glXCreateContextAttribsARB reports unsupported versions and profiles as
+// X errors (BadMatch, GLXBadFBConfig); this turns them into a flag as well
+bool g_contextCreateFailed = false;
+
+int contextErrorHandler(Display*, XErrorEvent*) {
+    g_contextCreateFailed = true;
+    return 0;
+}
+
+// Core-profile versions to ask for, newest first.  3.3 is what projectM's
+// GLSL pipeline needs; llvmpipe and every current driver offer it.
+constexpr int CORE_VERSIONS[][2] = {{3, 3}, {3, 2}};
+
+int isShmCompletion(Display*, XEvent* event, XPointer arg) {
+    return event->type == *reinterpret_cast<int*>(arg);
+}
+
+// Refresh rate of a mode, 0 when it is not in resources
+double modeRefreshRate(const XRRScreenResources* resources, RRMode mode) {
+    for (int i = 0; i < resources->nmode; ++i) {
+        const XRRModeInfo& info = resources->modes[i];
+        if (info.id != mode || !info.hTotal || !info.vTotal) {
+            continue;
+        }
+        double lines = info.vTotal;
+        if (info.modeFlags & RR_DoubleScan) lines *= 2.0;
+        if (info.modeFlags & RR_Interlace)  lines /= 2.0;
+        return static_cast<double>(info.dotClock) / (info.hTotal * lines);
+    }
+    return 0.0;
+}
+
+// Refresh rate of the CRTC driving the primary output, or of the first
+// active CRTC when no output is marked primary
+double detectRefreshRate(Display* display, Window root) {
+    int eventBase = 0, errorBase = 0;
+    if (!XRRQueryExtension(display, &eventBase, &errorBase)) {
+        return 0.0;
+    }
+    XRRScreenResources* resources = XRRGetScreenResourcesCurrent(display, root);
+    if (!resources) {
+        return 0.0;
+    }
+
+    RRMode mode = 0;
+    const RROutput primary = XRRGetOutputPrimary(display, root);
+    XRROutputInfo* output = primary ? XRRGetOutputInfo(display, resources, primary) : nullptr;
+    if (output) {
+        if (output->crtc) {
+            if (XRRCrtcInfo* crtc = XRRGetCrtcInfo(display, resources, output->crtc)) {
+                mode = crtc->mode;
+                XRRFreeCrtcInfo(crtc);
+            }
+        }
+        XRRFreeOutputInfo(output);
+    }
+    for (int i = 0; i < resources->ncrtc && !mode; ++i) {
+        if (XRRCrtcInfo* crtc = XRRGetCrtcInfo(display, resources, resources->crtcs[i])) {
+            mode = crtc->mode;
+            XRRFreeCrtcInfo(crtc);
+        }
+    }
+
+    const double rate = modeRefreshRate(resources, mode);
+    XRRFreeScreenResources(resources);
+    return rate;
+}
+
+// Two frames can be cross-faded only when the shader reads both textures
+// the same way: same pixel format (indices or colour), row order, size and
+// alpha handling
+bool blendable(const FrameDescriptor& previous, const FrameDescriptor& latest) {
+    return previous.format == latest.format && previous.origin == latest.origin &&
+           previous.width == latest.width && previous.height == latest.height &&
+           previous.alpha == latest.alpha;
+}
+
+} // namespace
 
 DesktopRenderer::DesktopRenderer()
     : m_display(nullptr), m_rootWindow(0), m_backgroundWindow(0),
-      m_gc(nullptr), m_image(nullptr), m_visualInfo(nullptr),
-      m_screenWidth(0), m_screenHeight(0), m_screen(0),
-      m_imageData(nullptr), m_initialized(false),
-      m_glContext(nullptr), m_texture(0), m_glInitialized(false) {
+      m_gc(nullptr), m_image(nullptr), m_visualInfo(nullptr), m_fbConfig(nullptr),
+      m_originX(0), m_originY(0), m_screenWidth(0), m_screenHeight(0), m_screen(0),
+      m_imageData(nullptr), m_initialized(false), m_headless(false),
+      m_shmInfo{}, m_useShm(false), m_shmCompletionType(0), m_shmPending(false),
+      m_glContext(nullptr), m_gamma(1.0f), m_glInitialized(false),
+      m_headlessFramebuffer(0), m_headlessColorBuffer(0), m_refreshRate(0.0),
+      m_overlayVisible(false),
+      m_latestTexture(0), m_hasPreviousFrame(false),
+      m_uploadBuffers{}, m_uploadFences{}, m_uploadPointers{},
+      m_uploadBytes(0), m_uploadSlot(0), m_persistentUpload(false), m_redTextures(true),
+      m_scaleFilter(ScaleFilter::Bilinear),
+      m_stageStats(nullptr), m_checksumOutput(false), m_outputChecksum(0) {
 }
 
 DesktopRenderer::~DesktopRenderer() {
     shutdown();
 }
 
-bool DesktopRenderer::initialize() {
+std::vector<MonitorInfo> DesktopRenderer::enumerateMonitors() {
+    std::vector<MonitorInfo> monitors;
+    Display* display = XOpenDisplay(nullptr);
+    if (!display) {
+        return monitors;
+    }
+
+    const Window root = DefaultRootWindow(display);
+    int eventBase = 0, errorBase = 0;
+    XRRScreenResources* resources = XRRQueryExtension(display, &eventBase, &errorBase)
+        ? XRRGetScreenResourcesCurrent(display, root) : nullptr;
+    if (!resources) {
+        XCloseDisplay(display);
+        return monitors;
+    }
+
+    const RROutput primary = XRRGetOutputPrimary(display, root);
+    std::vector<RRCrtc> seen;
+    for (int i = 0; i < resources->noutput; ++i) {
+        XRROutputInfo* output = XRRGetOutputInfo(display, resources, resources->outputs[i]);
+        if (!output) {
+            continue;
+        }
+        // Clones share a CRTC; the first output found speaks for it
+        const bool mirrored = std::find(seen.begin(), seen.end(), output->crtc) != seen.end();
+        if (output->connection == RR_Connected && output->crtc && !mirrored) {
+            if (XRRCrtcInfo* crtc = XRRGetCrtcInfo(display, resources, output->crtc)) {
+                if (crtc->mode && crtc->width > 0 && crtc->height > 0) {
+                    MonitorInfo monitor;
+                    monitor.name = std::string(output->name, output->nameLen);
+                    monitor.x = crtc->x;
+                    monitor.y = crtc->y;
+                    monitor.width = static_cast<int>(crtc->width);
+                    monitor.height = static_cast<int>(crtc->height);
+                    monitor.refreshRate = modeRefreshRate(resources, crtc->mode);
+                    monitor.primary = resources->outputs[i] == primary;
+                    monitors.push_back(monitor);
+                    seen.push_back(output->crtc);
+                }
+                XRRFreeCrtcInfo(crtc);
+            }
+        }
+        XRRFreeOutputInfo(output);
+    }
+    XRRFreeScreenResources(resources);
+    XCloseDisplay(display);
+
+    std::stable_sort(monitors.begin(), monitors.end(), [](const MonitorInfo& a, const MonitorInfo& b) {
+        if (a.primary != b.primary) return a.primary;
+        return a.x != b.x ? a.x < b.x : a.y < b.y;
+    });
+    return monitors;
+}
+
+bool DesktopRenderer::initialize(const MonitorInfo* monitor) {
     m_display = XOpenDisplay(nullptr);
     if (!m_display) {
         std::cerr << "Failed to open X11 display" << std::endl;
@@ -24,13 +247,32 @@ bool DesktopRenderer::initialize() {
 
     m_screen = DefaultScreen(m_display);
     m_rootWindow = RootWindow(m_display, m_screen);
-    m_screenWidth = DisplayWidth(m_display, m_screen);
-    m_screenHeight = DisplayHeight(m_display, m_screen);
+    if (monitor) {
+        m_originX = monitor->x;
+        m_originY = monitor->y;
+        m_screenWidth = monitor->width;
+        m_screenHeight = monitor->height;
+    } else {
+        m_screenWidth = DisplayWidth(m_display, m_screen);
+        m_screenHeight = DisplayHeight(m_display, m_screen);
+    }
 
     if (!createBackgroundWindow()) {
         return false;
     }
 
+    m_refreshRate = monitor ? monitor->refreshRate : detectRefreshRate(m_display, m_rootWindow);
+    if (monitor) {
+        std::cout << "Monitor " << monitor->name << ": " << m_screenWidth << "x" << m_screenHeight
+                  << "+" << m_originX << "+" << m_originY;
+        if (m_refreshRate > 0.0) {
+            std::cout << " at " << m_refreshRate << " Hz";
+        }
+        std::cout << std::endl;
+    } else if (m_refreshRate > 0.0) {
+        std::cout << "Display refresh rate: " << m_refreshRate << " Hz" << std::endl;
+    }
+
     // Try to initialize OpenGL — fall back to software path if unavailable
     if (!initializeGL()) {
         std::cerr << "GLX unavailable, falling back to software rendering" << std::endl;
@@ -41,15 +283,14 @@ bool DesktopRenderer::initialize() {
             return false;
         }
 
-        int depth = DefaultDepth(m_display, m_screen);
-        m_imageData = new unsigned char[m_screenWidth * m_screenHeight * 4];
-        m_image = XCreateImage(m_display, DefaultVisual(m_display, m_screen),
-                               depth, ZPixmap, 0, (char*)m_imageData,
-                               m_screenWidth, m_screenHeight, 32, 0);
-        if (!m_image) {
-            std::cerr << "Failed to create XImage" << std::endl;
+        if (!createSoftwareImage()) {
             return false;
         }
+        m_workers = std::make_unique<WorkerPool>();
+        m_scaler = std::make_unique<FrameScaler>(*m_workers);
+        m_scaler->setFilter(m_scaleFilter);
+        std::cout << "Pixel conversion: " << pixelConversionIsa()
+                  << ", scaling on " << m_workers->size() << " threads" << std::endl;
     }
 
     m_initialized = true;
@@ -57,9 +298,33 @@ bool DesktopRenderer::initialize() {
 }
 
 bool DesktopRenderer::createBackgroundWindow() {
-    // Prefer a GLX-capable visual; fall back to the default visual if GLX is absent
-    int glAttribs[] = { GLX_RGBA, GLX_DEPTH_SIZE, 24, GLX_DOUBLEBUFFER, 0 }; // 0 == X11 None
-    m_visualInfo = glXChooseVisual(m_display, m_screen, glAttribs);
+    // Prefer a GLX-capable visual, from a framebuffer config so that a
+    // core-profile context can be created for it; fall back to the default
+    // visual if GLX is absent
+    const int configAttribs[] = {
+        GLX_X_RENDERABLE, True,
+        GLX_DRAWABLE_TYPE, GLX_WINDOW_BIT,
+        GLX_RENDER_TYPE, GLX_RGBA_BIT,
+        GLX_RED_SIZE, 8, GLX_GREEN_SIZE, 8, GLX_BLUE_SIZE, 8,
+        GLX_DEPTH_SIZE, 24,
+        GLX_DOUBLEBUFFER, True,
+        0  // 0 == X11 None
+    };
+    int configCount = 0;
+    GLXFBConfig* configs = glXChooseFBConfig(m_display, m_screen, configAttribs, &configCount);
+    for (int i = 0; configs && i < configCount && !m_visualInfo; ++i) {
+        m_visualInfo = glXGetVisualFromFBConfig(m_display, configs[i]);
+        if (m_visualInfo) {
+            m_fbConfig = configs[i];
+        }
+    }
+    if (configs) {
+        XFree(configs);
+    }
+    if (!m_visualInfo) {
+        int glAttribs[] = { GLX_RGBA, GLX_DEPTH_SIZE, 24, GLX_DOUBLEBUFFER, 0 };
+        m_visualInfo = glXChooseVisual(m_display, m_screen, glAttribs);
+    }
 
     Visual* visual = m_visualInfo ? m_visualInfo->visual : DefaultVisual(m_display, m_screen);
     int depth       = m_visualInfo ? m_visualInfo->depth : DefaultDepth(m_display, m_screen);
@@ -76,7 +341,7 @@ bool DesktopRenderer::createBackgroundWindow() {
 
     m_backgroundWindow = XCreateWindow(
         m_display, m_rootWindow,
-        0, 0, m_screenWidth, m_screenHeight, 0,
+        m_originX, m_originY, m_screenWidth, m_screenHeight, 0,
         depth, InputOutput, visual, mask, &attrs);
 
     XFreeColormap(m_display, cmap);
@@ -101,10 +366,37 @@ bool DesktopRenderer::createBackgroundWindow() {
     return true;
 }
 
+GLXContext DesktopRenderer::createContext() {
+    if (m_fbConfig && m_glx.hasCreateContext()) {
+        for (const auto& version : CORE_VERSIONS) {
+            const int attribs[] = {
+                GLX_CONTEXT_MAJOR_VERSION_ARB, version[0],
+                GLX_CONTEXT_MINOR_VERSION_ARB, version[1],
+                GLX_CONTEXT_PROFILE_MASK_ARB, GLX_CONTEXT_CORE_PROFILE_BIT_ARB,
+                0  // 0 == X11 None
+            };
+            g_contextCreateFailed = false;
+            XErrorHandler previous = XSetErrorHandler(contextErrorHandler);
+            GLXContext context = m_glx.CreateContextAttribsARB(m_display, m_fbConfig, nullptr, True, attribs);
+            XSync(m_display, False);
+            XSetErrorHandler(previous);
+            if (context && !g_contextCreateFailed) {
+                return context;
+            }
+            if (context) {
+                glXDestroyContext(m_display, context);
+            }
+        }
+        std::cerr << "No core-profile GL context, trying a legacy one" << std::endl;
+    }
+    return glXCreateContext(m_display, m_visualInfo, nullptr, GL_TRUE);
+}
+
 bool DesktopRenderer::initializeGL() {
     if (!m_visualInfo) return false;
 
-    m_glContext = glXCreateContext(m_display, m_visualInfo, nullptr, GL_TRUE);
+    m_glx.load(m_display, m_screen);
+    m_glContext = createContext();
     if (!m_glContext) {
         std::cerr << "Failed to create GLX context" << std::endl;
         return false;
@@ -117,28 +409,194 @@ bool DesktopRenderer::initializeGL() {
         return false;
     }
 
-    glEnable(GL_TEXTURE_2D);
-    glGenTextures(1, &m_texture);
-    glBindTexture(GL_TEXTURE_2D, m_texture);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-
-    glViewport(0, 0, m_screenWidth, m_screenHeight);
-    glMatrixMode(GL_PROJECTION);
-    glLoadIdentity();
-    glOrtho(0, 1, 0, 1, -1, 1);
-    glMatrixMode(GL_MODELVIEW);
-    glLoadIdentity();
+    if (!initializeGLState()) {
+        glXMakeCurrent(m_display, 0, nullptr);
+        glXDestroyContext(m_display, m_glContext);
+        m_glContext = nullptr;
+        return false;
+    }
 
     m_glInitialized = true;
-    std::cout << "GLX context created — hardware-accelerated rendering enabled" << std::endl;
+    std::cout << "GLX context created — hardware-accelerated rendering enabled (OpenGL "
+              << m_gl.majorVersion << "." << m_gl.minorVersion
+              << (m_gl.coreProfile ? " core profile" : "") << ", "
+              << reinterpret_cast<const char*>(glGetString(GL_RENDERER)) << ")" << std::endl;
+    std::cout << "Frame upload: "
+              << (m_persistentUpload        ? "persistently mapped buffer ring"
+                  : m_gl.hasPixelBuffers()  ? "pixel buffer object ring"
+                                            : "direct glTexSubImage2D")
+              << (m_gl.hasTextureStorage() ? ", immutable texture storage" : "")
+              << std::endl;
     return true;
 }
 
-void DesktopRenderer::shutdown() {
-    shutdownGL();
+bool DesktopRenderer::initializeGLState() {
+    if (!m_gl.load()) {
+        std::cerr << "Failed to query the OpenGL version" << std::endl;
+    }
+    m_persistentUpload = m_gl.hasPersistentMapping();
+    m_redTextures = m_gl.hasVersion(3, 0) || m_gl.hasExtension("GL_ARB_texture_rg");
+
+    m_presenter = std::make_unique<PresentShader>(m_gl);
+    if (!m_presenter->create()) {
+        std::cerr << "OpenGL " << m_gl.majorVersion << "." << m_gl.minorVersion
+                  << " cannot run the presentation shader" << std::endl;
+        m_presenter.reset();
+        return false;
+    }
+    // Built now so showing it later costs nothing; frames go on without it
+    m_overlay = std::make_unique<PerfOverlay>(m_gl);
+    if (!m_overlay->create()) {
+        std::cerr << "Performance overlay unavailable" << std::endl;
+        m_overlay.reset();
+    }
+    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+    return true;
+}
+
+bool DesktopRenderer::initializeHeadless(int width, int height) {
+    m_headless = true;
+    m_screenWidth = width;
+    m_screenHeight = height;
+
+    m_headlessContext = std::make_unique<HeadlessContext>();
+    if (m_headlessContext->create() && m_headlessContext->makeCurrent()) {
+        if (initializeGLState() && createHeadlessFramebuffer()) {
+            m_glInitialized = true;
+            m_initialized = true;
+            std::cout << "Headless OpenGL " << m_gl.majorVersion << "." << m_gl.minorVersion
+                      << (m_gl.coreProfile ? " core profile" : "") << " ("
+                      << reinterpret_cast<const char*>(glGetString(GL_RENDERER)) << "), "
+                      << width << "x" << height << " offscreen framebuffer" << std::endl;
+            return true;
+        }
+        if (m_presenter) {
+            m_presenter->destroy();
+            m_presenter.reset();
+        }
+        if (m_overlay) {
+            m_overlay->destroy();
+            m_overlay.reset();
+        }
+    }
+    m_headlessContext.reset();
+
+    // Software path with the image in plain memory
+    std::cout << "Headless software rendering, " << width << "x" << height << std::endl;
+    m_imageData = new unsigned char[static_cast<size_t>(width) * height * 4];
+    m_workers = std::make_unique<WorkerPool>();
+    m_scaler = std::make_unique<FrameScaler>(*m_workers);
+    m_scaler->setFilter(m_scaleFilter);
+    m_initialized = true;
+    return true;
+}
+
+// The headless context has no window; an RGBA8 renderbuffer of the output
+// size takes its place
+bool DesktopRenderer::createHeadlessFramebuffer() {
+    if (!m_gl.hasFramebufferObjects()) {
+        std::cerr << "OpenGL without framebuffer objects cannot render headless" << std::endl;
+        return false;
+    }
+    m_gl.GenRenderbuffers(1, &m_headlessColorBuffer);
+    m_gl.BindRenderbuffer(GL_RENDERBUFFER, m_headlessColorBuffer);
+    m_gl.RenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, m_screenWidth, m_screenHeight);
+    m_gl.GenFramebuffers(1, &m_headlessFramebuffer);
+    m_gl.BindFramebuffer(GL_FRAMEBUFFER, m_headlessFramebuffer);
+    m_gl.FramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_headlessColorBuffer);
+    if (m_gl.CheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        std::cerr << "Incomplete " << m_screenWidth << "x" << m_screenHeight
+                  << " headless framebuffer" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool DesktopRenderer::createSoftwareImage() {
+    Visual* visual = DefaultVisual(m_display, m_screen);
+    int depth = DefaultDepth(m_display, m_screen);
+
+    if (XShmQueryExtension(m_display) && createSharedImage(visual, depth)) {
+        std::cout << "Software presentation: MIT-SHM shared image" << std::endl;
+        return true;
+    }
+
+    std::cout << "Software presentation: XPutImage (MIT-SHM unavailable)" << std::endl;
+    m_imageData = new unsigned char[m_screenWidth * m_screenHeight * 4];
+    m_image = XCreateImage(m_display, visual,
+                           depth, ZPixmap, 0, (char*)m_imageData,
+                           m_screenWidth, m_screenHeight, 32, 0);
+    if (!m_image) {
+        std::cerr << "Failed to create XImage" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool DesktopRenderer::createSharedImage(Visual* visual, int depth) {
+    m_image = XShmCreateImage(m_display, visual, depth, ZPixmap, nullptr,
+                              &m_shmInfo, m_screenWidth, m_screenHeight);
+    if (!m_image) {
+        return false;
+    }
+
+    m_shmInfo.shmid = shmget(IPC_PRIVATE, static_cast<size_t>(m_image->bytes_per_line) * m_image->height,
+                             IPC_CREAT | 0600);
+    if (m_shmInfo.shmid < 0) {
+        XDestroyImage(m_image);
+        m_image = nullptr;
+        return false;
+    }
+    m_shmInfo.shmaddr = m_image->data = static_cast<char*>(shmat(m_shmInfo.shmid, nullptr, 0));
+    m_shmInfo.readOnly = False;
+
+    bool attached = m_shmInfo.shmaddr != reinterpret_cast<char*>(-1);
+    if (attached) {
+        g_shmAttachFailed = false;
+        XErrorHandler previous = XSetErrorHandler(shmAttachErrorHandler);
+        attached = XShmAttach(m_display, &m_shmInfo);
+        XSync(m_display, False);
+        XSetErrorHandler(previous);
+        attached = attached && !g_shmAttachFailed;
+    }
+    // Both sides hold the segment now (or never will); mark it for removal
+    // so it is freed even if we crash
+    shmctl(m_shmInfo.shmid, IPC_RMID, nullptr);
+
+    if (!attached) {
+        std::cerr << "XShmAttach failed, falling back to XPutImage" << std::endl;
+        if (m_shmInfo.shmaddr != reinterpret_cast<char*>(-1)) {
+            shmdt(m_shmInfo.shmaddr);
+        }
+        m_image->data = nullptr;
+        XDestroyImage(m_image);
+        m_image = nullptr;
+        m_shmInfo = {};
+        return false;
+    }
+
+    m_imageData = reinterpret_cast<unsigned char*>(m_shmInfo.shmaddr);
+    m_shmCompletionType = XShmGetEventBase(m_display) + ShmCompletion;
+    m_useShm = true;
+    return true;
+}
+
+void DesktopRenderer::destroySoftwareImage() {
+    if (m_useShm) {
+        waitForShmCompletion();
+        XShmDetach(m_display, &m_shmInfo);
+        XSync(m_display, False);
+        if (m_image) {
+            m_image->data = nullptr;
+            XDestroyImage(m_image);
+            m_image = nullptr;
+        }
+        shmdt(m_shmInfo.shmaddr);
+        m_shmInfo = {};
+        m_imageData = nullptr;
+        m_useShm = false;
+        return;
+    }
 
     if (m_image) {
         m_image->data = nullptr;
@@ -149,6 +607,28 @@ void DesktopRenderer::shutdown() {
         delete[] m_imageData;
         m_imageData = nullptr;
     }
+}
+
+// The server reads the shared segment asynchronously after XShmPutImage
+// returns; the next frame may only be written once it reports completion.
+// Blocking here also paces the software path to what the server can draw.
+void DesktopRenderer::waitForShmCompletion() {
+    if (!m_shmPending) {
+        return;
+    }
+    XEvent event;
+    XIfEvent(m_display, &event, isShmCompletion, reinterpret_cast<XPointer>(&m_shmCompletionType));
+    m_shmPending = false;
+}
+
+void DesktopRenderer::shutdown() {
+    shutdownGL();
+
+    m_scaler.reset();
+    m_workers.reset();
+    if (m_display || m_headless) {
+        destroySoftwareImage();
+    }
     if (m_gc) {
         XFreeGC(m_display, m_gc);
         m_gc = nullptr;
@@ -165,16 +645,44 @@ void DesktopRenderer::shutdown() {
         m_display = nullptr;
     }
 
+    m_headless = false;
     m_initialized = false;
 }
 
 void DesktopRenderer::shutdownGL() {
     if (!m_glInitialized) return;
 
-    if (m_texture) {
-        glDeleteTextures(1, &m_texture);
-        m_texture = 0;
+    makeCurrent();
+    destroyUploadRing();
+    if (m_presenter) {
+        m_presenter->destroy();
+        m_presenter.reset();
     }
+    if (m_overlay) {
+        m_overlay->destroy();
+        m_overlay.reset();
+    }
+    for (FrameTexture& slot : m_frameTextures) {
+        if (slot.texture) {
+            glDeleteTextures(1, &slot.texture);
+        }
+        if (slot.palette) {
+            glDeleteTextures(1, &slot.palette);
+        }
+        slot = FrameTexture();
+    }
+    m_latestTexture = 0;
+    m_hasPreviousFrame = false;
+    if (m_headlessFramebuffer) {
+        m_gl.BindFramebuffer(GL_FRAMEBUFFER, 0);
+        m_gl.DeleteFramebuffers(1, &m_headlessFramebuffer);
+        m_headlessFramebuffer = 0;
+    }
+    if (m_headlessColorBuffer) {
+        m_gl.DeleteRenderbuffers(1, &m_headlessColorBuffer);
+        m_headlessColorBuffer = 0;
+    }
+    m_headlessContext.reset();
     if (m_glContext) {
         glXMakeCurrent(m_display, 0, nullptr); // 0 == X11 None (undefed to avoid Qt conflict)
         glXDestroyContext(m_display, m_glContext);
@@ -183,57 +691,443 @@ void DesktopRenderer::shutdownGL() {
     m_glInitialized = false;
 }
 
-bool DesktopRenderer::renderFrame(const unsigned char* data, int width, int height) {
-    if (!m_initialized || !data) return false;
+bool DesktopRenderer::acceptsFrame(const unsigned char* data, const FrameDescriptor& frame) const {
+    if (!m_initialized || !data || frame.width <= 0 || frame.height <= 0) return false;
+    if (frame.stride < frame.width * frame.bytesPerPixel()) {
+        std::cerr << "Frame stride " << frame.stride << " too small for width " << frame.width << std::endl;
+        return false;
+    }
+    if (frame.format == PixelFormat::Indexed8 && !frame.palette) {
+        std::cerr << "Indexed frame without a palette" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool DesktopRenderer::renderFrame(const unsigned char* data, const FrameDescriptor& frame,
+                                  const TileHashes* tiles) {
+    if (!acceptsFrame(data, frame)) return false;
 
     if (m_glInitialized) {
-        return renderFrameGL(data, width, height);
+        return renderFrameGL(data, frame, tiles);
+    }
+    return renderFrameSW(data, frame);
+}
+
+// (Re)allocates a frame texture when the engine's frame size changes.
+// Storage is immutable where supported, so the driver never has to
+// re-validate or reallocate it on upload.
+bool DesktopRenderer::ensureTexture(FrameTexture& slot, int width, int height, GLenum internalFormat) {
+    if (slot.texture && width == slot.width && height == slot.height && internalFormat == slot.internalFormat) {
+        return true;
+    }
+
+    if (slot.texture) {
+        glDeleteTextures(1, &slot.texture);
+        slot.texture = 0;
+    }
+    glGenTextures(1, &slot.texture);
+    glBindTexture(GL_TEXTURE_2D, slot.texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+
+    if (m_gl.hasTextureStorage()) {
+        m_gl.TexStorage2D(GL_TEXTURE_2D, 1, internalFormat, width, height);
+    } else {
+        const GLenum format = internalFormat == GL_RGBA8 ? GL_RGBA
+                            : internalFormat == GL_R8  ? GL_RED : GL_LUMINANCE;
+        glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0,
+                     format, GL_UNSIGNED_BYTE, nullptr);
+    }
+    if (glGetError() != GL_NO_ERROR) {
+        std::cerr << "Failed to allocate " << width << "x" << height << " frame texture" << std::endl;
+        glDeleteTextures(1, &slot.texture);
+        slot.texture = 0;
+        return false;
+    }
+
+    slot.width = width;
+    slot.height = height;
+    slot.internalFormat = internalFormat;
+    return true;
+}
+
+// Loads an indexed frame's 256 colours into the slot's palette texture
+void DesktopRenderer::uploadPalette(FrameTexture& slot, const uint32_t* palette) {
+    if (!slot.palette) {
+        glGenTextures(1, &slot.palette);
+        glBindTexture(GL_TEXTURE_2D, slot.palette);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 256, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    }
+    glBindTexture(GL_TEXTURE_2D, slot.palette);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 256, 1, GL_RGBA, GL_UNSIGNED_BYTE, palette);
+}
+
+void DesktopRenderer::createUploadRing(size_t frameBytes) {
+    destroyUploadRing();
+    if (!m_gl.hasPixelBuffers()) {
+        return;  // uploads go straight from client memory
+    }
+
+    m_gl.GenBuffers(UPLOAD_RING_SIZE, m_uploadBuffers);
+    for (int i = 0; i < UPLOAD_RING_SIZE; ++i) {
+        m_gl.BindBuffer(GL_PIXEL_UNPACK_BUFFER, m_uploadBuffers[i]);
+        if (m_persistentUpload) {
+            const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+            m_gl.BufferStorage(GL_PIXEL_UNPACK_BUFFER, frameBytes, nullptr, flags);
+            m_uploadPointers[i] = static_cast<unsigned char*>(
+                m_gl.MapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, frameBytes, flags));
+            if (!m_uploadPointers[i]) {
+                // Driver advertised buffer storage but refused the mapping
+                std::cerr << "Persistent buffer mapping failed, using streamed PBOs" << std::endl;
+                m_gl.BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+                m_persistentUpload = false;
+                createUploadRing(frameBytes);
+                return;
+            }
+        } else {
+            m_gl.BufferData(GL_PIXEL_UNPACK_BUFFER, frameBytes, nullptr, GL_STREAM_DRAW);
+        }
+    }
+    m_gl.BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    m_uploadBytes = frameBytes;
+    m_uploadSlot = 0;
+}
+
+void DesktopRenderer::destroyUploadRing() {
+    if (!m_uploadBuffers[0]) {
+        return;
+    }
+    for (int i = 0; i < UPLOAD_RING_SIZE; ++i) {
+        if (m_uploadFences[i]) {
+            m_gl.DeleteSync(m_uploadFences[i]);
+            m_uploadFences[i] = nullptr;
+        }
+        if (m_uploadPointers[i]) {
+            m_gl.BindBuffer(GL_PIXEL_UNPACK_BUFFER, m_uploadBuffers[i]);
+            m_gl.UnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+            m_uploadPointers[i] = nullptr;
+        }
     }
-    return renderFrameSW(data, width, height);
+    m_gl.BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    m_gl.DeleteBuffers(UPLOAD_RING_SIZE, m_uploadBuffers);
+    for (GLuint& buffer : m_uploadBuffers) {
+        buffer = 0;
+    }
+    m_uploadBytes = 0;
 }
 
-// Upload a CPU pixel buffer as a texture and draw it as a fullscreen quad.
-// This is faster than XPutImage because the GPU handles the blit asynchronously.
-bool DesktopRenderer::renderFrameGL(const unsigned char* data, int width, int height) {
-    glXMakeCurrent(m_display, m_backgroundWindow, m_glContext);
+// Copies the given regions of one frame into the next ring slot and queues
+// the texture updates from it.  glTexSubImage2D then returns immediately:
+// the GPU pulls the pixels by DMA while the CPU goes on to produce the next
+// frame.  The frame keeps the engine's own layout, also inside the buffer;
+// the upload format tells GL how to read it.
+void DesktopRenderer::uploadFrame(GLuint texture, const unsigned char* data, const FrameDescriptor& frame,
+                                  const std::vector<UploadRect>& regions) {
+    UploadFormat upload = uploadFormatFor(frame.format);
+    if (frame.format == PixelFormat::Indexed8 && !m_redTextures) {
+        upload.format = GL_LUMINANCE;
+    }
+    const size_t frameBytes = frame.sizeInBytes();
+    const int bpp = frame.bytesPerPixel();
+    const auto offsetOf = [&](int x, int y) {
+        return static_cast<size_t>(y) * frame.stride + static_cast<size_t>(x) * bpp;
+    };
+    glBindTexture(GL_TEXTURE_2D, texture);
+
+    if (!setUnpackLayout(frame)) {
+        // Odd stride: hand GL one tightly packed row at a time
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+        for (const UploadRect& rect : regions) {
+            for (int y = rect.y; y < rect.y + rect.height; ++y) {
+                glTexSubImage2D(GL_TEXTURE_2D, 0, rect.x, y, rect.width, 1,
+                                upload.format, upload.type, data + offsetOf(rect.x, y));
+            }
+        }
+        return;
+    }
+
+    if (m_gl.hasPixelBuffers() && frameBytes != m_uploadBytes) {
+        createUploadRing(frameBytes);
+    }
+    if (!m_uploadBuffers[0]) {
+        for (const UploadRect& rect : regions) {
+            glTexSubImage2D(GL_TEXTURE_2D, 0, rect.x, rect.y, rect.width, rect.height,
+                            upload.format, upload.type, data + offsetOf(rect.x, rect.y));
+        }
+        return;
+    }
+
+    const int slot = m_uploadSlot;
+    m_uploadSlot = (m_uploadSlot + 1) % UPLOAD_RING_SIZE;
+    m_gl.BindBuffer(GL_PIXEL_UNPACK_BUFFER, m_uploadBuffers[slot]);
 
-    glBindTexture(GL_TEXTURE_2D, m_texture);
+    // Only the regions are copied; the rest of the buffer is never read
+    const auto copyRegions = [&](unsigned char* dst) {
+        for (const UploadRect& rect : regions) {
+            if (rect.x == 0 && rect.width == frame.width) {
+                const size_t begin = offsetOf(0, rect.y);
+                const size_t end = std::min(offsetOf(0, rect.y + rect.height), frameBytes);
+                std::memcpy(dst + begin, data + begin, end - begin);
+                continue;
+            }
+            const size_t rowBytes = static_cast<size_t>(rect.width) * bpp;
+            for (int y = rect.y; y < rect.y + rect.height; ++y) {
+                std::memcpy(dst + offsetOf(rect.x, y), data + offsetOf(rect.x, y), rowBytes);
+            }
+        }
+    };
 
-    // libvisual gives us RGB; upload and let the GPU scale to screen size
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0,
-                 GL_RGB, GL_UNSIGNED_BYTE, data);
+    if (m_persistentUpload) {
+        // The slot was last read UPLOAD_RING_SIZE frames ago, so the fence
+        // has normally long been signalled and this does not block
+        if (m_uploadFences[slot]) {
+            m_gl.ClientWaitSync(m_uploadFences[slot], GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ull);
+            m_gl.DeleteSync(m_uploadFences[slot]);
+            m_uploadFences[slot] = nullptr;
+        }
+        copyRegions(m_uploadPointers[slot]);  // coherent: no flush needed
+    } else {
+        void* dst = nullptr;
+        if (m_gl.hasMapBufferRange()) {
+            // Invalidation orphans the old storage instead of waiting for the GPU
+            dst = m_gl.MapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, frameBytes,
+                                      GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+        }
+        if (dst) {
+            copyRegions(static_cast<unsigned char*>(dst));
+            m_gl.UnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        } else {
+            m_gl.BufferData(GL_PIXEL_UNPACK_BUFFER, m_uploadBytes, nullptr, GL_STREAM_DRAW);
+            for (const UploadRect& rect : regions) {
+                const size_t begin = offsetOf(rect.x, rect.y);
+                const size_t end = std::min(offsetOf(rect.x + rect.width, rect.y + rect.height - 1), frameBytes);
+                m_gl.BufferSubData(GL_PIXEL_UNPACK_BUFFER, begin, end - begin, data + begin);
+            }
+        }
+    }
 
-    glClear(GL_COLOR_BUFFER_BIT);
-    glBegin(GL_QUADS);
-        glTexCoord2f(0.0f, 1.0f); glVertex2f(0.0f, 0.0f);
-        glTexCoord2f(1.0f, 1.0f); glVertex2f(1.0f, 0.0f);
-        glTexCoord2f(1.0f, 0.0f); glVertex2f(1.0f, 1.0f);
-        glTexCoord2f(0.0f, 0.0f); glVertex2f(0.0f, 1.0f);
-    glEnd();
+    // With a bound unpack buffer the pointer argument is an offset into it
+    for (const UploadRect& rect : regions) {
+        glTexSubImage2D(GL_TEXTURE_2D, 0, rect.x, rect.y, rect.width, rect.height,
+                        upload.format, upload.type,
+                        reinterpret_cast<const void*>(offsetOf(rect.x, rect.y)));
+    }
+    if (m_persistentUpload) {
+        m_uploadFences[slot] = m_gl.FenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+    m_gl.BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
 
-    glXSwapBuffers(m_display, m_backgroundWindow);
+// Stream a CPU pixel buffer into the frame texture and draw it as a fullscreen
+// quad.  This is faster than XPutImage because the GPU handles the blit asynchronously.
+bool DesktopRenderer::renderFrameGL(const unsigned char* data, const FrameDescriptor& frame,
+                                    const TileHashes* tiles) {
+    if (!uploadToTexture(m_latestTexture, data, frame, tiles)) {
+        return false;
+    }
+    m_hasPreviousFrame = false;
+    drawFrames(1.0f);
     return true;
 }
 
-bool DesktopRenderer::renderFrameSW(const unsigned char* data, int width, int height) {
-    for (int y = 0; y < m_screenHeight; ++y) {
-        for (int x = 0; x < m_screenWidth; ++x) {
-            int srcX = x % width;
-            int srcY = y % height;
-            int srcIndex = (srcY * width + srcX) * 3;
-            int dstIndex = (y * m_screenWidth + x) * 4;
+bool DesktopRenderer::submitFrame(const unsigned char* data, const FrameDescriptor& frame,
+                                  const TileHashes* tiles) {
+    if (!m_glInitialized) {
+        return renderFrame(data, frame, tiles);
+    }
+    if (!acceptsFrame(data, frame)) return false;
 
-            if (srcIndex + 2 < width * height * 3) {
-                m_imageData[dstIndex + 2] = data[srcIndex];
-                m_imageData[dstIndex + 1] = data[srcIndex + 1];
-                m_imageData[dstIndex + 0] = data[srcIndex + 2];
-                m_imageData[dstIndex + 3] = 255;
+    // The newest frame becomes the previous one; the upload goes to the
+    // other texture
+    const FrameTexture& latest = m_frameTextures[m_latestTexture];
+    const int slot = latest.filled ? m_latestTexture ^ 1 : m_latestTexture;
+    if (!uploadToTexture(slot, data, frame, tiles)) {
+        return false;
+    }
+    const FrameDescriptor& uploaded = m_frameTextures[slot].frame;
+    m_hasPreviousFrame = slot != m_latestTexture && latest.width == uploaded.width &&
+        latest.height == uploaded.height && blendable(latest.frame, uploaded);
+    m_latestTexture = slot;
+    return true;
+}
+
+bool DesktopRenderer::presentInterpolated(float weight) {
+    if (!m_glInitialized || !m_frameTextures[m_latestTexture].filled) {
+        return false;
+    }
+    makeCurrent();
+    drawFrames(m_hasPreviousFrame ? weight : 1.0f);
+    return true;
+}
+
+// Uploads one frame into m_frameTextures[slot].  With tile hashes of the
+// frame, only the tiles that differ from the texture's content are sent.
+bool DesktopRenderer::uploadToTexture(int slot, const unsigned char* data, const FrameDescriptor& frame,
+                                      const TileHashes* tiles) {
+    makeCurrent();
+
+    StageTimer timer(m_stageStats, Stage::Upload);
+    FrameTexture& target = m_frameTextures[slot];
+    const bool partial = tiles && target.filled && target.tiles.layout == tiles->layout &&
+                         target.tiles.columns == tiles->columns && target.tiles.rows == tiles->rows &&
+                         !tiles->empty() && frame.stride % frame.bytesPerPixel() == 0;
+    target.filled = false;
+    // Indexed frames stay one byte per pixel; the shader applies the palette
+    const bool indexed = frame.format == PixelFormat::Indexed8;
+    const GLenum internalFormat = !indexed ? GL_RGBA8 : m_redTextures ? GL_R8 : GL_LUMINANCE8;
+    if (!ensureTexture(target, frame.width, frame.height, internalFormat)) {
+        return false;
+    }
+    if (indexed) {
+        uploadPalette(target, frame.palette);
+    }
+
+    m_uploadRegions.clear();
+    if (partial) {
+        dirtyRegions(target.tiles, *tiles, frame.width, frame.height, m_uploadRegions);
+    } else {
+        m_uploadRegions.push_back({0, 0, frame.width, frame.height});
+    }
+    if (!m_uploadRegions.empty()) {
+        uploadFrame(target.texture, data, frame, m_uploadRegions);
+    }
+
+    target.frame = frame;
+    target.frame.palette = nullptr;  // only valid for the call
+    if (tiles) {
+        target.tiles = *tiles;
+    } else {
+        target.tiles.clear();
+    }
+    target.filled = true;
+    return true;
+}
+
+// Draws the newest frame, cross-faded from the one before it by 1 - weight,
+// and presents it
+void DesktopRenderer::drawFrames(float weight) {
+    const FrameTexture& latest = m_frameTextures[m_latestTexture];
+    const FrameDescriptor& frame = latest.frame;
+    {
+        StageTimer timer(m_stageStats, Stage::Present);
+
+        // Only frames that carry real alpha are blended (over the black clear);
+        // padding bytes of XRGB frames are never looked at
+        switch (frame.alpha) {
+        case AlphaMode::Ignored:
+            glDisable(GL_BLEND);
+            break;
+        case AlphaMode::Straight:
+            glEnable(GL_BLEND);
+            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+            break;
+        case AlphaMode::Premultiplied:
+            glEnable(GL_BLEND);
+            glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+            break;
+        }
+
+        // Texture row 0 is the first row in memory; the shader puts it where
+        // the frame says, and swizzles, filters and corrects it on the way
+        PresentShader::Params params;
+        params.swapRedBlue    = uploadFormatFor(frame.format).swapRedBlue;
+        params.opaque         = frame.alpha == AlphaMode::Ignored;
+        params.topRowFirst    = frame.origin == FrameOrigin::TopLeft;
+        params.gamma          = m_gamma;
+        params.filter         = m_scaleFilter;
+        params.textureWidth   = frame.width;
+        params.textureHeight  = frame.height;
+        params.viewportWidth  = m_screenWidth;
+        params.viewportHeight = m_screenHeight;
+        const FrameTexture& previous = m_frameTextures[m_latestTexture ^ 1];
+        const bool indexed = frame.format == PixelFormat::Indexed8;
+        params.palette = indexed ? latest.palette : 0;
+        // The previous texture may hold another format, e.g. RGBA after a
+        // switch to an 8-bit actor; it must never be read as palette indices
+        if (m_hasPreviousFrame && weight < 1.0f && previous.filled && blendable(previous.frame, frame)) {
+            params.previousTexture = previous.texture;
+            params.previousPalette = indexed ? previous.palette : 0;
+            params.mix             = weight;
+        }
+
+        glClear(GL_COLOR_BUFFER_BIT);
+        m_presenter->draw(latest.texture, params);
+        drawOverlay();
+        presentBuffer();
+    }
+    checksumOutput();
+}
+
+bool DesktopRenderer::renderFrameSW(const unsigned char* data, const FrameDescriptor& frame) {
+    // XImage pixels are native 0x00RRGGBB words, i.e. BGRA32
+    const PixelRowConverter convert = pixelRowConverter(frame.format, PixelFormat::BGRA32);
+    if (!convert) {
+        return false;
+    }
+    const int dstStride = m_image ? m_image->bytes_per_line : m_screenWidth * 4;
+    const bool fullSize = frame.width == m_screenWidth && frame.height == m_screenHeight;
+
+    {
+        StageTimer timer(m_stageStats, Stage::Upload);
+        waitForShmCompletion();
+
+        // Frames the scaler can read as they are go straight to it; others are
+        // converted first — directly into the image when no scaling is needed
+        const unsigned char* pixels = data;
+        int stride = frame.stride;
+        if (frame.format != PixelFormat::BGRA32 || frame.origin != FrameOrigin::TopLeft || fullSize) {
+            unsigned char* target = m_imageData;
+            stride = dstStride;
+            if (!fullSize) {
+                stride = frame.width * 4;
+                m_convertedFrame.resize(static_cast<size_t>(stride) * frame.height);
+                target = m_convertedFrame.data();
             }
+            m_workers->parallelFor(frame.height, [&](int begin, int end) {
+                for (int y = begin; y < end; ++y) {
+                    const int row = frame.origin == FrameOrigin::TopLeft ? y : frame.height - 1 - y;
+                    convert(data + static_cast<size_t>(row) * frame.stride,
+                            target + static_cast<size_t>(y) * stride, frame.width, frame.palette);
+                }
+            });
+            pixels = target;
+        }
+
+        if (!fullSize) {
+            m_scaler->scale(pixels, frame.width, frame.height, stride,
+                            m_imageData, m_screenWidth, m_screenHeight, dstStride);
         }
     }
 
-    XPutImage(m_display, m_backgroundWindow, m_gc, m_image,
-              0, 0, 0, 0, m_screenWidth, m_screenHeight);
+    if (m_headless) {
+        // Nothing to put anywhere; the sample still counts the frame
+        if (m_stageStats) {
+            m_stageStats->record(Stage::Present, 0.0);
+        }
+        checksumOutput();
+        return true;
+    }
+
+    StageTimer timer(m_stageStats, Stage::Present);
+    if (m_useShm) {
+        XShmPutImage(m_display, m_backgroundWindow, m_gc, m_image,
+                     0, 0, 0, 0, m_screenWidth, m_screenHeight, True);
+        m_shmPending = true;
+    } else {
+        XPutImage(m_display, m_backgroundWindow, m_gc, m_image,
+                  0, 0, 0, 0, m_screenWidth, m_screenHeight);
+    }
     XFlush(m_display);
     return true;
 }
@@ -242,10 +1136,103 @@ bool DesktopRenderer::renderFrameSW(const unsigned char* data, int width, int he
 // (e.g. projectM in direct-GL mode) — just present the frame.
 void DesktopRenderer::swapBuffers() {
     if (m_glInitialized) {
+        {
+            StageTimer timer(m_stageStats, Stage::Present);
+            drawOverlay();
+            presentBuffer();
+        }
+        checksumOutput();
+    }
+}
+
+void DesktopRenderer::setOverlayText(const std::vector<std::string>& lines, double targetMs) {
+    if (m_overlay) {
+        m_overlay->setText(lines, targetMs);
+    }
+}
+
+void DesktopRenderer::drawOverlay() {
+    if (!m_overlayVisible || !m_overlay) {
+        return;
+    }
+    StageTimer timer(m_stageStats, Stage::Overlay);
+    m_overlay->draw(m_screenWidth, m_screenHeight);
+}
+
+void DesktopRenderer::makeCurrent() {
+    if (m_headlessContext) {
+        m_headlessContext->makeCurrent();
+        // An engine sharing the context may have bound its own target
+        m_gl.BindFramebuffer(GL_FRAMEBUFFER, m_headlessFramebuffer);
+    } else {
+        glXMakeCurrent(m_display, m_backgroundWindow, m_glContext);
+    }
+}
+
+void DesktopRenderer::presentBuffer() {
+    if (m_headlessContext) {
+        // Nothing to swap; waiting for the GPU keeps its time in the
+        // present stage instead of letting work pile up
+        glFinish();
+    } else {
         glXSwapBuffers(m_display, m_backgroundWindow);
     }
 }
 
+// Folds a hash of the presented image into the run's checksum.  GL reads
+// back bottom-up RGBA, the software path hashes its BGRA image, so only
+// runs on the same path compare.
+void DesktopRenderer::checksumOutput() {
+    if (!m_headless || !m_checksumOutput) {
+        return;
+    }
+    StageTimer timer(m_stageStats, Stage::Readback);
+    const size_t bytes = static_cast<size_t>(m_screenWidth) * m_screenHeight * 4;
+    const unsigned char* image = m_imageData;
+    if (m_glInitialized) {
+        m_readback.resize(bytes);
+        glPixelStorei(GL_PACK_ALIGNMENT, 4);
+        glPixelStorei(GL_PACK_ROW_LENGTH, 0);
+        glReadPixels(0, 0, m_screenWidth, m_screenHeight, GL_RGBA, GL_UNSIGNED_BYTE, m_readback.data());
+        image = m_readback.data();
+    }
+    m_outputChecksum = hashCombine(m_outputChecksum, hashBytes(image, bytes));
+}
+
+void DesktopRenderer::releaseContext() {
+    if (!m_glInitialized) {
+        return;
+    }
+    if (m_headlessContext) {
+        m_headlessContext->release();
+    } else {
+        glXMakeCurrent(m_display, 0, nullptr);
+    }
+}
+
+void DesktopRenderer::setScaleFilter(ScaleFilter filter) {
+    m_scaleFilter = filter;
+    if (m_scaler) {
+        m_scaler->setFilter(filter);
+    }
+}
+
+bool DesktopRenderer::setSwapInterval(int interval) {
+    if (!m_glInitialized || m_headless) {
+        return false;
+    }
+    makeCurrent();
+    return m_glx.setSwapInterval(m_display, m_backgroundWindow, interval);
+}
+
+bool DesktopRenderer::getVblankTiming(int64_t& ust, int64_t& msc) const {
+    if (!m_glInitialized || m_headless || !m_glx.hasSyncControl()) {
+        return false;
+    }
+    int64_t sbc = 0;
+    return m_glx.GetSyncValuesOML(m_display, m_backgroundWindow, &ust, &msc, &sbc);
+}
+
 void DesktopRenderer::getScreenSize(int& width, int& height) {
     width  = m_screenWidth;
     height = m_screenHeight;
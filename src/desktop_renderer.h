@@ -4,6 +4,8 @@
 #include <X11/Xlib.h>
 #include <X11/Xutil.h>
 #include <X11/Xatom.h>
+#include <X11/extensions/XShm.h>
+#include <X11/extensions/Xrandr.h>
 #include <GL/glx.h>
 #include <GL/gl.h>
 
@@ -18,52 +20,245 @@
 #undef Bool
 #endif
 
+#include <atomic>
 #include <memory>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "gl_loader.h"
+#include "frame_hash.h"
+#include "frame_scaler.h"
+#include "headless_context.h"
+#include "perf_overlay.h"
+#include "present_shader.h"
+#include "stage_stats.h"
+#include "visualization_engine.h"
+
+/**
+ * One XRandR output showing part of the desktop.  Outputs that mirror the
+ * same CRTC are reported once.
+ */
+struct MonitorInfo {
+    std::string name;     // output name, e.g. "DP-1"
+    int x = 0;            // position on the root window
+    int y = 0;
+    int width = 0;
+    int height = 0;
+    double refreshRate = 0.0;
+    bool primary = false;
+};
+
+// A rectangle of frame pixels to upload, in memory row order
+struct UploadRect {
+    int x;
+    int y;
+    int width;
+    int height;
+};
 
 class DesktopRenderer {
 public:
     DesktopRenderer();
     ~DesktopRenderer();
 
-    bool initialize();
+    // Active outputs, primary first and then left to right; empty when
+    // XRandR is unavailable
+    static std::vector<MonitorInfo> enumerateMonitors();
+
+    // Covers the given monitor, or the whole screen when monitor is null.
+    // Every renderer opens its own display connection, so renderers for
+    // different monitors can present from different threads.
+    bool initialize(const MonitorInfo* monitor = nullptr);
+    // Renders a width x height output without any display: through the GL
+    // path into an offscreen framebuffer of an EGL context, or, without
+    // EGL, through the software path into memory.  Nothing is shown.
+    bool initializeHeadless(int width, int height);
     void shutdown();
+    bool isHeadless() const { return m_headless; }
 
-    bool renderFrame(const unsigned char* data, int width, int height);
+    // Presents one engine frame, read in the layout frame describes.  With
+    // the frame's tile hashes the GL path uploads only the tiles that
+    // changed since the frame before.
+    bool renderFrame(const unsigned char* data, const FrameDescriptor& frame,
+                     const TileHashes* tiles = nullptr);
+
+    // Frame interpolation, for engines running below the display rate.
+    // submitFrame() uploads a frame and keeps the one before it;
+    // presentInterpolated() presents the two cross-faded, weight 0 showing
+    // the older and 1 the newer.  Only the GL path blends: without it
+    // submitFrame() presents the frame right away and presentInterpolated()
+    // returns false.
+    bool canInterpolate() const { return m_glInitialized; }
+    bool submitFrame(const unsigned char* data, const FrameDescriptor& frame,
+                     const TileHashes* tiles = nullptr);
+    bool presentInterpolated(float weight);
     void swapBuffers();
     void getScreenSize(int& width, int& height);
 
-    // GL context accessors for engines that render directly to OpenGL
+    // Resampling used to fit frames to the screen
+    void setScaleFilter(ScaleFilter filter);
+    // Gamma correction of the GL path, applied by the presentation shader;
+    // 1 leaves colours unchanged.  The software path does not apply it.
+    void setGamma(float gamma) { m_gamma = gamma; }
+
+    // Performance overlay drawn over every presented frame (GL path only).
+    // Visibility may be switched from any thread; the text is set by the
+    // thread presenting, as lines plus the frame period the graph marks.
+    void setOverlayVisible(bool visible) { m_overlayVisible = visible; }
+    bool overlayVisible() const { return m_overlayVisible && m_overlay; }
+    void setOverlayText(const std::vector<std::string>& lines, double targetMs);
+
+    // Upload, present, overlay and readback times go here (null: not timed)
+    void setStageStats(StageStats* stats) { m_stageStats = stats; }
+    // Headless only: reads every presented image back and folds its hash
+    // into outputChecksum(), which then identifies the whole run
+    void setOutputChecksum(bool enabled) { m_checksumOutput = enabled; }
+    uint64_t outputChecksum() const { return m_outputChecksum; }
+
+    // Presentation timing.  Refresh rate of the output showing the window
+    // (XRandR), 0 when unknown.  setSwapInterval(1) makes every swap wait
+    // for vblank; false without GLX swap control.
+    double getRefreshRate() const { return m_refreshRate; }
+    bool setSwapInterval(int interval);
+    // Time (microseconds, UST clock) and counter of the latest vblank from
+    // GLX_OML_sync_control; false when the driver does not provide them
+    bool getVblankTiming(int64_t& ust, int64_t& msc) const;
+
+    // GL context accessors for engines that render directly to OpenGL;
+    // there is no display or window when headless
     Display* getDisplay() const { return m_display; }
     Window getWindow() const { return m_backgroundWindow; }
     GLXContext getGLContext() const { return m_glContext; }
     bool hasGLContext() const { return m_glInitialized; }
+    // Makes the GL context current in no thread, so another thread can take
+    // it over; renderFrame() and setSwapInterval() make it current again
+    void releaseContext();
 
 private:
     bool createBackgroundWindow();
     bool initializeGL();
-    bool renderFrameGL(const unsigned char* data, int width, int height);
-    bool renderFrameSW(const unsigned char* data, int width, int height);
+    // Core-profile context where GLX can create one, legacy otherwise
+    GLXContext createContext();
+    // Shared by both GL setups once a context is current
+    bool initializeGLState();
+    bool createHeadlessFramebuffer();
+    void makeCurrent();
+    // Swaps, or finishes the frame when headless
+    void presentBuffer();
+    void drawOverlay();
+    // Headless: hashes the image just presented
+    void checksumOutput();
+    bool acceptsFrame(const unsigned char* data, const FrameDescriptor& frame) const;
+    bool renderFrameGL(const unsigned char* data, const FrameDescriptor& frame, const TileHashes* tiles);
+    bool uploadToTexture(int slot, const unsigned char* data, const FrameDescriptor& frame,
+                         const TileHashes* tiles);
+    void drawFrames(float weight);
+    bool renderFrameSW(const unsigned char* data, const FrameDescriptor& frame);
     void destroyWindow();
     void shutdownGL();
 
+    // Software path: the frame image lives in a SysV shared memory segment
+    // the X server reads directly; a client-side XImage is used only when
+    // MIT-SHM is missing or cannot be attached (e.g. a remote display)
+    bool createSoftwareImage();
+    bool createSharedImage(Visual* visual, int depth);
+    void destroySoftwareImage();
+    void waitForShmCompletion();
+
+    // A frame texture and the layout and tile hashes of the frame last
+    // uploaded to it (no hashes: unknown content)
+    struct FrameTexture {
+        GLuint texture = 0;
+        int width = 0;
+        int height = 0;
+        GLenum internalFormat = 0;  // GL_RGBA8, or one channel for indexed frames
+        GLuint palette = 0;         // 256 x 1 colours of indexed frames
+        FrameDescriptor frame;
+        TileHashes tiles;
+        bool filled = false;
+    };
+
+    // Streaming textures: storage is allocated once per frame size and frames
+    // reach it through a ring of pixel unpack buffers
+    bool ensureTexture(FrameTexture& slot, int width, int height, GLenum internalFormat);
+    void uploadPalette(FrameTexture& slot, const uint32_t* palette);
+    void createUploadRing(size_t frameBytes);
+    void destroyUploadRing();
+    void uploadFrame(GLuint texture, const unsigned char* data, const FrameDescriptor& frame,
+                     const std::vector<UploadRect>& regions);
+
     Display* m_display;
     Window m_rootWindow;
     Window m_backgroundWindow;
     GC m_gc;
     XImage* m_image;
     XVisualInfo* m_visualInfo;
+    GLXFBConfig m_fbConfig;   // config of m_visualInfo; null without GLX 1.3
 
+    // Window geometry on the root window — the size of one monitor, or the
+    // whole screen
+    int m_originX;
+    int m_originY;
     int m_screenWidth;
     int m_screenHeight;
     int m_screen;
 
     unsigned char* m_imageData;
     bool m_initialized;
+    bool m_headless;
 
-    // OpenGL/GLX state
+    // MIT-SHM state — m_imageData points into the segment while m_useShm
+    XShmSegmentInfo m_shmInfo;
+    bool m_useShm;
+    int m_shmCompletionType;  // event type of ShmCompletion on this display
+    bool m_shmPending;        // last XShmPutImage not yet reported complete
+
+    // OpenGL/GLX state.  Frames are drawn by the presentation shader; no
+    // fixed-function state is used, so the context may be core profile.
     GLXContext m_glContext;
-    GLuint m_texture;
+    std::unique_ptr<PresentShader> m_presenter;
+    float m_gamma;
     bool m_glInitialized;
+    GLFunctions m_gl;
+    GLXFunctions m_glx;
+    // Headless GL: the EGL context and the framebuffer standing in for the window
+    std::unique_ptr<HeadlessContext> m_headlessContext;
+    GLuint m_headlessFramebuffer;
+    GLuint m_headlessColorBuffer;
+    double m_refreshRate;
+    std::unique_ptr<PerfOverlay> m_overlay;  // null without GL or when it failed
+    std::atomic<bool> m_overlayVisible;
+
+    // The newest frame and, while interpolating, the one before it
+    FrameTexture m_frameTextures[2];
+    int m_latestTexture;
+    bool m_hasPreviousFrame;  // m_frameTextures[m_latestTexture ^ 1] can be blended in
+
+    // Upload ring — while the GPU copies out of one buffer the CPU fills the
+    // next, so neither side waits for the other
+    static constexpr int UPLOAD_RING_SIZE = 3;
+    GLuint m_uploadBuffers[UPLOAD_RING_SIZE];
+    GLsync m_uploadFences[UPLOAD_RING_SIZE];          // persistent mode only
+    unsigned char* m_uploadPointers[UPLOAD_RING_SIZE]; // persistent mode only
+    size_t m_uploadBytes;
+    int m_uploadSlot;
+    bool m_persistentUpload;
+    bool m_redTextures;   // GL_R8 textures; GL_LUMINANCE8 holds indices otherwise
+
+    // Parts of the frame the current upload sends
+    std::vector<UploadRect> m_uploadRegions;
+
+    // Software path: frames are converted to BGRA32 (when not already) and
+    // scaled to the screen on a persistent worker pool
+    std::unique_ptr<WorkerPool> m_workers;
+    std::unique_ptr<FrameScaler> m_scaler;
+    ScaleFilter m_scaleFilter;
+    std::vector<unsigned char> m_convertedFrame;
+
+    StageStats* m_stageStats;
+    bool m_checksumOutput;
+    uint64_t m_outputChecksum;
+    std::vector<unsigned char> m_readback;
 };
 
 #endif // DESKTOP_RENDERER_H
\ No newline at end of file
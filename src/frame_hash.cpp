@@ -0,0 +1,106 @@
+#include "frame_hash.h"
+#include <cstring>
+
+namespace {
+
+constexpr uint64_t MULTIPLIER = 0x9E3779B97F4A7C15ull;
+constexpr uint64_t WORD_MIX   = 0xFF51AFD7ED558CCDull;
+
+inline uint64_t rotateLeft(uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+constexpr int LANES = 4;
+constexpr size_t STRIPE = LANES * 8;
+
+inline uint64_t mixWord(uint64_t h, uint64_t word) {
+    return rotateLeft(h ^ (word * WORD_MIX), 31) * MULTIPLIER;
+}
+
+// Final avalanche (MurmurHash3 fmix64)
+inline uint64_t finalize(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDull;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ull;
+    h ^= h >> 33;
+    return h;
+}
+
+} // namespace
+
+uint64_t hashBytes(const void* data, size_t size, uint64_t seed) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+
+    // Four independent lanes over 32-byte stripes keep the multipliers busy
+    // instead of waiting on one long dependency chain
+    uint64_t lanes[LANES] = {seed, seed ^ MULTIPLIER, seed ^ WORD_MIX, seed - MULTIPLIER};
+    size_t offset = 0;
+    for (; offset + STRIPE <= size; offset += STRIPE) {
+        uint64_t words[LANES];
+        std::memcpy(words, bytes + offset, STRIPE);
+        for (int i = 0; i < LANES; ++i) {
+            lanes[i] = mixWord(lanes[i], words[i]);
+        }
+    }
+
+    uint64_t h = seed ^ (size * MULTIPLIER);
+    for (uint64_t lane : lanes) {
+        h = mixWord(h, lane);
+    }
+    for (; offset + 8 <= size; offset += 8) {
+        uint64_t word;
+        std::memcpy(&word, bytes + offset, 8);
+        h = mixWord(h, word);
+    }
+    if (offset < size) {
+        uint64_t word = 0;
+        std::memcpy(&word, bytes + offset, size - offset);
+        h = mixWord(h, word);
+    }
+    return finalize(h);
+}
+
+uint64_t hashCombine(uint64_t hash, uint64_t value) {
+    return finalize(rotateLeft(hash, 17) ^ (value * MULTIPLIER));
+}
+
+bool TileHashes::operator==(const TileHashes& other) const {
+    return !tiles.empty() && layout == other.layout && columns == other.columns &&
+           rows == other.rows && tiles == other.tiles;
+}
+
+void TileHashes::clear() {
+    columns = 0;
+    rows = 0;
+    layout = 0;
+    tiles.clear();
+}
+
+void hashTiles(const unsigned char* data, const FrameDescriptor& frame, TileHashes& out) {
+    out.columns = (frame.width + TileHashes::TILE_SIZE - 1) / TileHashes::TILE_SIZE;
+    out.rows = (frame.height + TileHashes::TILE_SIZE - 1) / TileHashes::TILE_SIZE;
+    out.tiles.assign(static_cast<size_t>(out.columns) * out.rows, 0);
+
+    // A palette change recolours every pixel, so it seeds every tile
+    const uint64_t palette = frame.palette ? hashBytes(frame.palette, 256 * sizeof(uint32_t)) : 0;
+    uint64_t layout = hashCombine(palette, static_cast<uint64_t>(frame.format));
+    layout = hashCombine(layout, static_cast<uint64_t>(frame.width));
+    layout = hashCombine(layout, static_cast<uint64_t>(frame.height));
+    layout = hashCombine(layout, static_cast<uint64_t>(frame.stride));
+    layout = hashCombine(layout, static_cast<uint64_t>(frame.origin));
+    out.layout = hashCombine(layout, static_cast<uint64_t>(frame.alpha));
+
+    const int bpp = frame.bytesPerPixel();
+    const size_t tileBytes = static_cast<size_t>(TileHashes::TILE_SIZE) * bpp;
+    const size_t rowBytes = static_cast<size_t>(frame.width) * bpp;
+    for (int y = 0; y < frame.height; ++y) {
+        const unsigned char* row = data + static_cast<size_t>(y) * frame.stride;
+        uint64_t* tile = &out.tiles[static_cast<size_t>(y / TileHashes::TILE_SIZE) * out.columns];
+        // Each row segment is chained onto its tile's hash
+        for (size_t x = 0; x < rowBytes; x += tileBytes, ++tile) {
+            const size_t bytes = x + tileBytes <= rowBytes ? tileBytes : rowBytes - x;
+            *tile = hashBytes(row + x, bytes, *tile ^ palette);
+        }
+    }
+}
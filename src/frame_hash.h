@@ -0,0 +1,41 @@
+#ifndef FRAME_HASH_H
+#define FRAME_HASH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "visualization_engine.h"
+
+/**
+ * Fast 64-bit non-cryptographic hash of a byte range, 32 bytes per step in
+ * four independent lanes.  Meant for telling frames apart, not for security.
+ */
+uint64_t hashBytes(const void* data, size_t size, uint64_t seed = 0);
+
+// Folds value into an order-dependent running hash
+uint64_t hashCombine(uint64_t hash, uint64_t value);
+
+/**
+ * Content hashes of a frame in TILE_SIZE x TILE_SIZE pixel tiles, in memory
+ * row order: two frames with equal hashes show the same picture, and tiles
+ * whose hashes differ are the only parts that changed.  Empty hashes match
+ * nothing.
+ */
+struct TileHashes {
+    static constexpr int TILE_SIZE = 64;
+
+    int columns = 0;
+    int rows = 0;
+    uint64_t layout = 0;            // size, stride, format, origin, alpha and palette
+    std::vector<uint64_t> tiles;    // row-major, columns x rows
+
+    bool empty() const { return tiles.empty(); }
+    void clear();
+    bool operator==(const TileHashes& other) const;
+    bool operator!=(const TileHashes& other) const { return !(*this == other); }
+};
+
+// Hashes every tile of a frame laid out as frame describes
+void hashTiles(const unsigned char* data, const FrameDescriptor& frame, TileHashes& out);
+
+#endif // FRAME_HASH_H
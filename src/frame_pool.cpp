@@ -0,0 +1,48 @@
+#include "frame_pool.h"
+
+FramePool::FramePool()
+    : m_back(0), m_front(1), m_middle(2) {
+}
+
+void FramePool::publish() {
+    Frame& frame = m_frames[m_back];
+    frame.descriptor.palette = frame.palette.empty() ? nullptr : frame.palette.data();
+
+    const int previous = m_middle.exchange(m_back | FRESH, std::memory_order_acq_rel);
+    m_back = previous & ~FRESH;
+
+    // Taking the mutex orders the notify after a waiter's predicate check
+    { std::lock_guard<std::mutex> lock(m_signalMutex); }
+    m_signal.notify_all();
+}
+
+bool FramePool::acquire() {
+    if (!(m_middle.load(std::memory_order_acquire) & FRESH)) {
+        return false;
+    }
+    const int previous = m_middle.exchange(m_front, std::memory_order_acq_rel);
+    m_front = previous & ~FRESH;
+
+    { std::lock_guard<std::mutex> lock(m_signalMutex); }
+    m_signal.notify_all();
+    return true;
+}
+
+bool FramePool::waitForFrame(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(m_signalMutex);
+    return m_signal.wait_for(lock, timeout, [this] {
+        return (m_middle.load(std::memory_order_acquire) & FRESH) != 0;
+    });
+}
+
+bool FramePool::waitUntilConsumed(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(m_signalMutex);
+    return m_signal.wait_for(lock, timeout, [this] {
+        return (m_middle.load(std::memory_order_acquire) & FRESH) == 0;
+    });
+}
+
+void FramePool::wakeAll() {
+    { std::lock_guard<std::mutex> lock(m_signalMutex); }
+    m_signal.notify_all();
+}
@@ -0,0 +1,70 @@
+#ifndef FRAME_POOL_H
+#define FRAME_POOL_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include "frame_hash.h"
+#include "visualization_engine.h"
+
+/**
+ * Triple buffer handing finished frames from the engine thread to the
+ * presentation thread.
+ *
+ * The producer always owns one frame to draw into and the consumer one to
+ * present from; the third is the latest finished frame.  Publishing and
+ * acquiring swap a buffer with that middle slot through one atomic
+ * exchange, so neither side ever waits for the other to finish copying.
+ * A frame published before the previous one was picked up replaces it —
+ * the presenter always gets the newest frame.
+ *
+ * The wait*() helpers only put a thread to sleep; the hand-over itself
+ * stays lock-free.
+ */
+class FramePool {
+public:
+    struct Frame {
+        std::vector<unsigned char> pixels;
+        std::vector<uint32_t> palette;  // Indexed8 frames only
+        FrameDescriptor descriptor;     // palette pointer refers to the member above
+        uint64_t sequence = 0;          // counts frames the engine produced
+        std::chrono::steady_clock::time_point timestamp;  // when the engine started it
+        TileHashes tiles;               // content hashes, taken on the engine thread
+    };
+
+    FramePool();
+
+    // Producer: the frame to fill next
+    Frame& writeFrame() { return m_frames[m_back]; }
+    // Producer: makes writeFrame() the latest frame and takes a fresh one
+    void publish();
+    // Producer: sleeps until the latest frame was picked up (render at most
+    // one ahead), up to timeout; true if it was
+    bool waitUntilConsumed(std::chrono::milliseconds timeout);
+
+    // Consumer: takes the latest frame if one was published since the last
+    // call; readFrame() then refers to it
+    bool acquire();
+    const Frame& readFrame() const { return m_frames[m_front]; }
+    // Consumer: sleeps until a frame is published, up to timeout
+    bool waitForFrame(std::chrono::milliseconds timeout);
+
+    // Wakes both sides, e.g. on shutdown
+    void wakeAll();
+
+private:
+    static constexpr int FRESH = 4;  // set in m_middle while unconsumed
+
+    Frame m_frames[3];
+    int m_back;                      // producer only
+    int m_front;                     // consumer only
+    std::atomic<int> m_middle;       // frame index | FRESH
+
+    std::mutex m_signalMutex;
+    std::condition_variable m_signal;
+};
+
+#endif // FRAME_POOL_H
@@ -0,0 +1,177 @@
+#include "frame_scaler.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+// Blends two BGRA32 pixels, weight in [0, 256] towards b.  Two channels are
+// processed per multiply: each 8-bit channel sits in its own 16-bit lane.
+inline uint32_t blend(uint32_t a, uint32_t b, uint32_t weight) {
+    const uint32_t inverse = 256 - weight;
+    const uint32_t rb = (((a & 0x00FF00FFu) * inverse + (b & 0x00FF00FFu) * weight) >> 8) & 0x00FF00FFu;
+    const uint32_t ag = (((a >> 8) & 0x00FF00FFu) * inverse + ((b >> 8) & 0x00FF00FFu) * weight) & 0xFF00FF00u;
+    return rb | ag;
+}
+
+// out = blend(a, b, weight) over a whole row
+void blendRows(const uint32_t* a, const uint32_t* b, uint32_t* out, size_t width, uint32_t weight) {
+    size_t x = 0;
+#ifdef __SSE2__
+    // Channels widened to 16 bits: a * (256 - w) + b * w stays below 65536
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i wb   = _mm_set1_epi16(static_cast<short>(weight));
+    const __m128i wa   = _mm_set1_epi16(static_cast<short>(256 - weight));
+    for (; x + 4 <= width; x += 4) {
+        const __m128i pa = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + x));
+        const __m128i pb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + x));
+        const __m128i lo = _mm_srli_epi16(_mm_add_epi16(
+            _mm_mullo_epi16(_mm_unpacklo_epi8(pa, zero), wa),
+            _mm_mullo_epi16(_mm_unpacklo_epi8(pb, zero), wb)), 8);
+        const __m128i hi = _mm_srli_epi16(_mm_add_epi16(
+            _mm_mullo_epi16(_mm_unpackhi_epi8(pa, zero), wa),
+            _mm_mullo_epi16(_mm_unpackhi_epi8(pb, zero), wb)), 8);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + x), _mm_packus_epi16(lo, hi));
+    }
+#endif
+    for (; x < width; ++x) {
+        out[x] = blend(a[x], b[x], weight);
+    }
+}
+
+inline const uint32_t* pixelRow(const unsigned char* base, int stride, int row) {
+    return reinterpret_cast<const uint32_t*>(base + static_cast<size_t>(row) * stride);
+}
+
+inline uint32_t* pixelRow(unsigned char* base, int stride, int row) {
+    return reinterpret_cast<uint32_t*>(base + static_cast<size_t>(row) * stride);
+}
+
+} // namespace
+
+FrameScaler::FrameScaler(WorkerPool& pool)
+    : m_pool(pool), m_filter(ScaleFilter::Bilinear), m_srcWidth(0), m_srcHeight(0) {
+}
+
+std::vector<FrameScaler::Tap> FrameScaler::buildTaps(int srcSize, int dstSize) {
+    std::vector<Tap> taps(dstSize);
+    const double ratio = static_cast<double>(srcSize) / dstSize;
+    for (int i = 0; i < dstSize; ++i) {
+        // Sample at pixel centres so both edges are treated alike
+        const double centre = (i + 0.5) * ratio;
+        const double pos = std::max(centre - 0.5, 0.0);
+        Tap& tap = taps[i];
+        tap.nearest = std::min(static_cast<int>(centre), srcSize - 1);
+        tap.first   = std::min(static_cast<int>(pos), srcSize - 1);
+        tap.second  = std::min(tap.first + 1, srcSize - 1);
+        tap.weight  = static_cast<uint32_t>(std::lround((pos - tap.first) * 256.0));
+        if (tap.first == tap.second) {
+            tap.weight = 0;
+        }
+    }
+    return taps;
+}
+
+void FrameScaler::buildTables(int srcWidth, int srcHeight, int dstWidth, int dstHeight) {
+    if (srcWidth == m_srcWidth && srcHeight == m_srcHeight
+        && dstWidth == static_cast<int>(m_columns.size())
+        && dstHeight == static_cast<int>(m_rows.size())) {
+        return;
+    }
+    m_columns = buildTaps(srcWidth, dstWidth);
+    m_rows    = buildTaps(srcHeight, dstHeight);
+    m_srcWidth  = srcWidth;
+    m_srcHeight = srcHeight;
+}
+
+void FrameScaler::scale(const unsigned char* src, int srcWidth, int srcHeight, int srcStride,
+                        unsigned char* dst, int dstWidth, int dstHeight, int dstStride) {
+    if (srcWidth <= 0 || srcHeight <= 0 || dstWidth <= 0 || dstHeight <= 0) {
+        return;
+    }
+
+    if (srcWidth == dstWidth && srcHeight == dstHeight) {
+        m_pool.parallelFor(dstHeight, [&](int begin, int end) {
+            for (int y = begin; y < end; ++y) {
+                std::memcpy(pixelRow(dst, dstStride, y), pixelRow(src, srcStride, y),
+                            static_cast<size_t>(dstWidth) * 4);
+            }
+        });
+        return;
+    }
+
+    buildTables(srcWidth, srcHeight, dstWidth, dstHeight);
+    m_pool.parallelFor(dstHeight, [&](int begin, int end) {
+        if (m_filter == ScaleFilter::Nearest) {
+            scaleNearest(src, srcStride, dst, dstStride, begin, end);
+        } else {
+            scaleBilinear(src, srcStride, dst, dstStride, begin, end);
+        }
+    });
+}
+
+void FrameScaler::scaleNearest(const unsigned char* src, int srcStride,
+                               unsigned char* dst, int dstStride, int rowBegin, int rowEnd) const {
+    const size_t rowBytes = m_columns.size() * 4;
+    for (int y = rowBegin; y < rowEnd; ++y) {
+        uint32_t* out = pixelRow(dst, dstStride, y);
+        // Upscaling repeats source rows; copy the row already produced
+        if (y > rowBegin && m_rows[y].nearest == m_rows[y - 1].nearest) {
+            std::memcpy(out, pixelRow(dst, dstStride, y - 1), rowBytes);
+            continue;
+        }
+        const uint32_t* in = pixelRow(src, srcStride, m_rows[y].nearest);
+        for (size_t x = 0; x < m_columns.size(); ++x) {
+            out[x] = in[m_columns[x].nearest];
+        }
+    }
+}
+
+void FrameScaler::scaleBilinear(const unsigned char* src, int srcStride,
+                                unsigned char* dst, int dstStride, int rowBegin, int rowEnd) const {
+    // Horizontally resampled source rows, reused while consecutive
+    // destination rows fall between the same two source rows
+    const size_t width = m_columns.size();
+    thread_local std::vector<uint32_t> cache;
+    cache.resize(width * 2);
+    uint32_t* upper = cache.data();
+    uint32_t* lower = cache.data() + width;
+    int upperRow = -1;
+    int lowerRow = -1;
+
+    auto resampleRow = [&](int row, uint32_t* out) {
+        const uint32_t* in = pixelRow(src, srcStride, row);
+        for (size_t x = 0; x < width; ++x) {
+            const Tap& tap = m_columns[x];
+            out[x] = blend(in[tap.first], in[tap.second], tap.weight);
+        }
+    };
+
+    for (int y = rowBegin; y < rowEnd; ++y) {
+        const Tap& tap = m_rows[y];
+        if (tap.first != upperRow) {
+            if (tap.first == lowerRow) {
+                std::swap(upper, lower);
+                std::swap(upperRow, lowerRow);
+            } else {
+                resampleRow(tap.first, upper);
+                upperRow = tap.first;
+            }
+        }
+
+        uint32_t* out = pixelRow(dst, dstStride, y);
+        if (tap.weight == 0) {
+            std::memcpy(out, upper, width * 4);
+            continue;
+        }
+        if (tap.second != lowerRow) {
+            resampleRow(tap.second, lower);
+            lowerRow = tap.second;
+        }
+        blendRows(upper, lower, out, width, tap.weight);
+    }
+}
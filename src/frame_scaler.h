@@ -0,0 +1,60 @@
+#ifndef FRAME_SCALER_H
+#define FRAME_SCALER_H
+
+#include <cstdint>
+#include <vector>
+#include "worker_pool.h"
+
+enum class ScaleFilter {
+    Nearest,
+    Bilinear,
+    Sharp       // sharp bilinear; GPU presentation only, bilinear in software
+};
+
+/**
+ * Resamples a BGRA32 frame to another size on the CPU.
+ *
+ * Source coordinates and bilinear weights of every destination column and
+ * row are computed once per size pair and kept in tables, so the inner loops
+ * only load, blend and store.  Destination rows are split across the worker
+ * pool and written straight into the caller's buffer (an XImage, usually).
+ */
+class FrameScaler {
+public:
+    explicit FrameScaler(WorkerPool& pool);
+
+    void setFilter(ScaleFilter filter) { m_filter = filter; }
+    ScaleFilter filter() const { return m_filter; }
+
+    // Strides are in bytes; both images are top row first
+    void scale(const unsigned char* src, int srcWidth, int srcHeight, int srcStride,
+               unsigned char* dst, int dstWidth, int dstHeight, int dstStride);
+
+private:
+    // Source position of one destination column or row: the nearest sample,
+    // and the two bilinear neighbours with the 8-bit weight of the second
+    struct Tap {
+        int nearest;
+        int first;
+        int second;
+        uint32_t weight;
+    };
+
+    void buildTables(int srcWidth, int srcHeight, int dstWidth, int dstHeight);
+    static std::vector<Tap> buildTaps(int srcSize, int dstSize);
+
+    void scaleNearest(const unsigned char* src, int srcStride,
+                      unsigned char* dst, int dstStride, int rowBegin, int rowEnd) const;
+    void scaleBilinear(const unsigned char* src, int srcStride,
+                       unsigned char* dst, int dstStride, int rowBegin, int rowEnd) const;
+
+    WorkerPool& m_pool;
+    ScaleFilter m_filter;
+
+    int m_srcWidth;
+    int m_srcHeight;
+    std::vector<Tap> m_columns;  // one per destination column
+    std::vector<Tap> m_rows;     // one per destination row
+};
+
+#endif // FRAME_SCALER_H
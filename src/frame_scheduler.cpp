@@ -0,0 +1,241 @@
+#include "frame_scheduler.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+namespace {
+
+constexpr double DEFAULT_REFRESH_RATE = 60.0;
+// Audio-driven mode still draws this often when no hops arrive (stalled stream)
+constexpr int AUDIO_WATCHDOG_MS = 100;
+
+int64_t steadyMicroseconds() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+FrameScheduler::FrameScheduler()
+    : m_mode(Mode::VSync), m_refreshRate(DEFAULT_REFRESH_RATE), m_fixedRate(DEFAULT_REFRESH_RATE),
+      m_swapThrottled(false), m_active(false), m_audioPending(false), m_frameSkipped(false),
+      m_intervalHead(0), m_lastPresentUs(0), m_lastFromVblank(false),
+      m_lastMsc(0), m_missedVblanks(0) {
+    m_intervals.reserve(STATS_WINDOW);
+}
+
+void FrameScheduler::setMode(Mode mode) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_mode = mode;
+    m_deadline = Clock::now();
+    m_wake.notify_all();
+}
+
+FrameScheduler::Mode FrameScheduler::mode() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_mode;
+}
+
+void FrameScheduler::setRefreshRate(double hz) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_refreshRate = hz > 0.0 ? hz : DEFAULT_REFRESH_RATE;
+}
+
+void FrameScheduler::setSwapThrottled(bool throttled) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_swapThrottled = throttled;
+}
+
+void FrameScheduler::setFixedRate(double fps) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_fixedRate = std::clamp(fps, 1.0, 1000.0);
+}
+
+void FrameScheduler::start() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_active) return;
+
+    m_active = true;
+    m_audioPending = false;
+    m_frameSkipped = false;
+    m_intervals.clear();
+    m_intervalHead = 0;
+    m_lastPresentUs = 0;
+    m_missedVblanks = 0;
+    m_deadline = Clock::now();
+    std::cout << "Frame scheduling: " << modeName(m_mode);
+    if (m_mode == Mode::VSync) {
+        std::cout << (m_swapThrottled ? " (swap control, " : " (timed, ") << m_refreshRate << " Hz)";
+    } else if (m_mode == Mode::FixedRate) {
+        std::cout << " (" << m_fixedRate << " fps)";
+    }
+    std::cout << std::endl;
+}
+
+void FrameScheduler::stop() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_active) return;
+
+    m_active = false;
+    m_wake.notify_all();
+
+    const FramePacingStats s = statsLocked();
+    if (s.frames > 0) {
+        std::cout << "Frame pacing: mean " << s.meanMs << " ms, jitter " << s.jitterMs
+                  << " ms, worst " << s.worstMs << " ms, " << s.lateFrames << " late of "
+                  << s.frames;
+        if (s.missedVblanks > 0) {
+            std::cout << ", " << s.missedVblanks << " missed vblanks";
+        }
+        std::cout << std::endl;
+    }
+}
+
+bool FrameScheduler::isActive() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_active;
+}
+
+FrameScheduler::Clock::duration FrameScheduler::period() const {
+    const double rate = m_mode == Mode::FixedRate ? m_fixedRate : m_refreshRate;
+    return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / rate));
+}
+
+bool FrameScheduler::waitForFrame() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (!m_active) return false;
+
+    switch (m_mode) {
+    case Mode::AudioDriven:
+        m_wake.wait_for(lock, std::chrono::milliseconds(AUDIO_WATCHDOG_MS),
+                        [this] { return m_audioPending || !m_active; });
+        // Hops that arrived while the last frame was drawn collapse into one
+        m_audioPending = false;
+        return m_active;
+    case Mode::VSync:
+        if (m_swapThrottled) {
+            if (!m_frameSkipped) {
+                // The blocking swap is the clock
+                return true;
+            }
+            // Nothing was swapped, so wait as long as a swap would have
+            m_frameSkipped = false;
+            m_deadline = Clock::now();
+        }
+        break;
+    case Mode::FixedRate:
+        break;
+    case Mode::Unpaced:
+        return true;
+    }
+
+    // Absolute deadlines: sleep rounding evens out instead of accumulating.
+    // A late frame moves the deadline rather than bursting.
+    const Clock::time_point now = Clock::now();
+    m_deadline += period();
+    if (m_deadline < now) {
+        m_deadline = now;
+    }
+    m_wake.wait_until(lock, m_deadline, [this] { return !m_active; });
+    return m_active;
+}
+
+void FrameScheduler::audioHopReady() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_mode != Mode::AudioDriven) return;
+    m_audioPending = true;
+    m_wake.notify_one();
+}
+
+void FrameScheduler::resetTiming() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_deadline = Clock::now();
+    m_audioPending = false;
+    m_lastPresentUs = 0;
+}
+
+void FrameScheduler::frameSkipped() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_frameSkipped = true;
+    m_lastPresentUs = 0;
+}
+
+void FrameScheduler::framePresented(bool hasVblank, int64_t vblankUst, int64_t vblankMsc) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const int64_t now = hasVblank ? vblankUst : steadyMicroseconds();
+
+    // UST and the steady clock need not share an epoch; never mix them
+    if (m_lastPresentUs != 0 && hasVblank == m_lastFromVblank) {
+        const double interval = (now - m_lastPresentUs) / 1000.0;
+        if (m_intervals.size() < STATS_WINDOW) {
+            m_intervals.push_back(interval);
+        } else {
+            m_intervals[m_intervalHead] = interval;
+            m_intervalHead = (m_intervalHead + 1) % STATS_WINDOW;
+        }
+
+        // With swap interval 1 every presented frame advances the counter by one
+        if (hasVblank && m_mode == Mode::VSync && m_swapThrottled && vblankMsc > m_lastMsc + 1) {
+            m_missedVblanks += vblankMsc - m_lastMsc - 1;
+        }
+    }
+    m_lastPresentUs = now;
+    m_lastFromVblank = hasVblank;
+    m_lastMsc = vblankMsc;
+}
+
+FramePacingStats FrameScheduler::stats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return statsLocked();
+}
+
+FramePacingStats FrameScheduler::statsLocked() const {
+    FramePacingStats s;
+    s.missedVblanks = m_missedVblanks;
+    switch (m_mode) {
+    case Mode::VSync:       s.targetMs = 1000.0 / m_refreshRate; break;
+    case Mode::FixedRate:   s.targetMs = 1000.0 / m_fixedRate;   break;
+    case Mode::AudioDriven:
+    case Mode::Unpaced:     break;
+    }
+
+    s.frames = static_cast<int>(m_intervals.size());
+    if (s.frames == 0) {
+        return s;
+    }
+
+    double sum = 0.0;
+    for (double interval : m_intervals) {
+        sum += interval;
+        s.worstMs = std::max(s.worstMs, interval);
+        if (s.targetMs > 0.0 && interval > 1.5 * s.targetMs) {
+            ++s.lateFrames;
+        }
+    }
+    s.meanMs = sum / s.frames;
+
+    double variance = 0.0;
+    for (double interval : m_intervals) {
+        variance += (interval - s.meanMs) * (interval - s.meanMs);
+    }
+    s.jitterMs = std::sqrt(variance / s.frames);
+    return s;
+}
+
+const char* FrameScheduler::modeName(Mode mode) {
+    switch (mode) {
+    case Mode::VSync:       return "vsync";
+    case Mode::AudioDriven: return "audio";
+    case Mode::FixedRate:   return "fixed";
+    case Mode::Unpaced:     return "unpaced";
+    }
+    return "vsync";
+}
+
+FrameScheduler::Mode FrameScheduler::modeFromString(const char* name) {
+    if (std::strcmp(name, "audio") == 0) return Mode::AudioDriven;
+    if (std::strcmp(name, "fixed") == 0) return Mode::FixedRate;
+    if (std::strcmp(name, "unpaced") == 0) return Mode::Unpaced;
+    return Mode::VSync;
+}
@@ -0,0 +1,114 @@
+#ifndef FRAME_SCHEDULER_H
+#define FRAME_SCHEDULER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+/**
+ * Frame pacing over the most recent presented frames.
+ */
+struct FramePacingStats {
+    int frames = 0;              // intervals in the window
+    double targetMs = 0.0;       // 0 when the mode has no fixed period
+    double meanMs = 0.0;
+    double jitterMs = 0.0;       // standard deviation of the interval
+    double worstMs = 0.0;
+    int lateFrames = 0;          // intervals over 1.5x the target
+    long long missedVblanks = 0; // since start, only with GLX_OML_sync_control
+};
+
+/**
+ * Decides when the next frame is rendered.
+ *
+ * VSync      — swaps wait for vblank (GLX swap control), so the next frame
+ *              is started as soon as the previous one is presented.  Without
+ *              swap control it falls back to timing at the refresh rate.
+ * AudioDriven — one frame per analysis hop delivered by the audio thread.
+ * FixedRate  — a fixed frame rate, timed against absolute deadlines so it
+ *              does not drift.
+ * Unpaced    — no pacing at all: every frame is due at once (benchmarks).
+ *
+ * The presentation thread blocks in waitForFrame() until the next frame is
+ * due and reports each presented frame back through framePresented() for
+ * the statistics.  All methods are thread-safe.
+ */
+class FrameScheduler {
+public:
+    enum class Mode {
+        VSync,
+        AudioDriven,
+        FixedRate,
+        Unpaced
+    };
+
+    FrameScheduler();
+
+    void setMode(Mode mode);
+    Mode mode() const;
+
+    // Refresh rate of the display, used by VSync mode; <= 0 means unknown (60 Hz)
+    void setRefreshRate(double hz);
+    // Whether swaps block until vblank, i.e. the swap itself paces VSync mode
+    void setSwapThrottled(bool throttled);
+    void setFixedRate(double fps);
+
+    void start();
+    // Also wakes a thread blocked in waitForFrame()
+    void stop();
+    bool isActive() const;
+
+    // Blocks until the next frame is due; false once the scheduler is stopped
+    bool waitForFrame();
+
+    // The audio thread has fed a new hop to the engine
+    void audioHopReady();
+
+    // Starts the deadlines and frame intervals afresh after a pause, so the
+    // gap is neither caught up on nor counted as a late frame
+    void resetTiming();
+
+    // Called after each presented frame.  vblankUst/vblankMsc come from
+    // GLX_OML_sync_control when available (ust in microseconds); pass
+    // hasVblank = false to time the frame with the steady clock instead.
+    void framePresented(bool hasVblank = false, int64_t vblankUst = 0, int64_t vblankMsc = 0);
+    // Called instead when a frame was dropped as a duplicate and nothing was
+    // swapped: with swap control the next waitForFrame() sleeps for one
+    // refresh period itself, and the gap is not counted as a late frame
+    void frameSkipped();
+
+    FramePacingStats stats() const;
+    static const char* modeName(Mode mode);
+    static Mode modeFromString(const char* name);
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    // Callers hold m_mutex
+    Clock::duration period() const;
+    FramePacingStats statsLocked() const;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wake;  // audio hops and stop()
+    Mode m_mode;
+    double m_refreshRate;
+    double m_fixedRate;
+    bool m_swapThrottled;
+    bool m_active;
+    Clock::time_point m_deadline;
+    bool m_audioPending;
+    bool m_frameSkipped;
+
+    // Ring of recent frame intervals in milliseconds
+    static constexpr size_t STATS_WINDOW = 600;
+    std::vector<double> m_intervals;
+    size_t m_intervalHead;
+    int64_t m_lastPresentUs;   // on the clock the last report used
+    bool m_lastFromVblank;
+    int64_t m_lastMsc;
+    long long m_missedVblanks;
+};
+
+#endif // FRAME_SCHEDULER_H
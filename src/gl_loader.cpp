@@ -0,0 +1,183 @@
+#include "gl_loader.h"
+#include <GL/glx.h>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+template <typename Fn>
+bool resolve(Fn& fn, const char* name) {
+    fn = reinterpret_cast<Fn>(glXGetProcAddressARB(reinterpret_cast<const GLubyte*>(name)));
+    return fn != nullptr;
+}
+
+// Whole-token match in a space-separated extension list
+bool listHas(const char* list, const char* name) {
+    if (!list) {
+        return false;
+    }
+    const size_t length = std::strlen(name);
+    for (const char* p = std::strstr(list, name); p; p = std::strstr(p + length, name)) {
+        const bool startsToken = p == list || p[-1] == ' ';
+        const bool endsToken   = p[length] == ' ' || p[length] == '\0';
+        if (startsToken && endsToken) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Core name first, then the ARB alias exposed by older drivers
+template <typename Fn>
+bool resolve(Fn& fn, const char* name, const char* arbName) {
+    return resolve(fn, name) || resolve(fn, arbName);
+}
+
+} // namespace
+
+bool GLFunctions::load() {
+    const char* version = reinterpret_cast<const char*>(glGetString(GL_VERSION));
+    if (!version || std::sscanf(version, "%d.%d", &majorVersion, &minorVersion) != 2) {
+        return false;
+    }
+
+    if (hasVersion(3, 0)) {
+        resolve(GetStringi, "glGetStringi");
+    }
+    if (hasVersion(3, 2)) {
+        GLint mask = 0;
+        glGetIntegerv(GL_CONTEXT_PROFILE_MASK, &mask);
+        coreProfile = (mask & GL_CONTEXT_CORE_PROFILE_BIT) != 0;
+    }
+
+    if (hasVersion(2, 1) || hasExtension("GL_ARB_pixel_buffer_object")) {
+        m_pixelBuffers = resolve(GenBuffers, "glGenBuffers", "glGenBuffersARB")
+                      && resolve(DeleteBuffers, "glDeleteBuffers", "glDeleteBuffersARB")
+                      && resolve(BindBuffer, "glBindBuffer", "glBindBufferARB")
+                      && resolve(BufferData, "glBufferData", "glBufferDataARB")
+                      && resolve(BufferSubData, "glBufferSubData", "glBufferSubDataARB")
+                      && resolve(UnmapBuffer, "glUnmapBuffer", "glUnmapBufferARB");
+    }
+
+    if (m_pixelBuffers && (hasVersion(3, 0) || hasExtension("GL_ARB_map_buffer_range"))) {
+        m_mapBufferRange = resolve(MapBufferRange, "glMapBufferRange");
+    }
+
+    const bool sync = (hasVersion(3, 2) || hasExtension("GL_ARB_sync"))
+                   && resolve(FenceSync, "glFenceSync")
+                   && resolve(ClientWaitSync, "glClientWaitSync")
+                   && resolve(DeleteSync, "glDeleteSync");
+
+    if (m_mapBufferRange && sync
+        && (hasVersion(4, 4) || hasExtension("GL_ARB_buffer_storage"))) {
+        m_persistentMapping = resolve(BufferStorage, "glBufferStorage");
+    }
+
+    if (hasVersion(4, 2) || hasExtension("GL_ARB_texture_storage")) {
+        m_textureStorage = resolve(TexStorage2D, "glTexStorage2D");
+    }
+
+    if (m_pixelBuffers && hasVersion(2, 1)) {
+        m_shaders = resolve(CreateShader, "glCreateShader")
+                 && resolve(DeleteShader, "glDeleteShader")
+                 && resolve(ShaderSource, "glShaderSource")
+                 && resolve(CompileShader, "glCompileShader")
+                 && resolve(GetShaderiv, "glGetShaderiv")
+                 && resolve(GetShaderInfoLog, "glGetShaderInfoLog")
+                 && resolve(CreateProgram, "glCreateProgram")
+                 && resolve(DeleteProgram, "glDeleteProgram")
+                 && resolve(AttachShader, "glAttachShader")
+                 && resolve(BindAttribLocation, "glBindAttribLocation")
+                 && resolve(LinkProgram, "glLinkProgram")
+                 && resolve(GetProgramiv, "glGetProgramiv")
+                 && resolve(GetProgramInfoLog, "glGetProgramInfoLog")
+                 && resolve(UseProgram, "glUseProgram")
+                 && resolve(GetUniformLocation, "glGetUniformLocation")
+                 && resolve(Uniform1i, "glUniform1i")
+                 && resolve(Uniform1f, "glUniform1f")
+                 && resolve(Uniform2f, "glUniform2f")
+                 && resolve(VertexAttribPointer, "glVertexAttribPointer")
+                 && resolve(EnableVertexAttribArray, "glEnableVertexAttribArray")
+                 && resolve(DisableVertexAttribArray, "glDisableVertexAttribArray")
+                 && resolve(ActiveTexture, "glActiveTexture", "glActiveTextureARB");
+    }
+
+    if (hasVersion(3, 0) || hasExtension("GL_ARB_framebuffer_object")) {
+        m_framebufferObjects = resolve(GenFramebuffers, "glGenFramebuffers")
+                            && resolve(DeleteFramebuffers, "glDeleteFramebuffers")
+                            && resolve(BindFramebuffer, "glBindFramebuffer")
+                            && resolve(FramebufferRenderbuffer, "glFramebufferRenderbuffer")
+                            && resolve(CheckFramebufferStatus, "glCheckFramebufferStatus")
+                            && resolve(GenRenderbuffers, "glGenRenderbuffers")
+                            && resolve(DeleteRenderbuffers, "glDeleteRenderbuffers")
+                            && resolve(BindRenderbuffer, "glBindRenderbuffer")
+                            && resolve(RenderbufferStorage, "glRenderbufferStorage");
+    }
+
+    if (hasVersion(3, 0) || hasExtension("GL_ARB_vertex_array_object")) {
+        m_vertexArrays = resolve(GenVertexArrays, "glGenVertexArrays")
+                      && resolve(BindVertexArray, "glBindVertexArray")
+                      && resolve(DeleteVertexArrays, "glDeleteVertexArrays");
+    }
+
+    return true;
+}
+
+bool GLFunctions::hasVersion(int major, int minor) const {
+    return majorVersion > major || (majorVersion == major && minorVersion >= minor);
+}
+
+bool GLFunctions::hasExtension(const char* name) const {
+    if (GetStringi) {
+        GLint count = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+        for (GLint i = 0; i < count; ++i) {
+            const char* ext = reinterpret_cast<const char*>(GetStringi(GL_EXTENSIONS, i));
+            if (ext && std::strcmp(ext, name) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Legacy contexts: one space-separated string
+    return listHas(reinterpret_cast<const char*>(glGetString(GL_EXTENSIONS)), name);
+}
+
+void GLXFunctions::load(Display* display, int screen) {
+    const char* extensions = glXQueryExtensionsString(display, screen);
+    if (listHas(extensions, "GLX_EXT_swap_control")) {
+        resolve(SwapIntervalEXT, "glXSwapIntervalEXT");
+    }
+    if (listHas(extensions, "GLX_MESA_swap_control")) {
+        resolve(SwapIntervalMESA, "glXSwapIntervalMESA");
+    }
+    if (listHas(extensions, "GLX_SGI_swap_control")) {
+        resolve(SwapIntervalSGI, "glXSwapIntervalSGI");
+    }
+    if (listHas(extensions, "GLX_ARB_create_context")
+        && listHas(extensions, "GLX_ARB_create_context_profile")) {
+        resolve(CreateContextAttribsARB, "glXCreateContextAttribsARB");
+    }
+    if (listHas(extensions, "GLX_OML_sync_control")) {
+        if (!resolve(GetSyncValuesOML, "glXGetSyncValuesOML")
+            || !resolve(GetMscRateOML, "glXGetMscRateOML")) {
+            GetSyncValuesOML = nullptr;
+            GetMscRateOML = nullptr;
+        }
+    }
+}
+
+bool GLXFunctions::setSwapInterval(Display* display, GLXDrawable drawable, int interval) const {
+    if (SwapIntervalEXT) {
+        SwapIntervalEXT(display, drawable, interval);
+        return true;
+    }
+    if (SwapIntervalMESA) {
+        return SwapIntervalMESA(static_cast<unsigned int>(interval)) == 0;
+    }
+    if (SwapIntervalSGI && interval > 0) {  // SGI cannot turn sync off
+        return SwapIntervalSGI(interval) == 0;
+    }
+    return false;
+}
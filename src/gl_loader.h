@@ -0,0 +1,138 @@
+#ifndef GL_LOADER_H
+#define GL_LOADER_H
+
+#include <GL/gl.h>
+#include <GL/glext.h>
+#include <GL/glx.h>
+#include <cstdint>
+
+/**
+ * Entry points beyond OpenGL 1.1 that the desktop renderer uses.
+ *
+ * libGL only exports the 1.1 API directly; everything newer is resolved at
+ * runtime through glXGetProcAddress once a context is current.  Each group
+ * of functions is optional — check the has*() accessors before use and keep
+ * a 1.1 fallback for drivers that lack it.
+ */
+struct GLFunctions {
+    // GL 1.5 / ARB_vertex_buffer_object
+    PFNGLGENBUFFERSPROC      GenBuffers      = nullptr;
+    PFNGLDELETEBUFFERSPROC   DeleteBuffers   = nullptr;
+    PFNGLBINDBUFFERPROC      BindBuffer      = nullptr;
+    PFNGLBUFFERDATAPROC      BufferData      = nullptr;
+    PFNGLBUFFERSUBDATAPROC   BufferSubData   = nullptr;
+    PFNGLUNMAPBUFFERPROC     UnmapBuffer     = nullptr;
+    // GL 3.0 / ARB_map_buffer_range
+    PFNGLMAPBUFFERRANGEPROC  MapBufferRange  = nullptr;
+    // GL 4.4 / ARB_buffer_storage
+    PFNGLBUFFERSTORAGEPROC   BufferStorage   = nullptr;
+    // GL 4.2 / ARB_texture_storage
+    PFNGLTEXSTORAGE2DPROC    TexStorage2D    = nullptr;
+    // GL 3.2 / ARB_sync
+    PFNGLFENCESYNCPROC       FenceSync       = nullptr;
+    PFNGLCLIENTWAITSYNCPROC  ClientWaitSync  = nullptr;
+    PFNGLDELETESYNCPROC      DeleteSync      = nullptr;
+    // GL 3.0, needed to list extensions of core-profile contexts
+    PFNGLGETSTRINGIPROC      GetStringi      = nullptr;
+    // GL 2.0 shaders
+    PFNGLCREATESHADERPROC    CreateShader    = nullptr;
+    PFNGLDELETESHADERPROC    DeleteShader    = nullptr;
+    PFNGLSHADERSOURCEPROC    ShaderSource    = nullptr;
+    PFNGLCOMPILESHADERPROC   CompileShader   = nullptr;
+    PFNGLGETSHADERIVPROC     GetShaderiv     = nullptr;
+    PFNGLGETSHADERINFOLOGPROC GetShaderInfoLog = nullptr;
+    PFNGLCREATEPROGRAMPROC   CreateProgram   = nullptr;
+    PFNGLDELETEPROGRAMPROC   DeleteProgram   = nullptr;
+    PFNGLATTACHSHADERPROC    AttachShader    = nullptr;
+    PFNGLBINDATTRIBLOCATIONPROC BindAttribLocation = nullptr;
+    PFNGLLINKPROGRAMPROC     LinkProgram     = nullptr;
+    PFNGLGETPROGRAMIVPROC    GetProgramiv    = nullptr;
+    PFNGLGETPROGRAMINFOLOGPROC GetProgramInfoLog = nullptr;
+    PFNGLUSEPROGRAMPROC      UseProgram      = nullptr;
+    PFNGLGETUNIFORMLOCATIONPROC GetUniformLocation = nullptr;
+    PFNGLUNIFORM1IPROC       Uniform1i       = nullptr;
+    PFNGLUNIFORM1FPROC       Uniform1f       = nullptr;
+    PFNGLUNIFORM2FPROC       Uniform2f       = nullptr;
+    PFNGLVERTEXATTRIBPOINTERPROC VertexAttribPointer = nullptr;
+    PFNGLENABLEVERTEXATTRIBARRAYPROC EnableVertexAttribArray = nullptr;
+    PFNGLDISABLEVERTEXATTRIBARRAYPROC DisableVertexAttribArray = nullptr;
+    PFNGLACTIVETEXTUREPROC   ActiveTexture   = nullptr;
+    // GL 3.0 / ARB_framebuffer_object
+    PFNGLGENFRAMEBUFFERSPROC         GenFramebuffers         = nullptr;
+    PFNGLDELETEFRAMEBUFFERSPROC      DeleteFramebuffers      = nullptr;
+    PFNGLBINDFRAMEBUFFERPROC         BindFramebuffer         = nullptr;
+    PFNGLFRAMEBUFFERRENDERBUFFERPROC FramebufferRenderbuffer = nullptr;
+    PFNGLCHECKFRAMEBUFFERSTATUSPROC  CheckFramebufferStatus  = nullptr;
+    PFNGLGENRENDERBUFFERSPROC        GenRenderbuffers        = nullptr;
+    PFNGLDELETERENDERBUFFERSPROC     DeleteRenderbuffers     = nullptr;
+    PFNGLBINDRENDERBUFFERPROC        BindRenderbuffer        = nullptr;
+    PFNGLRENDERBUFFERSTORAGEPROC     RenderbufferStorage     = nullptr;
+    // GL 3.0 / ARB_vertex_array_object — mandatory in core profiles
+    PFNGLGENVERTEXARRAYSPROC    GenVertexArrays    = nullptr;
+    PFNGLBINDVERTEXARRAYPROC    BindVertexArray    = nullptr;
+    PFNGLDELETEVERTEXARRAYSPROC DeleteVertexArrays = nullptr;
+
+    int majorVersion = 0;
+    int minorVersion = 0;
+    bool coreProfile = false;
+
+    // Resolves everything the current context offers; false if no context
+    // is current or its version string cannot be read.
+    bool load();
+
+    bool hasExtension(const char* name) const;
+    bool hasVersion(int major, int minor) const;
+
+    // Pixel unpack buffers for asynchronous texture uploads
+    bool hasPixelBuffers() const { return m_pixelBuffers; }
+    // glMapBufferRange with invalidate/unsynchronized flags
+    bool hasMapBufferRange() const { return m_mapBufferRange; }
+    // Persistently mapped, coherent buffers plus fences to guard them
+    bool hasPersistentMapping() const { return m_persistentMapping; }
+    // Immutable texture storage
+    bool hasTextureStorage() const { return m_textureStorage; }
+    // GLSL programs fed from vertex buffers (GL 2.1)
+    bool hasShaders() const { return m_shaders; }
+    bool hasVertexArrays() const { return m_vertexArrays; }
+    // Offscreen render targets
+    bool hasFramebufferObjects() const { return m_framebufferObjects; }
+
+private:
+    bool m_pixelBuffers = false;
+    bool m_mapBufferRange = false;
+    bool m_persistentMapping = false;
+    bool m_textureStorage = false;
+    bool m_shaders = false;
+    bool m_vertexArrays = false;
+    bool m_framebufferObjects = false;
+};
+
+/**
+ * GLX extensions: context creation with a version and profile, swap control
+ * to lock swaps to vblank, and OML sync control for the time and counter of
+ * each vblank.  load() needs no current context.
+ */
+struct GLXFunctions {
+    // GLX_EXT_swap_control, GLX_MESA_swap_control, GLX_SGI_swap_control
+    PFNGLXSWAPINTERVALEXTPROC  SwapIntervalEXT  = nullptr;
+    PFNGLXSWAPINTERVALMESAPROC SwapIntervalMESA = nullptr;
+    PFNGLXSWAPINTERVALSGIPROC  SwapIntervalSGI  = nullptr;
+    // GLX_OML_sync_control
+    PFNGLXGETSYNCVALUESOMLPROC GetSyncValuesOML = nullptr;
+    PFNGLXGETMSCRATEOMLPROC    GetMscRateOML    = nullptr;
+    // GLX_ARB_create_context with GLX_ARB_create_context_profile
+    PFNGLXCREATECONTEXTATTRIBSARBPROC CreateContextAttribsARB = nullptr;
+
+    // Resolves what the screen's GLX implementation advertises
+    void load(Display* display, int screen);
+
+    // Sets the swap interval of drawable (must be current), trying the EXT,
+    // MESA and SGI variants in that order
+    bool setSwapInterval(Display* display, GLXDrawable drawable, int interval) const;
+
+    bool hasSwapControl() const { return SwapIntervalEXT || SwapIntervalMESA || SwapIntervalSGI; }
+    bool hasSyncControl() const { return GetSyncValuesOML != nullptr; }
+    bool hasCreateContext() const { return CreateContextAttribsARB != nullptr; }
+};
+
+#endif // GL_LOADER_H
@@ -3,6 +3,7 @@
 #include <QGridLayout>
 #include <QGroupBox>
 #include <QMessageBox>
+#include <algorithm>
 
 ControlPanel::ControlPanel(Settings* settings, QWidget* parent)
     : QWidget(parent), m_settings(settings), m_isRunning(false) {
@@ -38,6 +39,11 @@ void ControlPanel::setupUI() {
     QGroupBox* visualGroup = new QGroupBox("Visualization", this);
     QVBoxLayout* visualLayout = new QVBoxLayout(visualGroup);
     
+    m_monitorLabel = new QLabel("Monitor:", visualGroup);
+    m_monitorCombo = new QComboBox(visualGroup);
+    m_monitorLabel->hide();
+    m_monitorCombo->hide();
+    
     QLabel* pluginLabel = new QLabel("Visual Plugin:", visualGroup);
     m_visualPluginCombo = new QComboBox(visualGroup);
     
@@ -46,6 +52,8 @@ void ControlPanel::setupUI() {
     m_autoSwitchSpin->setRange(5, 300);
     m_autoSwitchSpin->setValue(m_settings->getAutoSwitchInterval());
     
+    visualLayout->addWidget(m_monitorLabel);
+    visualLayout->addWidget(m_monitorCombo);
     visualLayout->addWidget(pluginLabel);
     visualLayout->addWidget(m_visualPluginCombo);
     visualLayout->addWidget(autoSwitchLabel);
@@ -90,9 +98,12 @@ void ControlPanel::setupTrayIcon() {
     
     m_trayMenu = new QMenu(this);
     m_showAction = new QAction("Show Control Panel", this);
+    m_overlayAction = new QAction("Performance Overlay", this);
+    m_overlayAction->setCheckable(true);
     m_quitAction = new QAction("Quit", this);
     
     m_trayMenu->addAction(m_showAction);
+    m_trayMenu->addAction(m_overlayAction);
     m_trayMenu->addSeparator();
     m_trayMenu->addAction(m_quitAction);
     
@@ -110,6 +121,9 @@ void ControlPanel::createConnections() {
     connect(m_visualPluginCombo, QOverload<int>::of(&QComboBox::currentIndexChanged),
             this, &ControlPanel::onVisualPluginChanged);
     
+    connect(m_monitorCombo, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &ControlPanel::onMonitorChanged);
+    
     connect(m_autoSwitchSpin, QOverload<int>::of(&QSpinBox::valueChanged),
             this, &ControlPanel::onAutoSwitchChanged);
     
@@ -120,6 +134,7 @@ void ControlPanel::createConnections() {
             this, &ControlPanel::onTrayIconActivated);
     
     connect(m_showAction, &QAction::triggered, this, &ControlPanel::showControlPanel);
+    connect(m_overlayAction, &QAction::toggled, this, &ControlPanel::perfOverlayToggled);
     connect(m_quitAction, &QAction::triggered, this, &ControlPanel::quitApplication);
 }
 
@@ -141,6 +156,29 @@ void ControlPanel::updatePluginList(const std::vector<std::string>& plugins) {
     m_visualPluginCombo->setCurrentIndex(currentIndex);
 }
 
+void ControlPanel::updateMonitorList(const std::vector<std::string>& monitors) {
+    m_monitorCombo->blockSignals(true);
+    m_monitorCombo->clear();
+    for (const auto& monitor : monitors) {
+        m_monitorCombo->addItem(QString::fromStdString(monitor));
+    }
+    m_monitorCombo->setCurrentIndex(0);
+    m_monitorCombo->blockSignals(false);
+    
+    const bool multiple = monitors.size() > 1;
+    m_monitorLabel->setVisible(multiple);
+    m_monitorCombo->setVisible(multiple);
+}
+
+void ControlPanel::setCurrentPlugin(const QString& plugin) {
+    const int index = m_visualPluginCombo->findText(plugin);
+    if (index >= 0) {
+        m_visualPluginCombo->blockSignals(true);
+        m_visualPluginCombo->setCurrentIndex(index);
+        m_visualPluginCombo->blockSignals(false);
+    }
+}
+
 void ControlPanel::updateAudioDeviceList(const std::vector<std::string>& devices) {
     m_audioDeviceCombo->clear();
     
@@ -170,6 +208,12 @@ void ControlPanel::updateEngineInfo(const QString& engineName) {
     }
 }
 
+void ControlPanel::setPerfOverlayVisible(bool visible) {
+    m_overlayAction->blockSignals(true);
+    m_overlayAction->setChecked(visible);
+    m_overlayAction->blockSignals(false);
+}
+
 void ControlPanel::onAudioDeviceChanged() {
     QString device = m_audioDeviceCombo->currentText();
     m_settings->setAudioDevice(device);
@@ -178,8 +222,16 @@ void ControlPanel::onAudioDeviceChanged() {
 
 void ControlPanel::onVisualPluginChanged() {
     QString plugin = m_visualPluginCombo->currentText();
-    m_settings->setVisualPlugin(plugin);
-    emit visualPluginChanged(plugin);
+    const int monitor = std::max(0, m_monitorCombo->currentIndex());
+    // The saved plugin is the primary monitor's
+    if (monitor == 0) {
+        m_settings->setVisualPlugin(plugin);
+    }
+    emit visualPluginChanged(monitor, plugin);
+}
+
+void ControlPanel::onMonitorChanged() {
+    emit monitorSelected(std::max(0, m_monitorCombo->currentIndex()));
 }
 
 void ControlPanel::onAutoSwitchChanged() {
@@ -26,19 +26,28 @@ public:
     ~ControlPanel();
 
     void updatePluginList(const std::vector<std::string>& plugins);
+    // One entry per monitor; the selector is hidden with a single monitor
+    void updateMonitorList(const std::vector<std::string>& monitors);
+    // Shows the plugin of the selected monitor without emitting a change
+    void setCurrentPlugin(const QString& plugin);
     void updateAudioDeviceList(const std::vector<std::string>& devices);
     void updateEngineInfo(const QString& engineName);
+    // Checks the overlay entry without emitting a change
+    void setPerfOverlayVisible(bool visible);
 
 signals:
     void audioDeviceChanged(const QString& device);
-    void visualPluginChanged(const QString& plugin);
+    void visualPluginChanged(int monitor, const QString& plugin);
+    void monitorSelected(int monitor);
     void autoSwitchIntervalChanged(int seconds);
+    void perfOverlayToggled(bool visible);
     void startVisualization();
     void stopVisualization();
 
 private slots:
     void onAudioDeviceChanged();
     void onVisualPluginChanged();
+    void onMonitorChanged();
     void onAutoSwitchChanged();
     void onStartClicked();
     void onStopClicked();
@@ -57,6 +66,8 @@ private:
     QVBoxLayout* m_mainLayout;
     QComboBox* m_audioDeviceCombo;
     QComboBox* m_visualPluginCombo;
+    QLabel* m_monitorLabel;
+    QComboBox* m_monitorCombo;
     QSpinBox* m_autoSwitchSpin;
     QPushButton* m_startButton;
     QPushButton* m_stopButton;
@@ -66,6 +77,7 @@ private:
     QSystemTrayIcon* m_trayIcon;
     QMenu* m_trayMenu;
     QAction* m_showAction;
+    QAction* m_overlayAction;
     QAction* m_quitAction;
     
     bool m_isRunning;
@@ -0,0 +1,160 @@
+#include "headless_benchmark.h"
+#include "audio_input.h"
+#include "desktop_renderer.h"
+#include "frame_scheduler.h"
+#include "render_pipeline.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace {
+
+// Capture hop the audio thread would deliver: 512 stereo frames at 44.1 kHz
+constexpr size_t AUDIO_HOP = 1024;
+constexpr double SAMPLE_RATE = 44100.0;
+// Give up when no frame has been presented for this long
+constexpr std::chrono::seconds STALL_TIMEOUT(10);
+
+// Same signal every run: a bass pulse at 120 BPM under a slow sweep and a
+// fixed chord, so engines see beats and moving spectra
+void synthesizeHop(std::vector<float>& hop, uint64_t& sampleIndex) {
+    constexpr double TWO_PI = 6.283185307179586;
+    for (size_t i = 0; i < hop.size(); i += 2, ++sampleIndex) {
+        const double t = sampleIndex / SAMPLE_RATE;
+        const double beat = std::exp(-12.0 * std::fmod(t, 0.5));
+        const double sweep = 200.0 + 1800.0 * (0.5 + 0.5 * std::sin(TWO_PI * 0.1 * t));
+        const double left = 0.5 * beat * std::sin(TWO_PI * 55.0 * t)
+                          + 0.2 * std::sin(TWO_PI * sweep * t)
+                          + 0.1 * std::sin(TWO_PI * 440.0 * t);
+        const double right = left + 0.1 * std::sin(TWO_PI * 660.0 * t);
+        hop[i] = static_cast<float>(left);
+        hop[i + 1] = static_cast<float>(right);
+    }
+}
+
+void printStage(const StageStats& stats, Stage stage) {
+    const StageSummary s = stats.summary(stage);
+    if (s.frames == 0) {
+        return;
+    }
+    std::printf("  %-9s %8lld %9.3f %9.3f %9.3f %9.3f\n", StageStats::stageName(stage),
+                s.frames, s.meanMs, s.p50Ms, s.p95Ms, s.worstMs);
+}
+
+} // namespace
+
+int runHeadlessBenchmark(const HeadlessOptions& options) {
+    std::unique_ptr<VisualizationEngine> engine = VisualizationFactory::createEngine(options.engineType);
+    if (!engine) {
+        std::cerr << "Failed to create visualization engine" << std::endl;
+        return 1;
+    }
+
+    DesktopRenderer renderer;
+    renderer.setScaleFilter(options.scaleFilter);
+    renderer.setGamma(options.gamma);
+    renderer.setOutputChecksum(options.checksum);
+    renderer.setOverlayVisible(options.overlay);
+    if (!renderer.initializeHeadless(options.width, options.height)) {
+        std::cerr << "Failed to initialize headless renderer" << std::endl;
+        return 1;
+    }
+    if (!engine->initialize(options.width, options.height)) {
+        std::cerr << "Failed to initialize visualizer" << std::endl;
+        return 1;
+    }
+
+    std::string plugin = options.plugin;
+    if (plugin.empty()) {
+        const std::vector<std::string> plugins = engine->getAvailablePlugins();
+        if (plugins.empty()) {
+            std::cerr << "No visualization plugins found" << std::endl;
+            return 1;
+        }
+        plugin = plugins.front();
+    }
+    if (!engine->loadPlugin(plugin)) {
+        std::cerr << "Failed to load visualization plugin: " << plugin << std::endl;
+        return 1;
+    }
+
+    FrameScheduler scheduler;
+    if (options.fps > 0.0) {
+        scheduler.setMode(FrameScheduler::Mode::FixedRate);
+        scheduler.setFixedRate(options.fps);
+    } else {
+        scheduler.setMode(FrameScheduler::Mode::Unpaced);
+    }
+
+    // Never initialized: audio comes from the synthesizer below
+    AudioInput audio;
+    RenderPipeline pipeline(*engine, renderer, scheduler, audio);
+    pipeline.setRenderScale(options.renderScale, options.frameBudget);
+    pipeline.setEngineRate(options.engineRate);
+    pipeline.setPluginName(plugin);
+    // The presentation thread stops itself after exactly this many frames
+    pipeline.setFrameLimit(static_cast<uint64_t>(std::max(options.frames, 1)));
+
+    std::cout << "Headless benchmark: " << engine->getEngineName() << " / " << plugin << ", "
+              << options.width << "x" << options.height << ", " << options.frames << " frames"
+              << std::endl;
+
+    std::vector<float> hop(AUDIO_HOP);
+    uint64_t sampleIndex = 0;
+    const auto hopDuration = std::chrono::duration<double>(AUDIO_HOP / 2 / SAMPLE_RATE);
+
+    const auto begin = std::chrono::steady_clock::now();
+    auto nextHop = begin;
+    auto lastProgress = begin;
+    long long lastPresented = 0;
+    pipeline.start();
+
+    // Audio arrives in real time, as from a capture device; between hops
+    // this thread waits for the frame limit, so it notices it at once
+    while (true) {
+        // Frames skipped as unchanged count as shown
+        const long long presented = pipeline.stageStats().summary(Stage::Present).frames +
+                                    static_cast<long long>(pipeline.skippedFrames());
+        const auto now = std::chrono::steady_clock::now();
+        if (presented != lastPresented) {
+            lastPresented = presented;
+            lastProgress = now;
+        } else if (now - lastProgress > STALL_TIMEOUT) {
+            std::cerr << "No frame presented for " << STALL_TIMEOUT.count() << " s, giving up" << std::endl;
+            break;
+        }
+
+        synthesizeHop(hop, sampleIndex);
+        pipeline.feedAudio(hop.data(), hop.size());
+        nextHop += std::chrono::duration_cast<std::chrono::steady_clock::duration>(hopDuration);
+        if (pipeline.waitForFrameLimit(nextHop)) {
+            break;
+        }
+    }
+
+    pipeline.stop();
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+
+    const StageStats& stats = pipeline.stageStats();
+    const long long presented = stats.summary(Stage::Present).frames;
+    const long long skipped = static_cast<long long>(pipeline.skippedFrames());
+    std::printf("%lld frames in %.2f s: %.1f fps, %lld more skipped as unchanged\n", presented,
+                elapsed.count(), elapsed.count() > 0.0 ? presented / elapsed.count() : 0.0, skipped);
+    std::printf("  %-9s %8s %9s %9s %9s %9s   (ms, last 600 frames)\n",
+                "stage", "frames", "mean", "p50", "p95", "worst");
+    for (Stage stage : {Stage::Audio, Stage::Engine, Stage::Upload, Stage::Present, Stage::Overlay,
+                        Stage::Readback}) {
+        printStage(stats, stage);
+    }
+    if (options.checksum) {
+        std::printf("Output checksum: %016llx\n", static_cast<unsigned long long>(renderer.outputChecksum()));
+    }
+    std::fflush(stdout);
+
+    renderer.shutdown();
+    return presented + skipped > 0 ? 0 : 1;
+}
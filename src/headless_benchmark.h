@@ -0,0 +1,40 @@
+#ifndef HEADLESS_BENCHMARK_H
+#define HEADLESS_BENCHMARK_H
+
+#include <string>
+#include "frame_scaler.h"
+#include "visualization_factory.h"
+
+struct HeadlessOptions {
+    VisualizationFactory::EngineType engineType = VisualizationFactory::EngineType::AUTO;
+    std::string plugin;        // empty: the engine's first plugin
+    int width = 1280;
+    int height = 720;
+    int frames = 600;
+    double fps = 0.0;          // 0: as fast as the pipeline goes
+    bool checksum = false;
+    ScaleFilter scaleFilter = ScaleFilter::Bilinear;
+    float gamma = 1.0f;
+    double renderScale = 1.0;  // as RenderPipeline::setRenderScale
+    double frameBudget = 0.0;
+    double engineRate = 0.0;   // as RenderPipeline::setEngineRate
+    bool overlay = false;      // draw the performance overlay, to time it
+};
+
+/**
+ * Runs the normal engine → upload → present pipeline without a display
+ * (DesktopRenderer::initializeHeadless) on synthetic audio, for the given
+ * number of presented frames, then prints the time spent in each stage and,
+ * if asked for, a checksum of everything presented.  Needs neither X nor
+ * PulseAudio, so it runs on build servers.
+ *
+ * The pipeline presents the newest engine frame and audio arrives in real
+ * time, so checksums repeat only for output that does not depend on timing
+ * (a fixed --fps the machine sustains helps); compare them between runs on
+ * the same machine and rendering path.
+ *
+ * Returns the process exit code: non-zero when nothing could be rendered.
+ */
+int runHeadlessBenchmark(const HeadlessOptions& options);
+
+#endif // HEADLESS_BENCHMARK_H
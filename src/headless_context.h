@@ -0,0 +1,31 @@
+#ifndef HEADLESS_CONTEXT_H
+#define HEADLESS_CONTEXT_H
+
+/**
+ * An OpenGL context that needs no display server: EGL on Mesa's surfaceless
+ * platform (llvmpipe renders on any machine), or on the default EGL display
+ * with a 1x1 pbuffer where surfaceless contexts are not offered.  There is
+ * no default framebuffer worth drawing to; render into an FBO.
+ *
+ * Only available when built with EGL (HAVE_EGL); create() fails otherwise.
+ */
+class HeadlessContext {
+public:
+    HeadlessContext();
+    ~HeadlessContext();
+
+    // Core profile 3.3 where offered, the driver's default context otherwise
+    bool create();
+    void destroy();
+
+    bool makeCurrent();
+    void release();
+
+private:
+    // EGLDisplay, EGLSurface and EGLContext, which are opaque pointers
+    void* m_display;
+    void* m_surface;
+    void* m_context;
+};
+
+#endif // HEADLESS_CONTEXT_H
@@ -1,12 +1,15 @@
 #include <QApplication>
 #include <QTimer>
-#include <QThread>
 
 #include "settings.h"
 #include "visualization_engine.h"
 #include "visualization_factory.h"
 #include "audio_input.h"
 #include "desktop_renderer.h"
+#include "frame_scheduler.h"
+#include "render_pipeline.h"
+#include "activity_monitor.h"
+#include "headless_benchmark.h"
 #include "gui.h"
 
 #ifdef HAVE_PROJECTM
@@ -16,6 +19,8 @@
 #include <iostream>
 #include <memory>
 #include <csignal>
+#include <cstdio>
+#include <cstdlib>
 #include <libvisual/libvisual.h>
 
 class VisualizationApp : public QObject {
@@ -24,14 +29,17 @@ class VisualizationApp : public QObject {
 public:
     VisualizationApp(VisualizationFactory::EngineType engineType = VisualizationFactory::EngineType::AUTO, 
                      QObject* parent = nullptr) 
-        : QObject(parent), m_running(false), m_engineType(engineType) {
+        : QObject(parent), m_scaleFilter(ScaleFilter::Bilinear), m_gamma(1.0f),
+          m_frameMode(FrameScheduler::Mode::VSync), m_fixedRate(60.0),
+          m_renderScale(0.0), m_frameBudget(0.0), m_engineRate(0.0),
+          m_perfOverlay(false), m_running(false), m_audioCorked(false), m_engineType(engineType) {
         m_settings = std::make_unique<Settings>();
         m_audioInput = std::make_unique<AudioInput>();
-        m_renderer = std::make_unique<DesktopRenderer>();
         
-        // Setup render timer
-        m_renderTimer = new QTimer(this);
-        connect(m_renderTimer, &QTimer::timeout, this, &VisualizationApp::renderFrame);
+        // Suspends outputs nobody can see
+        m_activityMonitor = new ActivityMonitor(this);
+        connect(m_activityMonitor, &ActivityMonitor::suspendedChanged,
+                this, &VisualizationApp::setOutputSuspended);
         
         // Setup auto-switch timer
         m_autoSwitchTimer = new QTimer(this);
@@ -43,45 +51,40 @@ public:
     }
 
     bool initialize() {
-        // Create visualizer now (after libvisual_init in main)
-        m_visualizer = VisualizationFactory::createEngine(m_engineType);
-        if (!m_visualizer) {
-            std::cerr << "Failed to create visualization engine" << std::endl;
-            return false;
-        }
-        std::cout << "Using " << m_visualizer->getEngineName() << " visualization engine" << std::endl;
-        
-        // Get screen size
-        int screenWidth, screenHeight;
-        if (!m_renderer->initialize()) {
-            std::cerr << "Failed to initialize desktop renderer" << std::endl;
-            return false;
+        // One background window and engine per monitor; the whole screen
+        // when XRandR cannot tell the monitors apart
+        const std::vector<MonitorInfo> monitors = DesktopRenderer::enumerateMonitors();
+        if (monitors.empty()) {
+            auto output = std::make_unique<Output>();
+            output->name = "screen";
+            if (initializeOutput(*output, nullptr)) {
+                output->renderer->getScreenSize(output->width, output->height);
+                m_outputs.push_back(std::move(output));
+            }
         }
-        
-        m_renderer->getScreenSize(screenWidth, screenHeight);
-        m_settings->setWindowSize(screenWidth, screenHeight);
-
-        // For projectM: hand it our GLX context so it can render directly into
-        // the desktop window without a GPU→CPU readback round-trip.
-#ifdef HAVE_PROJECTM
-        if (m_renderer->hasGLContext()) {
-            auto* pmViz = dynamic_cast<ProjectMVisualizer*>(m_visualizer.get());
-            if (pmViz) {
-                pmViz->setGLContext(m_renderer->getDisplay(),
-                                    m_renderer->getWindow(),
-                                    m_renderer->getGLContext());
+        for (const MonitorInfo& monitor : monitors) {
+            auto output = std::make_unique<Output>();
+            output->name = monitor.name;
+            output->x = monitor.x;
+            output->y = monitor.y;
+            output->width = monitor.width;
+            output->height = monitor.height;
+            if (initializeOutput(*output, &monitor)) {
+                m_outputs.push_back(std::move(output));
+            } else {
+                std::cerr << "Skipping monitor " << monitor.name << std::endl;
             }
         }
-#endif
-
-        // Initialize visualizer
-        if (!m_visualizer->initialize(screenWidth, screenHeight)) {
-            std::cerr << "Failed to initialize visualizer" << std::endl;
+        if (m_outputs.empty()) {
             return false;
         }
 
+        int screenWidth, screenHeight;
+        m_outputs[0]->renderer->getScreenSize(screenWidth, screenHeight);
+        m_settings->setWindowSize(screenWidth, screenHeight);
+
         // Get available plugins and load default
-        m_availablePlugins = m_visualizer->getAvailablePlugins();
+        m_availablePlugins = m_outputs[0]->engine->getAvailablePlugins();
         if (m_availablePlugins.empty()) {
             std::cerr << "No visualization plugins found" << std::endl;
             return false;
@@ -89,25 +92,48 @@ public:
 
         // Load default plugin
         std::string defaultPlugin = m_settings->getVisualPlugin().toStdString();
+        size_t defaultIndex = 0;
         bool pluginFound = false;
-        for (const auto& plugin : m_availablePlugins) {
-            if (plugin == defaultPlugin) {
+        for (size_t i = 0; i < m_availablePlugins.size(); ++i) {
+            if (m_availablePlugins[i] == defaultPlugin) {
+                defaultIndex = i;
                 pluginFound = true;
                 break;
             }
         }
 
-        if (!pluginFound && !m_availablePlugins.empty()) {
+        if (!pluginFound) {
             defaultPlugin = m_availablePlugins[0];
             m_settings->setVisualPlugin(QString::fromStdString(defaultPlugin));
         }
 
-        if (!m_visualizer->loadPlugin(defaultPlugin)) {
-            std::cerr << "Failed to load visualization plugin: " << defaultPlugin << std::endl;
-            return false;
-        }
+        // The primary monitor shows the saved plugin, the others the ones
+        // after it, so no two monitors start out the same
+        for (size_t i = 0; i < m_outputs.size(); ++i) {
+            Output& output = *m_outputs[i];
+            output.pluginIndex = (defaultIndex + i) % m_availablePlugins.size();
+            const std::string& plugin = m_availablePlugins[output.pluginIndex];
+            if (!output.engine->loadPlugin(plugin)) {
+                std::cerr << "Failed to load visualization plugin: " << plugin << std::endl;
+                return false;
+            }
 
-        m_currentPluginIndex = 0;
+            // From here on the engine is driven by the pipeline's threads
+            output.pipeline = std::make_unique<RenderPipeline>(*output.engine, *output.renderer,
+                                                               *output.scheduler, *m_audioInput);
+
+            // Default budget: most of one engine period, which is one refresh
+            // period of this monitor unless the engine has a rate of its own
+            double budget = m_frameBudget;
+            if (budget <= 0.0) {
+                const double refresh = output.renderer->getRefreshRate();
+                const double rate = m_engineRate > 0.0 ? m_engineRate : (refresh > 0.0 ? refresh : 60.0);
+                budget = 0.8 * 1000.0 / rate;
+            }
+            output.pipeline->setRenderScale(m_renderScale, budget);
+            output.pipeline->setEngineRate(m_engineRate);
+            output.pipeline->setPluginName(plugin);
+        }
 
         // Initialize audio input
         std::string audioDevice = m_settings->getAudioDevice().toStdString();
@@ -116,26 +142,73 @@ public:
             return false;
         }
 
-        // Set audio callback
+        // Without the monitor everything simply keeps rendering
+        if (m_activityMonitor->initialize()) {
+            for (const auto& output : m_outputs) {
+                m_activityMonitor->addOutput(output->name, output->renderer->getWindow(),
+                                             output->x, output->y, output->width, output->height);
+            }
+        }
+
+        // One capture feeds every monitor's engine
         m_audioInput->setAudioCallback([this](const float* data, size_t samples) {
-            m_visualizer->processAudio(data, samples);
+            for (const auto& output : m_outputs) {
+                output->pipeline->feedAudio(data, samples);
+            }
         });
 
         return true;
     }
 
+    // Must be called before initialize()
+    void setScaleFilter(ScaleFilter filter, float gamma) {
+        m_scaleFilter = filter;
+        m_gamma = gamma;
+    }
+
+    // Must be called before initialize().  scale in (0, 1] fixes the engine
+    // resolution relative to the monitor, 0 adapts it to budgetMs per frame
+    // (0 = 80% of the refresh period).
+    void setRenderScale(double scale, double budgetMs) {
+        m_renderScale = scale;
+        m_frameBudget = budgetMs;
+    }
+
+    // Must be called before initialize().  fps > 0 renders the engine at that
+    // rate and interpolates between its frames at the display rate.
+    void setEngineRate(double fps) {
+        m_engineRate = fps;
+    }
+
+    // Must be called before initialize(); the tray menu toggles it later
+    void setPerfOverlay(bool visible) {
+        m_perfOverlay = visible;
+    }
+
+    // Must be called before initialize(), which sets up swap control for it
+    void setFrameMode(FrameScheduler::Mode mode, double fixedRate) {
+        m_frameMode = mode;
+        m_fixedRate = fixedRate;
+    }
+
     void createGUI() {
         m_controlPanel = std::make_unique<ControlPanel>(m_settings.get());
         
         // Update GUI with available options
         m_controlPanel->updatePluginList(m_availablePlugins);
         m_controlPanel->updateAudioDeviceList(m_audioInput->getAvailableDevices());
+        std::vector<std::string> monitorNames;
+        for (const auto& output : m_outputs) {
+            monitorNames.push_back(output->name);
+        }
+        m_controlPanel->updateMonitorList(monitorNames);
         
         // Update engine info
-        if (m_visualizer) {
-            QString engineName = QString::fromStdString(m_visualizer->getEngineName());
+        if (!m_outputs.empty()) {
+            QString engineName = QString::fromStdString(m_outputs[0]->engine->getEngineName());
             m_controlPanel->updateEngineInfo(engineName);
         }
+        m_controlPanel->setPerfOverlayVisible(m_perfOverlay);
         
         // Connect signals
         connect(m_controlPanel.get(), &ControlPanel::startVisualization,
@@ -144,61 +217,69 @@ public:
                 this, &VisualizationApp::stopVisualization);
         connect(m_controlPanel.get(), &ControlPanel::visualPluginChanged,
                 this, &VisualizationApp::changePlugin);
+        connect(m_controlPanel.get(), &ControlPanel::monitorSelected,
+                this, &VisualizationApp::showMonitorPlugin);
         connect(m_controlPanel.get(), &ControlPanel::audioDeviceChanged,
                 this, &VisualizationApp::changeAudioDevice);
         connect(m_controlPanel.get(), &ControlPanel::autoSwitchIntervalChanged,
                 this, &VisualizationApp::changeAutoSwitchInterval);
+        connect(m_controlPanel.get(), &ControlPanel::perfOverlayToggled,
+                this, &VisualizationApp::showPerfOverlay);
     }
 
 public slots:
     void startVisualization() {
         if (m_running) return;
 
-        m_audioInput->start();
-        m_renderTimer->start(16); // ~60 FPS
+        m_running = true;
+        updateAudioCork();
+        for (const auto& output : m_outputs) {
+            output->pipeline->start();
+        }
         
         int interval = m_settings->getAutoSwitchInterval();
         if (interval > 0) {
             m_autoSwitchTimer->start(interval * 1000);
         }
         
-        m_running = true;
         std::cout << "Visualization started" << std::endl;
     }
 
     void stopVisualization() {
         if (!m_running) return;
 
+        for (const auto& output : m_outputs) {
+            output->pipeline->stop();
+        }
         m_audioInput->stop();
-        m_renderTimer->stop();
         m_autoSwitchTimer->stop();
         
         m_running = false;
+        m_audioCorked = false;
         std::cout << "Visualization stopped" << std::endl;
     }
 
-    void changePlugin(const QString& pluginName) {
-        m_visualizer->loadPlugin(pluginName.toStdString());
+    void changePlugin(int monitor, const QString& pluginName) {
+        if (monitor < 0 || monitor >= static_cast<int>(m_outputs.size())) return;
+        Output& output = *m_outputs[monitor];
+
+        output.pipeline->post({RenderPipeline::EngineCommand::Type::LoadPlugin, pluginName.toStdString()});
         
         // Update current plugin index
         for (size_t i = 0; i < m_availablePlugins.size(); ++i) {
             if (m_availablePlugins[i] == pluginName.toStdString()) {
-                m_currentPluginIndex = i;
+                output.pluginIndex = i;
                 break;
             }
         }
     }
 
     void changeAudioDevice(const QString& deviceName) {
-        bool wasRunning = m_running;
-        if (wasRunning) {
-            stopVisualization();
-        }
-
-        m_audioInput->initialize(deviceName.toStdString());
-
-        if (wasRunning) {
-            startVisualization();
+        // Switched here rather than on an engine thread, which may be parked
+        // while its monitor is suspended
+        if (!m_audioInput->switchDevice(deviceName.toStdString())) {
+            std::cerr << "Failed to switch audio device, keeping the current one: "
+                      << deviceName.toStdString() << std::endl;
         }
     }
 
@@ -211,51 +292,141 @@ public slots:
     }
 
 private slots:
-    void renderFrame() {
-        if (!m_running) return;
-
-        if (m_visualizer->usesDirectGL()) {
-            // Engine renders directly into the window's GL back-buffer;
-            // just present the frame — no CPU pixel transfer needed.
-            m_visualizer->render();
-            m_renderer->swapBuffers();
-        } else {
-            if (m_visualizer->render()) {
-                unsigned char* videoData = m_visualizer->getVideoData();
-                if (videoData) {
-                    m_renderer->renderFrame(videoData,
-                                            m_visualizer->getWidth(),
-                                            m_visualizer->getHeight());
-                }
-            }
+    void showPerfOverlay(bool visible) {
+        m_perfOverlay = visible;
+        for (const auto& output : m_outputs) {
+            output->renderer->setOverlayVisible(visible);
         }
     }
 
+    void setOutputSuspended(int monitor, bool suspended) {
+        if (monitor < 0 || monitor >= static_cast<int>(m_outputs.size())) return;
+        m_outputs[monitor]->pipeline->setSuspended(suspended);
+        updateAudioCork();
+    }
+
+    void showMonitorPlugin(int monitor) {
+        if (monitor < 0 || monitor >= static_cast<int>(m_outputs.size())) return;
+        const std::string& plugin = m_availablePlugins[m_outputs[monitor]->pluginIndex];
+        m_controlPanel->setCurrentPlugin(QString::fromStdString(plugin));
+    }
+
     void switchToNextPlugin() {
         if (m_availablePlugins.empty()) return;
 
-        m_currentPluginIndex = (m_currentPluginIndex + 1) % m_availablePlugins.size();
-        QString nextPlugin = QString::fromStdString(m_availablePlugins[m_currentPluginIndex]);
-        
-        changePlugin(nextPlugin);
-        m_settings->setVisualPlugin(nextPlugin);
-        
-        std::cout << "Switched to plugin: " << nextPlugin.toStdString() << std::endl;
+        for (size_t i = 0; i < m_outputs.size(); ++i) {
+            const size_t next = (m_outputs[i]->pluginIndex + 1) % m_availablePlugins.size();
+            QString nextPlugin = QString::fromStdString(m_availablePlugins[next]);
+
+            changePlugin(static_cast<int>(i), nextPlugin);
+            if (i == 0) {
+                m_settings->setVisualPlugin(nextPlugin);
+            }
+
+            std::cout << "Switched " << m_outputs[i]->name << " to plugin: "
+                      << nextPlugin.toStdString() << std::endl;
+        }
     }
 
 private:
+    // Everything that renders one monitor
+    struct Output {
+        std::string name;
+        std::unique_ptr<DesktopRenderer> renderer;
+        std::unique_ptr<VisualizationEngine> engine;
+        std::unique_ptr<FrameScheduler> scheduler;
+        std::unique_ptr<RenderPipeline> pipeline;  // declared last: stops first
+        size_t pluginIndex = 0;
+        int x = 0, y = 0, width = 0, height = 0;   // area on the root window
+    };
+
+    // Capture stops while no output is visible, and restarts with the first
+    void updateAudioCork() {
+        if (!m_running) return;
+        bool anyVisible = false;
+        for (size_t i = 0; i < m_outputs.size(); ++i) {
+            anyVisible = anyVisible || !m_activityMonitor->isSuspended(static_cast<int>(i));
+        }
+        if (anyVisible && (m_audioCorked || !m_audioInput->isRunning())) {
+            m_audioInput->start();
+            m_audioCorked = false;
+        } else if (!anyVisible && !m_audioCorked) {
+            m_audioInput->stop();
+            m_audioCorked = true;
+            std::cout << "Audio capture paused" << std::endl;
+        }
+    }
+
+    bool initializeOutput(Output& output, const MonitorInfo* monitor) {
+        // Create visualizer now (after libvisual_init in main)
+        output.engine = VisualizationFactory::createEngine(m_engineType);
+        if (!output.engine) {
+            std::cerr << "Failed to create visualization engine" << std::endl;
+            return false;
+        }
+        std::cout << "Using " << output.engine->getEngineName() << " visualization engine on "
+                  << output.name << std::endl;
+        
+        output.renderer = std::make_unique<DesktopRenderer>();
+        output.renderer->setScaleFilter(m_scaleFilter);
+        output.renderer->setGamma(m_gamma);
+        output.renderer->setOverlayVisible(m_perfOverlay);
+        if (!output.renderer->initialize(monitor)) {
+            std::cerr << "Failed to initialize desktop renderer" << std::endl;
+            return false;
+        }
+
+        // Frame pacing: vsync-locked by default.  Swaps wait for vblank only
+        // when the scheduler is locked to it.
+        output.scheduler = std::make_unique<FrameScheduler>();
+        output.scheduler->setMode(m_frameMode);
+        output.scheduler->setFixedRate(m_fixedRate);
+        const bool vsync = m_frameMode == FrameScheduler::Mode::VSync;
+        output.scheduler->setRefreshRate(output.renderer->getRefreshRate());
+        output.scheduler->setSwapThrottled(output.renderer->setSwapInterval(vsync ? 1 : 0) && vsync);
+
+        // For projectM: hand it our GLX context so it can render directly into
+        // the desktop window without a GPU→CPU readback round-trip.
+#ifdef HAVE_PROJECTM
+        if (output.renderer->hasGLContext()) {
+            auto* pmViz = dynamic_cast<ProjectMVisualizer*>(output.engine.get());
+            if (pmViz) {
+                pmViz->setGLContext(output.renderer->getDisplay(),
+                                    output.renderer->getWindow(),
+                                    output.renderer->getGLContext());
+            }
+        }
+#endif
+
+        // Initialize visualizer at the monitor's own size
+        int width, height;
+        output.renderer->getScreenSize(width, height);
+        if (!output.engine->initialize(width, height)) {
+            std::cerr << "Failed to initialize visualizer" << std::endl;
+            return false;
+        }
+        return true;
+    }
+
     std::unique_ptr<Settings> m_settings;
-    std::unique_ptr<VisualizationEngine> m_visualizer;
     std::unique_ptr<AudioInput> m_audioInput;
-    std::unique_ptr<DesktopRenderer> m_renderer;
     std::unique_ptr<ControlPanel> m_controlPanel;
+    std::vector<std::unique_ptr<Output>> m_outputs;
     
-    QTimer* m_renderTimer;
+    ActivityMonitor* m_activityMonitor;
     QTimer* m_autoSwitchTimer;
     
     std::vector<std::string> m_availablePlugins;
-    size_t m_currentPluginIndex;
+    ScaleFilter m_scaleFilter;
+    float m_gamma;
+    FrameScheduler::Mode m_frameMode;
+    double m_fixedRate;
+    double m_renderScale;
+    double m_frameBudget;
+    double m_engineRate;
+    bool m_perfOverlay;
     bool m_running;
+    bool m_audioCorked;
     VisualizationFactory::EngineType m_engineType;
 };
 
@@ -270,24 +441,23 @@ void signalHandler(int signal) {
 }
 
 int main(int argc, char* argv[]) {
-    QApplication app(argc, argv);
-    app.setApplicationName("LibVisual Background");
-    app.setApplicationVersion("1.1.0");
-    app.setQuitOnLastWindowClosed(false); // Keep running in system tray
-
-    // Initialize libvisual first
-    if (visual_init(&argc, &argv) != VISUAL_OK) {
-        std::cerr << "Failed to initialize libvisual" << std::endl;
-        return 1;
-    }
-
-    // Setup signal handlers
-    signal(SIGINT, signalHandler);
-    signal(SIGTERM, signalHandler);
+    // The renderer's display is used from the presentation thread
+    XInitThreads();
 
     // Parse command-line arguments
     VisualizationFactory::EngineType engineType = VisualizationFactory::EngineType::AUTO;
     bool autoStart = false;
+    ScaleFilter scaleFilter = ScaleFilter::Bilinear;
+    float gamma = 1.0f;
+    FrameScheduler::Mode frameMode = FrameScheduler::Mode::VSync;
+    double fixedRate = 60.0;
+    double renderScale = 0.0;
+    double frameBudget = 0.0;
+    double engineRate = 0.0;
+    bool perfOverlay = false;
+    bool fpsGiven = false;
+    HeadlessOptions headless;
+    bool runHeadless = false;
     
     for (int i = 1; i < argc; ++i) {
         if (strcmp(argv[i], "--autostart") == 0) {
@@ -295,12 +465,67 @@ int main(int argc, char* argv[]) {
         } else if (strcmp(argv[i], "--engine") == 0 && i + 1 < argc) {
             engineType = VisualizationFactory::stringToEngineType(argv[i + 1]);
             ++i;  // Skip next argument
+        } else if (strcmp(argv[i], "--scale-filter") == 0 && i + 1 < argc) {
+            scaleFilter = strcmp(argv[i + 1], "nearest") == 0 ? ScaleFilter::Nearest
+                        : strcmp(argv[i + 1], "sharp") == 0   ? ScaleFilter::Sharp
+                                                              : ScaleFilter::Bilinear;
+            ++i;
+        } else if (strcmp(argv[i], "--gamma") == 0 && i + 1 < argc) {
+            gamma = static_cast<float>(atof(argv[i + 1]));
+            ++i;
+        } else if (strcmp(argv[i], "--frame-mode") == 0 && i + 1 < argc) {
+            frameMode = FrameScheduler::modeFromString(argv[i + 1]);
+            ++i;
+        } else if (strcmp(argv[i], "--fps") == 0 && i + 1 < argc) {
+            fixedRate = atof(argv[i + 1]);
+            fpsGiven = true;
+            ++i;
+        } else if (strcmp(argv[i], "--render-scale") == 0 && i + 1 < argc) {
+            renderScale = strcmp(argv[i + 1], "auto") == 0 ? 0.0 : atof(argv[i + 1]);
+            ++i;
+        } else if (strcmp(argv[i], "--frame-budget") == 0 && i + 1 < argc) {
+            frameBudget = atof(argv[i + 1]);
+            ++i;
+        } else if (strcmp(argv[i], "--engine-fps") == 0 && i + 1 < argc) {
+            engineRate = atof(argv[i + 1]);
+            ++i;
+        } else if (strcmp(argv[i], "--hud") == 0) {
+            perfOverlay = true;
+        } else if (strcmp(argv[i], "--headless") == 0) {
+            runHeadless = true;
+        } else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            headless.frames = atoi(argv[i + 1]);
+            ++i;
+        } else if (strcmp(argv[i], "--size") == 0 && i + 1 < argc) {
+            if (sscanf(argv[i + 1], "%dx%d", &headless.width, &headless.height) != 2) {
+                std::cerr << "Invalid --size " << argv[i + 1] << ", expected WxH" << std::endl;
+                return 1;
+            }
+            ++i;
+        } else if (strcmp(argv[i], "--checksum") == 0) {
+            headless.checksum = true;
+        } else if (strcmp(argv[i], "--plugin") == 0 && i + 1 < argc) {
+            headless.plugin = argv[i + 1];
+            ++i;
         } else if (strcmp(argv[i], "--help") == 0 || strcmp(argv[i], "-h") == 0) {
             std::cout << "LibVisual Desktop Background Visualization\n";
             std::cout << "Usage: libvisual-bg [OPTIONS]\n";
             std::cout << "\nOptions:\n";
             std::cout << "  --autostart            Start visualization automatically\n";
             std::cout << "  --engine <type>        Visualization engine (auto, libvisual, projectm)\n";
+            std::cout << "  --scale-filter <mode>  Scaling to the screen (bilinear, nearest, sharp)\n";
+            std::cout << "  --gamma <g>            Gamma correction on the GPU (1 = off)\n";
+            std::cout << "  --frame-mode <mode>    Frame pacing (vsync, audio, fixed, unpaced)\n";
+            std::cout << "  --fps <rate>           Frame rate of --frame-mode fixed (default 60)\n";
+            std::cout << "  --render-scale <s>     Engine resolution: auto, or a fraction 0.25-1\n";
+            std::cout << "  --frame-budget <ms>    Engine frame time --render-scale auto aims for\n";
+            std::cout << "  --engine-fps <rate>    Engine frame rate; frames are blended to the display rate\n";
+            std::cout << "  --hud                  Show the performance overlay (GL only)\n";
+            std::cout << "  --headless             Benchmark offscreen, without X or audio, and exit\n";
+            std::cout << "  --frames <n>           Frames --headless presents (default 600)\n";
+            std::cout << "  --size <WxH>           Output size of --headless (default 1280x720)\n";
+            std::cout << "  --checksum             Print a checksum of the --headless output\n";
+            std::cout << "  --plugin <name>        Plugin --headless renders\n";
             std::cout << "  --help, -h             Show this help message\n";
             std::cout << "\nAvailable engines: ";
             for (const auto& engine : VisualizationFactory::getAvailableEngines()) {
@@ -311,7 +536,47 @@ int main(int argc, char* argv[]) {
         }
     }
 
+    // Headless runs never open the display, so they go before QApplication
+    if (runHeadless) {
+        if (visual_init(&argc, &argv) != VISUAL_OK) {
+            std::cerr << "Failed to initialize libvisual" << std::endl;
+            return 1;
+        }
+        headless.engineType = engineType;
+        headless.fps = fpsGiven ? fixedRate : 0.0;
+        headless.scaleFilter = scaleFilter;
+        headless.gamma = gamma;
+        headless.renderScale = renderScale > 0.0 || frameBudget > 0.0 ? renderScale : 1.0;
+        headless.frameBudget = frameBudget;
+        headless.engineRate = engineRate;
+        headless.overlay = perfOverlay;
+        const int result = runHeadlessBenchmark(headless);
+        visual_quit();
+        return result;
+    }
+
+
+    QApplication app(argc, argv);
+    app.setApplicationName("LibVisual Background");
+    app.setApplicationVersion("1.1.0");
+    app.setQuitOnLastWindowClosed(false); // Keep running in system tray
+
+    // Initialize libvisual first
+    if (visual_init(&argc, &argv) != VISUAL_OK) {
+        std::cerr << "Failed to initialize libvisual" << std::endl;
+        return 1;
+    }
+
+    // Setup signal handlers
+    signal(SIGINT, signalHandler);
+    signal(SIGTERM, signalHandler);
+
     VisualizationApp vizApp(engineType);
+    vizApp.setScaleFilter(scaleFilter, gamma);
+    vizApp.setFrameMode(frameMode, fixedRate);
+    vizApp.setRenderScale(renderScale, frameBudget);
+    vizApp.setEngineRate(engineRate);
+    vizApp.setPerfOverlay(perfOverlay);
     g_app = &vizApp;
 
     if (!vizApp.initialize()) {
@@ -0,0 +1,369 @@
+#include "perf_overlay.h"
+#include "present_shader.h"
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+
+namespace {
+
+constexpr GLuint POSITION_ATTRIBUTE = 0;
+constexpr GLuint TEXCOORD_ATTRIBUTE = 1;
+constexpr GLuint COLOR_ATTRIBUTE    = 2;
+
+// 5x7 font for ASCII 32-126, five columns per glyph, bit 0 the top row
+constexpr int FIRST_GLYPH  = 32;
+constexpr int GLYPH_COUNT  = 95;
+constexpr int GLYPH_WIDTH  = 5;
+constexpr int GLYPH_HEIGHT = 7;
+const uint8_t FONT[GLYPH_COUNT][GLYPH_WIDTH] = {
+    {0x00, 0x00, 0x00, 0x00, 0x00}, {0x00, 0x00, 0x5F, 0x00, 0x00}, {0x00, 0x07, 0x00, 0x07, 0x00},
+    {0x14, 0x7F, 0x14, 0x7F, 0x14}, {0x24, 0x2A, 0x7F, 0x2A, 0x12}, {0x23, 0x13, 0x08, 0x64, 0x62},
+    {0x36, 0x49, 0x55, 0x22, 0x50}, {0x00, 0x05, 0x03, 0x00, 0x00}, {0x00, 0x1C, 0x22, 0x41, 0x00},
+    {0x00, 0x41, 0x22, 0x1C, 0x00}, {0x08, 0x2A, 0x1C, 0x2A, 0x08}, {0x08, 0x08, 0x3E, 0x08, 0x08},
+    {0x00, 0x50, 0x30, 0x00, 0x00}, {0x08, 0x08, 0x08, 0x08, 0x08}, {0x00, 0x60, 0x60, 0x00, 0x00},
+    {0x20, 0x10, 0x08, 0x04, 0x02}, {0x3E, 0x51, 0x49, 0x45, 0x3E}, {0x00, 0x42, 0x7F, 0x40, 0x00},
+    {0x42, 0x61, 0x51, 0x49, 0x46}, {0x21, 0x41, 0x45, 0x4B, 0x31}, {0x18, 0x14, 0x12, 0x7F, 0x10},
+    {0x27, 0x45, 0x45, 0x45, 0x39}, {0x3C, 0x4A, 0x49, 0x49, 0x30}, {0x01, 0x71, 0x09, 0x05, 0x03},
+    {0x36, 0x49, 0x49, 0x49, 0x36}, {0x06, 0x49, 0x49, 0x29, 0x1E}, {0x00, 0x36, 0x36, 0x00, 0x00},
+    {0x00, 0x56, 0x36, 0x00, 0x00}, {0x08, 0x14, 0x22, 0x41, 0x00}, {0x14, 0x14, 0x14, 0x14, 0x14},
+    {0x00, 0x41, 0x22, 0x14, 0x08}, {0x02, 0x01, 0x51, 0x09, 0x06}, {0x32, 0x49, 0x79, 0x41, 0x3E},
+    {0x7E, 0x11, 0x11, 0x11, 0x7E}, {0x7F, 0x49, 0x49, 0x49, 0x36}, {0x3E, 0x41, 0x41, 0x41, 0x22},
+    {0x7F, 0x41, 0x41, 0x22, 0x1C}, {0x7F, 0x49, 0x49, 0x49, 0x41}, {0x7F, 0x09, 0x09, 0x09, 0x01},
+    {0x3E, 0x41, 0x49, 0x49, 0x7A}, {0x7F, 0x08, 0x08, 0x08, 0x7F}, {0x00, 0x41, 0x7F, 0x41, 0x00},
+    {0x20, 0x40, 0x41, 0x3F, 0x01}, {0x7F, 0x08, 0x14, 0x22, 0x41}, {0x7F, 0x40, 0x40, 0x40, 0x40},
+    {0x7F, 0x02, 0x0C, 0x02, 0x7F}, {0x7F, 0x04, 0x08, 0x10, 0x7F}, {0x3E, 0x41, 0x41, 0x41, 0x3E},
+    {0x7F, 0x09, 0x09, 0x09, 0x06}, {0x3E, 0x41, 0x51, 0x21, 0x5E}, {0x7F, 0x09, 0x19, 0x29, 0x46},
+    {0x46, 0x49, 0x49, 0x49, 0x31}, {0x01, 0x01, 0x7F, 0x01, 0x01}, {0x3F, 0x40, 0x40, 0x40, 0x3F},
+    {0x1F, 0x20, 0x40, 0x20, 0x1F}, {0x3F, 0x40, 0x38, 0x40, 0x3F}, {0x63, 0x14, 0x08, 0x14, 0x63},
+    {0x07, 0x08, 0x70, 0x08, 0x07}, {0x61, 0x51, 0x49, 0x45, 0x43}, {0x00, 0x7F, 0x41, 0x41, 0x00},
+    {0x02, 0x04, 0x08, 0x10, 0x20}, {0x00, 0x41, 0x41, 0x7F, 0x00}, {0x04, 0x02, 0x01, 0x02, 0x04},
+    {0x40, 0x40, 0x40, 0x40, 0x40}, {0x00, 0x01, 0x02, 0x04, 0x00}, {0x20, 0x54, 0x54, 0x54, 0x78},
+    {0x7F, 0x48, 0x44, 0x44, 0x38}, {0x38, 0x44, 0x44, 0x44, 0x20}, {0x38, 0x44, 0x44, 0x48, 0x7F},
+    {0x38, 0x54, 0x54, 0x54, 0x18}, {0x08, 0x7E, 0x09, 0x01, 0x02}, {0x0C, 0x52, 0x52, 0x52, 0x3E},
+    {0x7F, 0x08, 0x04, 0x04, 0x78}, {0x00, 0x44, 0x7D, 0x40, 0x00}, {0x20, 0x40, 0x44, 0x3D, 0x00},
+    {0x7F, 0x10, 0x28, 0x44, 0x00}, {0x00, 0x41, 0x7F, 0x40, 0x00}, {0x7C, 0x04, 0x18, 0x04, 0x78},
+    {0x7C, 0x08, 0x04, 0x04, 0x78}, {0x38, 0x44, 0x44, 0x44, 0x38}, {0x7C, 0x14, 0x14, 0x14, 0x08},
+    {0x08, 0x14, 0x14, 0x18, 0x7C}, {0x7C, 0x08, 0x04, 0x04, 0x08}, {0x48, 0x54, 0x54, 0x54, 0x20},
+    {0x04, 0x3F, 0x44, 0x40, 0x20}, {0x3C, 0x40, 0x40, 0x20, 0x7C}, {0x1C, 0x20, 0x40, 0x20, 0x1C},
+    {0x3C, 0x40, 0x30, 0x40, 0x3C}, {0x44, 0x28, 0x10, 0x28, 0x44}, {0x0C, 0x50, 0x50, 0x50, 0x3C},
+    {0x44, 0x64, 0x54, 0x4C, 0x44}, {0x00, 0x08, 0x36, 0x41, 0x00}, {0x00, 0x00, 0x7F, 0x00, 0x00},
+    {0x00, 0x41, 0x36, 0x08, 0x00}, {0x08, 0x04, 0x08, 0x10, 0x08},
+};
+
+// Atlas: 8x8 cells, 16 to a row; the cell after the last glyph is solid and
+// textures the panel and the graph
+constexpr int CELL = 8;
+constexpr int ATLAS_COLUMNS = 16;
+constexpr int ATLAS_WIDTH = CELL * ATLAS_COLUMNS;
+constexpr int ATLAS_HEIGHT = CELL * ((GLYPH_COUNT + 1 + ATLAS_COLUMNS - 1) / ATLAS_COLUMNS);
+constexpr int SOLID_CELL = GLYPH_COUNT;
+
+// Layout in font pixels, multiplied by the scale chosen for the viewport
+constexpr int MARGIN = 4;
+constexpr int PADDING = 3;
+constexpr int ADVANCE = GLYPH_WIDTH + 1;
+constexpr int LINE_HEIGHT = GLYPH_HEIGHT + 2;
+constexpr int GRAPH_HEIGHT = 32;
+// Font pixels are screen pixels up to this viewport height, doubled up to
+// twice that, and so on
+constexpr int SCALE_STEP = 540;
+
+constexpr uint32_t PANEL_COLOR  = 0x000000B0;
+constexpr uint32_t TEXT_COLOR   = 0xFFFFFFFF;
+constexpr uint32_t TARGET_COLOR = 0xFFFFFF60;
+constexpr uint32_t GOOD_COLOR   = 0x40E040FF;
+constexpr uint32_t SLOW_COLOR   = 0xF0D030FF;
+constexpr uint32_t LATE_COLOR   = 0xF04030FF;
+// Graph height without a target: two frames at 30 Hz
+constexpr double DEFAULT_GRAPH_MS = 66.7;
+// Gaps longer than this (hidden, suspended) are not frame times
+constexpr double MAX_FRAME_MS = 1000.0;
+
+const char* const VERTEX_SHADER = R"(
+ATTRIBUTE vec2 a_position;  // pixels from the top left
+ATTRIBUTE vec2 a_texCoord;
+ATTRIBUTE vec4 a_color;
+uniform vec2 u_viewport;
+VARYING vec2 v_texCoord;
+VARYING vec4 v_color;
+
+void main() {
+    v_texCoord = a_texCoord;
+    v_color = a_color;
+    gl_Position = vec4(a_position.x / u_viewport.x * 2.0 - 1.0, 1.0 - a_position.y / u_viewport.y * 2.0, 0.0, 1.0);
+}
+)";
+
+const char* const FRAGMENT_SHADER = R"(
+uniform sampler2D u_atlas;  // coverage in alpha
+VARYING vec2 v_texCoord;
+VARYING vec4 v_color;
+
+void main() {
+    FRAG_COLOR = vec4(v_color.rgb, v_color.a * TEXTURE(u_atlas, v_texCoord).a);
+}
+)";
+
+} // namespace
+
+PerfOverlay::PerfOverlay(const GLFunctions& gl)
+    : m_gl(gl), m_program(0), m_atlas(0), m_vertexBuffer(0), m_vertexArray(0),
+      m_viewportLocation(-1), m_targetMs(0.0), m_textScale(0), m_panelWidth(0),
+      m_frameTimes(GRAPH_FRAMES, 0.0f), m_frameHead(0) {
+}
+
+bool PerfOverlay::create() {
+    if (!m_gl.hasShaders() || (m_gl.coreProfile && !m_gl.hasVertexArrays())) {
+        return false;
+    }
+
+    const GLuint vertex = compileShaderStage(m_gl, GL_VERTEX_SHADER, VERTEX_SHADER);
+    const GLuint fragment = compileShaderStage(m_gl, GL_FRAGMENT_SHADER, FRAGMENT_SHADER);
+    if (!vertex || !fragment) {
+        if (vertex) m_gl.DeleteShader(vertex);
+        if (fragment) m_gl.DeleteShader(fragment);
+        return false;
+    }
+
+    m_program = m_gl.CreateProgram();
+    m_gl.AttachShader(m_program, vertex);
+    m_gl.AttachShader(m_program, fragment);
+    m_gl.BindAttribLocation(m_program, POSITION_ATTRIBUTE, "a_position");
+    m_gl.BindAttribLocation(m_program, TEXCOORD_ATTRIBUTE, "a_texCoord");
+    m_gl.BindAttribLocation(m_program, COLOR_ATTRIBUTE, "a_color");
+    m_gl.LinkProgram(m_program);
+    m_gl.DeleteShader(vertex);
+    m_gl.DeleteShader(fragment);
+
+    GLint status = GL_FALSE;
+    m_gl.GetProgramiv(m_program, GL_LINK_STATUS, &status);
+    if (status != GL_TRUE) {
+        char log[1024] = {};
+        m_gl.GetProgramInfoLog(m_program, sizeof(log), nullptr, log);
+        std::cerr << "Failed to link the overlay shader: " << log << std::endl;
+        destroy();
+        return false;
+    }
+    m_viewportLocation = m_gl.GetUniformLocation(m_program, "u_viewport");
+    m_gl.UseProgram(m_program);
+    m_gl.Uniform1i(m_gl.GetUniformLocation(m_program, "u_atlas"), 0);
+
+    // White texels, the font in their alpha
+    std::vector<uint8_t> atlas(ATLAS_WIDTH * ATLAS_HEIGHT * 4, 0xFF);
+    for (int glyph = 0; glyph <= SOLID_CELL; ++glyph) {
+        const int cellX = glyph % ATLAS_COLUMNS * CELL;
+        const int cellY = glyph / ATLAS_COLUMNS * CELL;
+        for (int y = 0; y < CELL; ++y) {
+            for (int x = 0; x < CELL; ++x) {
+                const bool set = glyph == SOLID_CELL ||
+                                 (x < GLYPH_WIDTH && y < GLYPH_HEIGHT && (FONT[glyph][x] >> y & 1));
+                atlas[((cellY + y) * ATLAS_WIDTH + cellX + x) * 4 + 3] = set ? 0xFF : 0;
+            }
+        }
+    }
+    glGenTextures(1, &m_atlas);
+    glBindTexture(GL_TEXTURE_2D, m_atlas);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, ATLAS_WIDTH, ATLAS_HEIGHT, 0,
+                 GL_RGBA, GL_UNSIGNED_BYTE, atlas.data());
+
+    m_gl.GenBuffers(1, &m_vertexBuffer);
+    if (m_gl.hasVertexArrays()) {
+        m_gl.GenVertexArrays(1, &m_vertexArray);
+        m_gl.BindVertexArray(m_vertexArray);
+        m_gl.BindBuffer(GL_ARRAY_BUFFER, m_vertexBuffer);
+        m_gl.VertexAttribPointer(POSITION_ATTRIBUTE, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex),
+                                 reinterpret_cast<const void*>(offsetof(Vertex, x)));
+        m_gl.VertexAttribPointer(TEXCOORD_ATTRIBUTE, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex),
+                                 reinterpret_cast<const void*>(offsetof(Vertex, u)));
+        m_gl.VertexAttribPointer(COLOR_ATTRIBUTE, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Vertex),
+                                 reinterpret_cast<const void*>(offsetof(Vertex, r)));
+        m_gl.EnableVertexAttribArray(POSITION_ATTRIBUTE);
+        m_gl.EnableVertexAttribArray(TEXCOORD_ATTRIBUTE);
+        m_gl.EnableVertexAttribArray(COLOR_ATTRIBUTE);
+        m_gl.BindVertexArray(0);
+    }
+    m_gl.BindBuffer(GL_ARRAY_BUFFER, 0);
+    return true;
+}
+
+void PerfOverlay::destroy() {
+    if (m_vertexArray) {
+        m_gl.DeleteVertexArrays(1, &m_vertexArray);
+        m_vertexArray = 0;
+    }
+    if (m_vertexBuffer) {
+        m_gl.DeleteBuffers(1, &m_vertexBuffer);
+        m_vertexBuffer = 0;
+    }
+    if (m_atlas) {
+        glDeleteTextures(1, &m_atlas);
+        m_atlas = 0;
+    }
+    if (m_program) {
+        m_gl.UseProgram(0);
+        m_gl.DeleteProgram(m_program);
+        m_program = 0;
+    }
+}
+
+void PerfOverlay::setText(const std::vector<std::string>& lines, double targetMs) {
+    m_lines = lines;
+    m_targetMs = targetMs;
+    m_textScale = 0;
+}
+
+void PerfOverlay::addRect(std::vector<Vertex>& out, float x, float y, float width, float height,
+                          uint32_t rgba) const {
+    const float u = (SOLID_CELL % ATLAS_COLUMNS * CELL + CELL / 2) / static_cast<float>(ATLAS_WIDTH);
+    const float v = (SOLID_CELL / ATLAS_COLUMNS * CELL + CELL / 2) / static_cast<float>(ATLAS_HEIGHT);
+    const uint8_t r = rgba >> 24, g = rgba >> 16 & 0xFF, b = rgba >> 8 & 0xFF, a = rgba & 0xFF;
+    const Vertex corners[4] = {
+        {x, y, u, v, r, g, b, a},
+        {x + width, y, u, v, r, g, b, a},
+        {x, y + height, u, v, r, g, b, a},
+        {x + width, y + height, u, v, r, g, b, a},
+    };
+    out.insert(out.end(), {corners[0], corners[1], corners[2], corners[2], corners[1], corners[3]});
+}
+
+void PerfOverlay::addGlyph(std::vector<Vertex>& out, float x, float y, int scale, char c,
+                           uint32_t rgba) const {
+    int glyph = static_cast<unsigned char>(c) - FIRST_GLYPH;
+    if (glyph < 0 || glyph >= GLYPH_COUNT) {
+        glyph = '?' - FIRST_GLYPH;
+    }
+    if (glyph == 0) {
+        return;  // space
+    }
+    const float u0 = glyph % ATLAS_COLUMNS * CELL / static_cast<float>(ATLAS_WIDTH);
+    const float v0 = glyph / ATLAS_COLUMNS * CELL / static_cast<float>(ATLAS_HEIGHT);
+    const float u1 = u0 + GLYPH_WIDTH / static_cast<float>(ATLAS_WIDTH);
+    const float v1 = v0 + GLYPH_HEIGHT / static_cast<float>(ATLAS_HEIGHT);
+    const float w = static_cast<float>(GLYPH_WIDTH * scale);
+    const float h = static_cast<float>(GLYPH_HEIGHT * scale);
+    const uint8_t r = rgba >> 24, g = rgba >> 16 & 0xFF, b = rgba >> 8 & 0xFF, a = rgba & 0xFF;
+    const Vertex corners[4] = {
+        {x, y, u0, v0, r, g, b, a},
+        {x + w, y, u1, v0, r, g, b, a},
+        {x, y + h, u0, v1, r, g, b, a},
+        {x + w, y + h, u1, v1, r, g, b, a},
+    };
+    out.insert(out.end(), {corners[0], corners[1], corners[2], corners[2], corners[1], corners[3]});
+}
+
+// Panel and text, which only change with the text or the scale
+void PerfOverlay::buildText(int scale) {
+    size_t columns = 0;
+    for (const std::string& line : m_lines) {
+        columns = std::max(columns, line.size());
+    }
+    m_panelWidth = std::max(static_cast<int>(columns) * ADVANCE - 1, GRAPH_FRAMES) + 2 * PADDING;
+    const int panelHeight = 2 * PADDING + static_cast<int>(m_lines.size()) * LINE_HEIGHT + GRAPH_HEIGHT;
+
+    m_textVertices.clear();
+    addRect(m_textVertices, MARGIN * scale, MARGIN * scale, m_panelWidth * scale, panelHeight * scale,
+            PANEL_COLOR);
+    float y = static_cast<float>((MARGIN + PADDING) * scale);
+    for (const std::string& line : m_lines) {
+        float x = static_cast<float>((MARGIN + PADDING) * scale);
+        for (char c : line) {
+            addGlyph(m_textVertices, x, y, scale, c, TEXT_COLOR);
+            x += ADVANCE * scale;
+        }
+        y += LINE_HEIGHT * scale;
+    }
+    m_textScale = scale;
+}
+
+// One bar per frame, newest on the right; the full height is two target
+// periods, and bars over 1.5 periods (late, as FrameScheduler counts it)
+// are red
+void PerfOverlay::addGraph(float x, float y, int scale) {
+    const double fullMs = m_targetMs > 0.0 ? 2.0 * m_targetMs : DEFAULT_GRAPH_MS;
+    const float height = static_cast<float>(GRAPH_HEIGHT * scale);
+    for (int i = 0; i < GRAPH_FRAMES; ++i) {
+        const float ms = m_frameTimes[(m_frameHead + i) % GRAPH_FRAMES];
+        if (ms <= 0.0f) {
+            continue;
+        }
+        const float bar = height * static_cast<float>(std::min(ms / fullMs, 1.0));
+        uint32_t color = GOOD_COLOR;
+        if (m_targetMs > 0.0 && ms > 1.5 * m_targetMs) {
+            color = LATE_COLOR;
+        } else if (m_targetMs > 0.0 && ms > 1.1 * m_targetMs) {
+            color = SLOW_COLOR;
+        }
+        addRect(m_vertices, x + i * scale, y + height - bar, static_cast<float>(scale), bar, color);
+    }
+    if (m_targetMs > 0.0) {
+        addRect(m_vertices, x, y + height / 2.0f, static_cast<float>(GRAPH_FRAMES * scale),
+                static_cast<float>(scale), TARGET_COLOR);
+    }
+}
+
+void PerfOverlay::draw(int viewportWidth, int viewportHeight) {
+    if (!m_program || viewportWidth <= 0 || viewportHeight <= 0) {
+        return;
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    if (m_lastDraw != std::chrono::steady_clock::time_point()) {
+        const std::chrono::duration<double, std::milli> interval = now - m_lastDraw;
+        if (interval.count() < MAX_FRAME_MS) {
+            m_frameTimes[m_frameHead] = static_cast<float>(interval.count());
+            m_frameHead = (m_frameHead + 1) % GRAPH_FRAMES;
+        }
+    }
+    m_lastDraw = now;
+
+    const int scale = std::max(1, viewportHeight / SCALE_STEP);
+    if (scale != m_textScale) {
+        buildText(scale);
+    }
+    m_vertices.assign(m_textVertices.begin(), m_textVertices.end());
+    addGraph(static_cast<float>((MARGIN + PADDING) * scale),
+             static_cast<float>((MARGIN + PADDING + static_cast<int>(m_lines.size()) * LINE_HEIGHT) * scale),
+             scale);
+
+    // A fresh store every frame, so the driver never waits for the last draw
+    m_gl.BindBuffer(GL_ARRAY_BUFFER, m_vertexBuffer);
+    m_gl.BufferData(GL_ARRAY_BUFFER, m_vertices.size() * sizeof(Vertex), m_vertices.data(), GL_STREAM_DRAW);
+
+    glViewport(0, 0, viewportWidth, viewportHeight);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    m_gl.UseProgram(m_program);
+    m_gl.Uniform2f(m_viewportLocation, static_cast<float>(viewportWidth), static_cast<float>(viewportHeight));
+    m_gl.ActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, m_atlas);
+
+    if (m_vertexArray) {
+        m_gl.BindVertexArray(m_vertexArray);
+    } else {
+        m_gl.VertexAttribPointer(POSITION_ATTRIBUTE, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex),
+                                 reinterpret_cast<const void*>(offsetof(Vertex, x)));
+        m_gl.VertexAttribPointer(TEXCOORD_ATTRIBUTE, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex),
+                                 reinterpret_cast<const void*>(offsetof(Vertex, u)));
+        m_gl.VertexAttribPointer(COLOR_ATTRIBUTE, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Vertex),
+                                 reinterpret_cast<const void*>(offsetof(Vertex, r)));
+        m_gl.EnableVertexAttribArray(POSITION_ATTRIBUTE);
+        m_gl.EnableVertexAttribArray(TEXCOORD_ATTRIBUTE);
+        m_gl.EnableVertexAttribArray(COLOR_ATTRIBUTE);
+    }
+    glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(m_vertices.size()));
+    if (m_vertexArray) {
+        m_gl.BindVertexArray(0);
+    } else {
+        // The presentation shader feeds only the position
+        m_gl.DisableVertexAttribArray(TEXCOORD_ATTRIBUTE);
+        m_gl.DisableVertexAttribArray(COLOR_ATTRIBUTE);
+    }
+    m_gl.BindBuffer(GL_ARRAY_BUFFER, 0);
+}
@@ -0,0 +1,75 @@
+#ifndef PERF_OVERLAY_H
+#define PERF_OVERLAY_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "gl_loader.h"
+
+/**
+ * Performance overlay drawn over the presented frame: a few lines of text
+ * on a translucent panel in the top left corner and a graph of the most
+ * recent frame times.
+ *
+ * Text comes from a 5x7 bitmap font built into a small atlas texture once
+ * at create(), and everything — panel, glyphs and graph bars — is one
+ * vertex buffer of textured quads drawn with a single call.  The text
+ * quads are rebuilt only when the text changes; per frame only the graph
+ * is added.
+ *
+ * Frame times are measured between consecutive draw() calls, so the graph
+ * shows what actually reached the screen.  All methods need the context
+ * current; draw() rebinds the state it uses and leaves blending enabled.
+ */
+class PerfOverlay {
+public:
+    explicit PerfOverlay(const GLFunctions& gl);
+
+    bool create();
+    void destroy();
+
+    // Lines shown above the graph.  targetMs is the frame period the graph
+    // marks and colours bars against; 0 when there is none.
+    void setText(const std::vector<std::string>& lines, double targetMs);
+
+    // Draws over a viewport of the given size and records the time since
+    // the previous draw in the graph
+    void draw(int viewportWidth, int viewportHeight);
+
+private:
+    struct Vertex {
+        float x, y;     // pixels from the top left
+        float u, v;
+        uint8_t r, g, b, a;
+    };
+
+    void buildText(int scale);
+    void addRect(std::vector<Vertex>& out, float x, float y, float width, float height, uint32_t rgba) const;
+    void addGlyph(std::vector<Vertex>& out, float x, float y, int scale, char c, uint32_t rgba) const;
+    void addGraph(float x, float y, int scale);
+
+    static constexpr int GRAPH_FRAMES = 120;
+
+    const GLFunctions& m_gl;
+    GLuint m_program;
+    GLuint m_atlas;
+    GLuint m_vertexBuffer;
+    GLuint m_vertexArray;   // 0 when the context has none
+    GLint m_viewportLocation;
+
+    std::vector<std::string> m_lines;
+    double m_targetMs;
+    // Panel and glyph quads for m_lines at m_textScale (0: to be rebuilt)
+    std::vector<Vertex> m_textVertices;
+    int m_textScale;
+    int m_panelWidth;       // in font pixels
+    std::vector<Vertex> m_vertices;
+
+    // Ring of recent frame times in milliseconds
+    std::vector<float> m_frameTimes;
+    int m_frameHead;
+    std::chrono::steady_clock::time_point m_lastDraw;
+};
+
+#endif // PERF_OVERLAY_H
@@ -0,0 +1,291 @@
+#include "pixel_convert.h"
+#include <array>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define PIXEL_CONVERT_X86 1
+#endif
+
+namespace {
+
+constexpr bool LITTLE_ENDIAN_HOST = __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__;
+
+// Byte offset of each channel inside one pixel, -1 when the format lacks it
+template <PixelFormat F> struct Layout;
+
+template <> struct Layout<PixelFormat::RGB24> {
+    static constexpr int bpp = 3, r = 0, g = 1, b = 2, a = -1;
+};
+template <> struct Layout<PixelFormat::BGR24> {
+    static constexpr int bpp = 3, r = 2, g = 1, b = 0, a = -1;
+};
+template <> struct Layout<PixelFormat::RGBA32> {
+    static constexpr int bpp = 4, r = 0, g = 1, b = 2, a = 3;
+};
+template <> struct Layout<PixelFormat::BGRA32> {
+    static constexpr int bpp = 4;
+    static constexpr int r = LITTLE_ENDIAN_HOST ? 2 : 1;
+    static constexpr int g = LITTLE_ENDIAN_HOST ? 1 : 2;
+    static constexpr int b = LITTLE_ENDIAN_HOST ? 0 : 3;
+    static constexpr int a = LITTLE_ENDIAN_HOST ? 3 : 0;
+};
+
+constexpr int maxOf(int a, int b, int c) {
+    return a > b ? (a > c ? a : c) : (b > c ? b : c);
+}
+
+// --- Scalar -------------------------------------------------------------
+
+template <PixelFormat From>
+void copyRow(const unsigned char* src, unsigned char* dst, int width, const uint32_t*) {
+    std::memcpy(dst, src, static_cast<size_t>(width) * Layout<From>::bpp);
+}
+
+template <PixelFormat From, PixelFormat To>
+void convertRowScalar(const unsigned char* src, unsigned char* dst, int width, const uint32_t*) {
+    using S = Layout<From>;
+    using D = Layout<To>;
+    for (int x = 0; x < width; ++x, src += S::bpp, dst += D::bpp) {
+        dst[D::r] = src[S::r];
+        dst[D::g] = src[S::g];
+        dst[D::b] = src[S::b];
+        if constexpr (D::a >= 0) {
+            if constexpr (S::a >= 0) {
+                dst[D::a] = src[S::a];
+            } else {
+                dst[D::a] = 0xFF;
+            }
+        }
+    }
+}
+
+template <PixelFormat To>
+void convertIndexedScalar(const unsigned char* src, unsigned char* dst, int width, const uint32_t* palette) {
+    using D = Layout<To>;
+    for (int x = 0; x < width; ++x, dst += D::bpp) {
+        const uint32_t color = palette[src[x]];
+        if constexpr (To == PixelFormat::BGRA32) {
+            std::memcpy(dst, &color, 4);
+        } else {
+            dst[D::r] = static_cast<unsigned char>(color >> 16);
+            dst[D::g] = static_cast<unsigned char>(color >> 8);
+            dst[D::b] = static_cast<unsigned char>(color);
+            if constexpr (D::a >= 0) {
+                dst[D::a] = static_cast<unsigned char>(color >> 24);
+            }
+        }
+    }
+}
+
+// --- x86 shuffle kernels ------------------------------------------------
+
+#ifdef PIXEL_CONVERT_X86
+
+// pshufb control that turns 4 source pixels into 4 destination pixels;
+// -128 zeroes the byte (missing alpha, unused tail of a 12-byte result)
+template <PixelFormat From, PixelFormat To>
+constexpr std::array<int8_t, 16> shuffleMask() {
+    using S = Layout<From>;
+    using D = Layout<To>;
+    std::array<int8_t, 16> mask{};
+    for (int i = 0; i < 16; ++i) {
+        mask[i] = -128;
+    }
+    const int channels[4][2] = {{D::r, S::r}, {D::g, S::g}, {D::b, S::b}, {D::a, S::a}};
+    for (int p = 0; p < 4; ++p) {
+        for (const auto& channel : channels) {
+            if (channel[0] >= 0 && channel[1] >= 0) {
+                mask[p * D::bpp + channel[0]] = static_cast<int8_t>(p * S::bpp + channel[1]);
+            }
+        }
+    }
+    return mask;
+}
+
+// OR-ed in after the shuffle where the destination has alpha and the source does not
+template <PixelFormat From, PixelFormat To>
+constexpr std::array<int8_t, 16> alphaMask() {
+    using S = Layout<From>;
+    using D = Layout<To>;
+    std::array<int8_t, 16> mask{};
+    if (D::a >= 0 && S::a < 0) {
+        for (int p = 0; p < 4; ++p) {
+            mask[p * D::bpp + D::a] = -1;
+        }
+    }
+    return mask;
+}
+
+template <PixelFormat From, PixelFormat To>
+__attribute__((target("ssse3")))
+void convertRowSsse3(const unsigned char* src, unsigned char* dst, int width, const uint32_t* palette) {
+    using S = Layout<From>;
+    using D = Layout<To>;
+    static constexpr auto SHUFFLE = shuffleMask<From, To>();
+    static constexpr auto ALPHA   = alphaMask<From, To>();
+    // 4 pixels per step; every 16-byte load and store must stay inside the row
+    constexpr int STEP = 4;
+    constexpr int SPAN = maxOf(STEP, (16 + S::bpp - 1) / S::bpp, (16 + D::bpp - 1) / D::bpp);
+
+    const __m128i shuffle = _mm_loadu_si128(reinterpret_cast<const __m128i*>(SHUFFLE.data()));
+    const __m128i alpha   = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ALPHA.data()));
+    int x = 0;
+    for (; x + SPAN <= width; x += STEP) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x * S::bpp));
+        v = _mm_or_si128(_mm_shuffle_epi8(v, shuffle), alpha);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x * D::bpp), v);
+    }
+    convertRowScalar<From, To>(src + x * S::bpp, dst + x * D::bpp, width - x, palette);
+}
+
+template <PixelFormat From, PixelFormat To>
+__attribute__((target("avx2")))
+void convertRowAvx2(const unsigned char* src, unsigned char* dst, int width, const uint32_t* palette) {
+    using S = Layout<From>;
+    using D = Layout<To>;
+    static constexpr auto SHUFFLE = shuffleMask<From, To>();
+    static constexpr auto ALPHA   = alphaMask<From, To>();
+    // 8 pixels per step, shuffled as 4 per 128-bit lane
+    constexpr int STEP = 8;
+    constexpr int SPAN = maxOf(STEP, (32 + S::bpp - 1) / S::bpp, (32 + D::bpp - 1) / D::bpp);
+
+    const __m256i shuffle = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(SHUFFLE.data())));
+    const __m256i alpha = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(ALPHA.data())));
+    // 24-byte sides: spread 12 bytes into each lane, then pack them back
+    const __m256i spread = _mm256_setr_epi32(0, 1, 2, 3, 3, 4, 5, 6);
+    const __m256i pack   = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7);
+    int x = 0;
+    for (; x + SPAN <= width; x += STEP) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + x * S::bpp));
+        if constexpr (S::bpp == 3) {
+            v = _mm256_permutevar8x32_epi32(v, spread);
+        }
+        v = _mm256_or_si256(_mm256_shuffle_epi8(v, shuffle), alpha);
+        if constexpr (D::bpp == 3) {
+            v = _mm256_permutevar8x32_epi32(v, pack);
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + x * D::bpp), v);
+    }
+    convertRowScalar<From, To>(src + x * S::bpp, dst + x * D::bpp, width - x, palette);
+}
+
+__attribute__((target("avx2")))
+void convertIndexedAvx2(const unsigned char* src, unsigned char* dst, int width, const uint32_t* palette) {
+    int x = 0;
+    for (; x + 8 <= width; x += 8) {
+        const __m256i index = _mm256_cvtepu8_epi32(
+            _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + x)));
+        const __m256i color = _mm256_i32gather_epi32(reinterpret_cast<const int*>(palette), index, 4);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + x * 4), color);
+    }
+    convertIndexedScalar<PixelFormat::BGRA32>(src + x, dst + x * 4, width - x, palette);
+}
+
+#endif // PIXEL_CONVERT_X86
+
+// --- Dispatch -----------------------------------------------------------
+
+enum class Isa { Scalar, Ssse3, Avx2 };
+
+Isa detectIsa() {
+#ifdef PIXEL_CONVERT_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return Isa::Avx2;
+    }
+    if (__builtin_cpu_supports("ssse3")) {
+        return Isa::Ssse3;
+    }
+#endif
+    return Isa::Scalar;
+}
+
+Isa currentIsa() {
+    static const Isa isa = detectIsa();
+    return isa;
+}
+
+template <PixelFormat From, PixelFormat To>
+PixelRowConverter select(Isa isa) {
+    if constexpr (To == PixelFormat::Indexed8) {
+        return nullptr;
+    } else if constexpr (From == To) {
+        return copyRow<From>;
+    } else if constexpr (From == PixelFormat::Indexed8) {
+#ifdef PIXEL_CONVERT_X86
+        if (To == PixelFormat::BGRA32 && isa == Isa::Avx2) {
+            return convertIndexedAvx2;
+        }
+#endif
+        return convertIndexedScalar<To>;
+    } else {
+#ifdef PIXEL_CONVERT_X86
+        switch (isa) {
+        case Isa::Avx2:   return convertRowAvx2<From, To>;
+        case Isa::Ssse3:  return convertRowSsse3<From, To>;
+        case Isa::Scalar: break;
+        }
+#endif
+        (void)isa;
+        return convertRowScalar<From, To>;
+    }
+}
+
+template <PixelFormat From>
+PixelRowConverter selectTo(PixelFormat to, Isa isa) {
+    switch (to) {
+    case PixelFormat::RGB24:    return select<From, PixelFormat::RGB24>(isa);
+    case PixelFormat::BGR24:    return select<From, PixelFormat::BGR24>(isa);
+    case PixelFormat::RGBA32:   return select<From, PixelFormat::RGBA32>(isa);
+    case PixelFormat::BGRA32:   return select<From, PixelFormat::BGRA32>(isa);
+    case PixelFormat::Indexed8: return nullptr;
+    }
+    return nullptr;
+}
+
+PixelRowConverter converterFor(PixelFormat from, PixelFormat to, Isa isa) {
+    switch (from) {
+    case PixelFormat::RGB24:    return selectTo<PixelFormat::RGB24>(to, isa);
+    case PixelFormat::BGR24:    return selectTo<PixelFormat::BGR24>(to, isa);
+    case PixelFormat::RGBA32:   return selectTo<PixelFormat::RGBA32>(to, isa);
+    case PixelFormat::BGRA32:   return selectTo<PixelFormat::BGRA32>(to, isa);
+    case PixelFormat::Indexed8: return selectTo<PixelFormat::Indexed8>(to, isa);
+    }
+    return nullptr;
+}
+
+} // namespace
+
+PixelRowConverter pixelRowConverter(PixelFormat from, PixelFormat to) {
+    return converterFor(from, to, currentIsa());
+}
+
+PixelRowConverter pixelRowConverterScalar(PixelFormat from, PixelFormat to) {
+    return converterFor(from, to, Isa::Scalar);
+}
+
+bool convertFrame(const unsigned char* src, const FrameDescriptor& frame,
+                  unsigned char* dst, int dstStride, PixelFormat to) {
+    const PixelRowConverter convert = pixelRowConverter(frame.format, to);
+    if (!convert || (frame.format == PixelFormat::Indexed8 && !frame.palette)) {
+        return false;
+    }
+    for (int y = 0; y < frame.height; ++y) {
+        const int row = frame.origin == FrameOrigin::TopLeft ? y : frame.height - 1 - y;
+        convert(src + static_cast<size_t>(row) * frame.stride,
+                dst + static_cast<size_t>(y) * dstStride, frame.width, frame.palette);
+    }
+    return true;
+}
+
+const char* pixelConversionIsa() {
+    switch (currentIsa()) {
+    case Isa::Avx2:   return "AVX2";
+    case Isa::Ssse3:  return "SSSE3";
+    case Isa::Scalar: break;
+    }
+    return "scalar";
+}
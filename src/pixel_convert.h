@@ -0,0 +1,42 @@
+#ifndef PIXEL_CONVERT_H
+#define PIXEL_CONVERT_H
+
+#include <cstdint>
+#include "visualization_engine.h"
+
+/**
+ * Pixel format conversion for the CPU blit paths.
+ *
+ * Every (source, destination) pair is a separate template instantiation, so
+ * channel offsets are compile-time constants and the inner loops carry no
+ * per-pixel index arithmetic.  On x86 the row kernels are SSSE3 or AVX2
+ * byte shuffles, picked once at run time from what the CPU supports; other
+ * targets and row tails use the scalar version of the same converter.
+ *
+ * Indexed8 is accepted as a source only; its palette entries are BGRA32
+ * words.  Converting to a format without alpha drops it, converting from
+ * one fills alpha with 0xFF.
+ */
+
+// Converts width pixels of one row.  palette is read for Indexed8 sources
+// and ignored otherwise.
+using PixelRowConverter = void (*)(const unsigned char* src, unsigned char* dst,
+                                   int width, const uint32_t* palette);
+
+// Row converter for a pair, or nullptr when the destination is Indexed8
+PixelRowConverter pixelRowConverter(PixelFormat from, PixelFormat to);
+
+// The scalar converter for a pair whatever the CPU supports: the reference
+// the SIMD kernels must match
+PixelRowConverter pixelRowConverterScalar(PixelFormat from, PixelFormat to);
+
+// Converts a whole frame into dst (top row first, dstStride bytes per row),
+// undoing a bottom-up origin on the way.  False if the pair is unsupported
+// or an Indexed8 frame has no palette.
+bool convertFrame(const unsigned char* src, const FrameDescriptor& frame,
+                  unsigned char* dst, int dstStride, PixelFormat to);
+
+// Instruction set the row kernels were dispatched to: "AVX2", "SSSE3" or "scalar"
+const char* pixelConversionIsa();
+
+#endif // PIXEL_CONVERT_H
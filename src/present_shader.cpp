@@ -0,0 +1,291 @@
+#include "present_shader.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+constexpr GLuint POSITION_ATTRIBUTE = 0;
+
+constexpr GLuint FRAME_UNIT            = 0;
+constexpr GLuint PREVIOUS_UNIT         = 1;
+constexpr GLuint PALETTE_UNIT          = 2;
+constexpr GLuint PREVIOUS_PALETTE_UNIT = 3;
+
+// Unit square as a triangle strip; the vertex stage maps it to clip space
+constexpr GLfloat QUAD[] = {
+    0.0f, 0.0f,
+    1.0f, 0.0f,
+    0.0f, 1.0f,
+    1.0f, 1.0f,
+};
+
+// Dialect-specific keywords are macros, so each stage is written once
+const char* const CORE_VERTEX_PREFIX =
+    "#version 150\n"
+    "#define ATTRIBUTE in\n"
+    "#define VARYING out\n";
+const char* const CORE_FRAGMENT_PREFIX =
+    "#version 150\n"
+    "#define VARYING in\n"
+    "#define TEXTURE texture\n"
+    "out vec4 fragColor;\n"
+    "#define FRAG_COLOR fragColor\n";
+const char* const LEGACY_VERTEX_PREFIX =
+    "#version 120\n"
+    "#define ATTRIBUTE attribute\n"
+    "#define VARYING varying\n";
+const char* const LEGACY_FRAGMENT_PREFIX =
+    "#version 120\n"
+    "#define VARYING varying\n"
+    "#define TEXTURE texture2D\n"
+    "#define FRAG_COLOR gl_FragColor\n";
+
+const char* const VERTEX_SHADER = R"(
+ATTRIBUTE vec2 a_position;
+uniform vec2 u_rows;        // texture v at the bottom and the top of the screen
+VARYING vec2 v_texCoord;
+
+void main() {
+    v_texCoord = vec2(a_position.x, mix(u_rows.x, u_rows.y, a_position.y));
+    gl_Position = vec4(a_position * 2.0 - 1.0, 0.0, 1.0);
+}
+)";
+
+const char* const FRAGMENT_SHADER = R"(
+uniform sampler2D u_frame;
+uniform sampler2D u_previous;
+uniform sampler2D u_palette;          // 256 x 1 colours of indexed frames
+uniform sampler2D u_previousPalette;
+uniform int u_indexed;      // 0: colour texture; 1, 2: palette indices, nearest or bilinear
+uniform float u_mix;        // weight of u_frame over u_previous, 1.0 = u_frame only
+uniform bool u_swapRedBlue;
+uniform bool u_opaque;
+uniform float u_gamma;      // exponent, 1.0 = unchanged
+uniform bool u_sharp;
+uniform vec2 u_textureSize;
+uniform vec2 u_prescale;    // whole screen pixels per texel, at least 1
+VARYING vec2 v_texCoord;
+
+// Colour of the index texel centred at texel (in texels)
+vec4 lookup(sampler2D frame, sampler2D palette, vec2 texel) {
+    float index = TEXTURE(frame, texel / u_textureSize).r;
+    return TEXTURE(palette, vec2((index * 255.0 + 0.5) / 256.0, 0.5));
+}
+
+vec4 sampleFrame(sampler2D frame, sampler2D palette, vec2 uv) {
+    if (u_indexed == 0) {
+        return TEXTURE(frame, uv);
+    }
+    if (u_indexed == 1) {
+        return lookup(frame, palette, floor(uv * u_textureSize) + 0.5);
+    }
+    // Indices cannot be interpolated; the colours they stand for are
+    vec2 texel = uv * u_textureSize - 0.5;
+    vec2 base = floor(texel) + 0.5;
+    vec2 f = fract(texel);
+    return mix(mix(lookup(frame, palette, base), lookup(frame, palette, base + vec2(1.0, 0.0)), f.x),
+               mix(lookup(frame, palette, base + vec2(0.0, 1.0)),
+                   lookup(frame, palette, base + vec2(1.0, 1.0)), f.x),
+               f.y);
+}
+
+void main() {
+    vec2 uv = v_texCoord;
+    if (u_sharp) {
+        // Sharp bilinear: flat inside each texel, blended only across the
+        // band where two texels meet
+        vec2 texel = uv * u_textureSize;
+        vec2 offset = fract(texel) - 0.5;
+        vec2 band = 0.5 - 0.5 / u_prescale;
+        uv = (floor(texel) + (offset - clamp(offset, -band, band)) * u_prescale + 0.5) / u_textureSize;
+    }
+    vec4 color = sampleFrame(u_frame, u_palette, uv);
+    if (u_mix < 1.0) {
+        color = mix(sampleFrame(u_previous, u_previousPalette, uv), color, u_mix);
+    }
+    if (u_swapRedBlue) {
+        color = color.bgra;
+    }
+    if (u_opaque) {
+        color.a = 1.0;
+    }
+    if (u_gamma != 1.0) {
+        color.rgb = pow(color.rgb, vec3(u_gamma));
+    }
+    FRAG_COLOR = color;
+}
+)";
+
+} // namespace
+
+PresentShader::PresentShader(const GLFunctions& gl)
+    : m_gl(gl), m_program(0), m_vertexBuffer(0), m_vertexArray(0),
+      m_rowsLocation(-1), m_swapRedBlueLocation(-1), m_opaqueLocation(-1),
+      m_gammaLocation(-1), m_sharpLocation(-1), m_textureSizeLocation(-1),
+      m_prescaleLocation(-1), m_mixLocation(-1), m_indexedLocation(-1) {
+}
+
+GLuint compileShaderStage(const GLFunctions& gl, GLenum type, const char* body) {
+    const char* prefix = type == GL_VERTEX_SHADER
+        ? (gl.coreProfile ? CORE_VERTEX_PREFIX : LEGACY_VERTEX_PREFIX)
+        : (gl.coreProfile ? CORE_FRAGMENT_PREFIX : LEGACY_FRAGMENT_PREFIX);
+    const char* sources[] = {prefix, body};
+
+    const GLuint shader = gl.CreateShader(type);
+    gl.ShaderSource(shader, 2, sources, nullptr);
+    gl.CompileShader(shader);
+
+    GLint status = GL_FALSE;
+    gl.GetShaderiv(shader, GL_COMPILE_STATUS, &status);
+    if (status != GL_TRUE) {
+        GLint length = 0;
+        gl.GetShaderiv(shader, GL_INFO_LOG_LENGTH, &length);
+        std::vector<char> log(std::max(length, 1));
+        gl.GetShaderInfoLog(shader, static_cast<GLsizei>(log.size()), nullptr, log.data());
+        std::cerr << "Failed to compile the "
+                  << (type == GL_VERTEX_SHADER ? "vertex" : "fragment")
+                  << " shader: " << log.data() << std::endl;
+        gl.DeleteShader(shader);
+        return 0;
+    }
+    return shader;
+}
+
+bool PresentShader::create() {
+    if (!m_gl.hasShaders() || (m_gl.coreProfile && !m_gl.hasVertexArrays())) {
+        return false;
+    }
+
+    const GLuint vertex = compileShaderStage(m_gl, GL_VERTEX_SHADER, VERTEX_SHADER);
+    const GLuint fragment = compileShaderStage(m_gl, GL_FRAGMENT_SHADER, FRAGMENT_SHADER);
+    if (!vertex || !fragment) {
+        if (vertex) m_gl.DeleteShader(vertex);
+        if (fragment) m_gl.DeleteShader(fragment);
+        return false;
+    }
+
+    m_program = m_gl.CreateProgram();
+    m_gl.AttachShader(m_program, vertex);
+    m_gl.AttachShader(m_program, fragment);
+    m_gl.BindAttribLocation(m_program, POSITION_ATTRIBUTE, "a_position");
+    m_gl.LinkProgram(m_program);
+    // The program keeps what it needs; the shader objects go with it
+    m_gl.DeleteShader(vertex);
+    m_gl.DeleteShader(fragment);
+
+    GLint status = GL_FALSE;
+    m_gl.GetProgramiv(m_program, GL_LINK_STATUS, &status);
+    if (status != GL_TRUE) {
+        char log[1024] = {};
+        m_gl.GetProgramInfoLog(m_program, sizeof(log), nullptr, log);
+        std::cerr << "Failed to link the presentation shader: " << log << std::endl;
+        destroy();
+        return false;
+    }
+
+    m_rowsLocation        = m_gl.GetUniformLocation(m_program, "u_rows");
+    m_swapRedBlueLocation = m_gl.GetUniformLocation(m_program, "u_swapRedBlue");
+    m_opaqueLocation      = m_gl.GetUniformLocation(m_program, "u_opaque");
+    m_gammaLocation       = m_gl.GetUniformLocation(m_program, "u_gamma");
+    m_sharpLocation       = m_gl.GetUniformLocation(m_program, "u_sharp");
+    m_textureSizeLocation = m_gl.GetUniformLocation(m_program, "u_textureSize");
+    m_prescaleLocation    = m_gl.GetUniformLocation(m_program, "u_prescale");
+    m_mixLocation         = m_gl.GetUniformLocation(m_program, "u_mix");
+    m_indexedLocation     = m_gl.GetUniformLocation(m_program, "u_indexed");
+    m_gl.UseProgram(m_program);
+    m_gl.Uniform1i(m_gl.GetUniformLocation(m_program, "u_frame"), FRAME_UNIT);
+    m_gl.Uniform1i(m_gl.GetUniformLocation(m_program, "u_previous"), PREVIOUS_UNIT);
+    m_gl.Uniform1i(m_gl.GetUniformLocation(m_program, "u_palette"), PALETTE_UNIT);
+    m_gl.Uniform1i(m_gl.GetUniformLocation(m_program, "u_previousPalette"), PREVIOUS_PALETTE_UNIT);
+
+    m_gl.GenBuffers(1, &m_vertexBuffer);
+    m_gl.BindBuffer(GL_ARRAY_BUFFER, m_vertexBuffer);
+    m_gl.BufferData(GL_ARRAY_BUFFER, sizeof(QUAD), QUAD, GL_STATIC_DRAW);
+    if (m_gl.hasVertexArrays()) {
+        m_gl.GenVertexArrays(1, &m_vertexArray);
+        m_gl.BindVertexArray(m_vertexArray);
+        m_gl.VertexAttribPointer(POSITION_ATTRIBUTE, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+        m_gl.EnableVertexAttribArray(POSITION_ATTRIBUTE);
+        m_gl.BindVertexArray(0);
+    }
+    m_gl.BindBuffer(GL_ARRAY_BUFFER, 0);
+    return true;
+}
+
+void PresentShader::destroy() {
+    if (m_vertexArray) {
+        m_gl.DeleteVertexArrays(1, &m_vertexArray);
+        m_vertexArray = 0;
+    }
+    if (m_vertexBuffer) {
+        m_gl.DeleteBuffers(1, &m_vertexBuffer);
+        m_vertexBuffer = 0;
+    }
+    if (m_program) {
+        m_gl.UseProgram(0);
+        m_gl.DeleteProgram(m_program);
+        m_program = 0;
+    }
+}
+
+void PresentShader::bindTexture(GLuint unit, GLuint texture, GLint filter) {
+    m_gl.ActiveTexture(GL_TEXTURE0 + unit);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
+}
+
+void PresentShader::draw(GLuint texture, const Params& params) {
+    const bool sharp = params.filter == ScaleFilter::Sharp;
+    const bool indexed = params.palette != 0;
+    const float mix = params.previousTexture ? std::min(std::max(params.mix, 0.0f), 1.0f) : 1.0f;
+    // Sharp bilinear computes its own coordinates but relies on linear taps;
+    // indices are always fetched as they are and filtered after the lookup
+    const GLint filter = indexed || params.filter == ScaleFilter::Nearest ? GL_NEAREST : GL_LINEAR;
+
+    if (mix < 1.0f) {
+        bindTexture(PREVIOUS_UNIT, params.previousTexture, filter);
+        if (indexed) {
+            bindTexture(PREVIOUS_PALETTE_UNIT, params.previousPalette, GL_NEAREST);
+        }
+    }
+    if (indexed) {
+        bindTexture(PALETTE_UNIT, params.palette, GL_NEAREST);
+    }
+    // Unit 0 last, so it is the active unit engines find
+    bindTexture(FRAME_UNIT, texture, filter);
+
+    m_gl.UseProgram(m_program);
+    const float top = params.topRowFirst ? 0.0f : 1.0f;
+    m_gl.Uniform2f(m_rowsLocation, 1.0f - top, top);
+    m_gl.Uniform1i(m_swapRedBlueLocation, params.swapRedBlue);
+    m_gl.Uniform1i(m_opaqueLocation, params.opaque);
+    m_gl.Uniform1f(m_gammaLocation, params.gamma > 0.0f ? 1.0f / params.gamma : 1.0f);
+    m_gl.Uniform1i(m_sharpLocation, sharp);
+    m_gl.Uniform1f(m_mixLocation, mix);
+    m_gl.Uniform1i(m_indexedLocation, !indexed ? 0 : params.filter == ScaleFilter::Nearest ? 1 : 2);
+    if (sharp || indexed) {
+        const float width = static_cast<float>(std::max(params.textureWidth, 1));
+        const float height = static_cast<float>(std::max(params.textureHeight, 1));
+        m_gl.Uniform2f(m_textureSizeLocation, width, height);
+        m_gl.Uniform2f(m_prescaleLocation,
+                       std::max(1.0f, std::floor(params.viewportWidth / width)),
+                       std::max(1.0f, std::floor(params.viewportHeight / height)));
+    }
+
+    glViewport(0, 0, params.viewportWidth, params.viewportHeight);
+    if (m_vertexArray) {
+        m_gl.BindVertexArray(m_vertexArray);
+    } else {
+        m_gl.BindBuffer(GL_ARRAY_BUFFER, m_vertexBuffer);
+        m_gl.VertexAttribPointer(POSITION_ATTRIBUTE, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+        m_gl.EnableVertexAttribArray(POSITION_ATTRIBUTE);
+        m_gl.BindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+    if (m_vertexArray) {
+        m_gl.BindVertexArray(0);
+    }
+}
@@ -0,0 +1,79 @@
+#ifndef PRESENT_SHADER_H
+#define PRESENT_SHADER_H
+
+#include "gl_loader.h"
+#include "frame_scaler.h"
+
+// Compiles one stage of a program for the context's GLSL dialect (1.50 in
+// core profiles, 1.20 otherwise).  body is written against the macros
+// ATTRIBUTE, VARYING, TEXTURE and FRAG_COLOR.  Returns 0, with the log
+// printed, on failure.
+GLuint compileShaderStage(const GLFunctions& gl, GLenum type, const char* body);
+
+/**
+ * Draws the frame texture over the whole viewport with a small GLSL program.
+ *
+ * The quad is a static triangle strip in a vertex buffer (recorded in a
+ * vertex array object where the context has them), so presenting a frame
+ * costs a few uniform updates and one draw call.  Everything per pixel is
+ * done by the fragment stage: red/blue swizzle of BGR uploads, forcing
+ * padding bytes opaque, gamma, the scaling filter, palette lookup of
+ * indexed frames, and the cross-fade between two frames that interpolates
+ * engine frames to the display rate.
+ *
+ * The shaders are compiled as GLSL 1.50 in core-profile contexts and as
+ * GLSL 1.20 otherwise.  Every draw() rebinds the state it relies on, since
+ * engines rendering into the same context (projectM) change it freely.
+ */
+class PresentShader {
+public:
+    struct Params {
+        bool swapRedBlue = false;  // texture holds B, G, R in its R, G, B channels
+        bool opaque = true;        // ignore the texture's alpha
+        bool topRowFirst = true;   // texture row 0 is the top of the image
+        float gamma = 1.0f;        // output = input ^ (1 / gamma)
+        ScaleFilter filter = ScaleFilter::Bilinear;
+        int textureWidth = 0;
+        int textureHeight = 0;
+        int viewportWidth = 0;
+        int viewportHeight = 0;
+        // Cross-fade: drawn as mix(previousTexture, texture, mix).  The
+        // previous texture must match the other one in size and layout.
+        GLuint previousTexture = 0;
+        float mix = 1.0f;
+        // Indexed frames: the textures hold palette indices in their red
+        // channel, looked up in these 256 x 1 colour textures
+        GLuint palette = 0;
+        GLuint previousPalette = 0;
+    };
+
+    explicit PresentShader(const GLFunctions& gl);
+
+    // Both need the context current
+    bool create();
+    void destroy();
+
+    // Draws texture (a GL_TEXTURE_2D) to the viewport; blending is left to
+    // the caller
+    void draw(GLuint texture, const Params& params);
+
+private:
+    void bindTexture(GLuint unit, GLuint texture, GLint filter);
+
+    const GLFunctions& m_gl;
+    GLuint m_program;
+    GLuint m_vertexBuffer;
+    GLuint m_vertexArray;   // 0 when the context has none
+
+    GLint m_rowsLocation;
+    GLint m_swapRedBlueLocation;
+    GLint m_opaqueLocation;
+    GLint m_gammaLocation;
+    GLint m_sharpLocation;
+    GLint m_textureSizeLocation;
+    GLint m_prescaleLocation;
+    GLint m_mixLocation;
+    GLint m_indexedLocation;
+};
+
+#endif // PRESENT_SHADER_H
@@ -33,7 +33,7 @@ bool ProjectMVisualizer::initialize(int width, int height) {
 
     // Allocate CPU readback buffer only for the non-direct-GL fallback path
     if (!m_directGL) {
-        m_frameBuffer.resize(m_width * m_height * 3);
+        m_frameBuffer.resize(static_cast<size_t>(m_width) * m_height * 4);
     }
 
     // If using a shared GLX context, make it current before projectM init so
@@ -196,8 +196,11 @@ bool ProjectMVisualizer::render() {
         m_projectM->renderFrame();
 
         if (!m_directGL) {
-            // CPU readback fallback — used only when no GLX context was provided
-            glReadPixels(0, 0, m_width, m_height, GL_RGB, GL_UNSIGNED_BYTE,
+            // CPU readback fallback — used only when no GLX context was provided.
+            // BGRA/8_8_8_8_REV is the framebuffer's native layout on common
+            // drivers, so the readback needs no swizzle and rows stay aligned.
+            glPixelStorei(GL_PACK_ALIGNMENT, 4);
+            glReadPixels(0, 0, m_width, m_height, GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV,
                          m_frameBuffer.data());
         }
         // In direct GL mode the frame is already in the window's back-buffer;
@@ -209,7 +212,31 @@ bool ProjectMVisualizer::render() {
     }
 }
 
+bool ProjectMVisualizer::resize(int width, int height) {
+    // Direct GL draws into the window's back-buffer, which always has the
+    // window's size; only the readback path can render smaller
+    if (m_directGL || !m_initialized || !m_projectM) return false;
+    if (width == m_width && height == m_height) return true;
+
+    m_width  = width;
+    m_height = height;
+    m_frameBuffer.resize(static_cast<size_t>(m_width) * m_height * 4);
+    m_projectM->projectM_resetGL(m_width, m_height);
+    return true;
+}
+
 unsigned char* ProjectMVisualizer::getVideoData() {
     if (m_directGL || !m_initialized || m_frameBuffer.empty()) return nullptr;
     return m_frameBuffer.data();
 }
+
+FrameDescriptor ProjectMVisualizer::getFrameDescriptor() const {
+    FrameDescriptor frame;
+    frame.format = PixelFormat::BGRA32;
+    frame.width  = m_width;
+    frame.height = m_height;
+    frame.stride = m_width * 4;
+    frame.origin = FrameOrigin::BottomLeft;   // glReadPixels starts at the bottom row
+    frame.alpha  = AlphaMode::Ignored;
+    return frame;
+}
@@ -24,6 +24,7 @@ public:
     ~ProjectMVisualizer() override;
 
     bool initialize(int width, int height) override;
+    bool resize(int width, int height) override;
     void shutdown() override;
 
     bool loadPlugin(const std::string& presetName) override;
@@ -33,12 +34,14 @@ public:
     bool render() override;
 
     unsigned char* getVideoData() override;
+    FrameDescriptor getFrameDescriptor() const override;
     int getWidth() const override { return m_width; }
     int getHeight() const override { return m_height; }
     std::string getEngineName() const override { return "projectM"; }
 
     // Direct GL rendering support
     bool usesDirectGL() const override { return m_directGL; }
+    bool rendersWithGL() const override { return true; }
     bool setGLContext(void* display, unsigned long window, void* glxContext) override;
 
 private:
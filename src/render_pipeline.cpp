@@ -0,0 +1,465 @@
+#include "render_pipeline.h"
+#include "audio_input.h"
+#include "desktop_renderer.h"
+#include "frame_scheduler.h"
+#include "visualization_engine.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+namespace {
+
+// Samples handed to processAudio() at a time — one capture hop
+constexpr size_t AUDIO_CHUNK = 1024;
+// Upper bound on any wait, so stop() is noticed even without a wake-up
+constexpr std::chrono::milliseconds FRAME_WAIT(100);
+// Back-off after the engine failed to produce a frame
+constexpr std::chrono::milliseconds RENDER_RETRY(10);
+// Overlay text changes at most this often, so it stays readable
+constexpr std::chrono::milliseconds OVERLAY_REFRESH(250);
+
+} // namespace
+
+RenderPipeline::RenderPipeline(VisualizationEngine& engine, DesktopRenderer& renderer,
+                               FrameScheduler& scheduler, AudioInput& audio)
+    : m_engine(engine), m_renderer(renderer), m_scheduler(scheduler), m_audioInput(audio),
+      m_audioChunk(AUDIO_CHUNK), m_running(false), m_suspended(false), m_glEngine(false),
+      m_framesProduced(0), m_skippedFrames(0), m_frameLimit(0), m_framesShown(0),
+      m_limitReached(false), m_engineRate(0.0), m_interpolate(false), m_frameInterval(0.0),
+      m_submittedFrames(0), m_blendSettled(false), m_outputWidth(engine.getWidth()),
+      m_outputHeight(engine.getHeight()),
+      m_scalePending(false) {
+}
+
+RenderPipeline::~RenderPipeline() {
+    stop();
+}
+
+void RenderPipeline::start() {
+    if (m_running) return;
+
+    m_glEngine = m_engine.rendersWithGL();
+    m_scalePending = true;
+    m_interpolate = m_engineRate > 0.0 && !m_engine.usesDirectGL() && m_renderer.canInterpolate();
+    m_submittedFrames = 0;
+    m_blendSettled = false;
+    m_framesShown = 0;
+    m_limitReached = false;
+    // The texture may have changed hands; start from a full upload
+    m_screenTiles.clear();
+    m_latestTiles.clear();
+    m_nextEngineFrame = std::chrono::steady_clock::now();
+    if (m_engineRate > 0.0 && !m_interpolate) {
+        std::cout << m_engine.getEngineName()
+                  << (m_engine.usesDirectGL() ? ": direct GL rendering follows the display rate"
+                                              : ": engine rate without interpolation (no GL)")
+                  << std::endl;
+    }
+    m_renderer.setStageStats(&m_stageStats);
+    m_running = true;
+    m_scheduler.start();
+
+    // A GLX context is current in at most one thread
+    m_renderer.releaseContext();
+    m_presentThread = std::thread(&RenderPipeline::presentLoop, this);
+    if (!m_glEngine) {
+        m_engineThread = std::thread(&RenderPipeline::engineLoop, this);
+    }
+}
+
+void RenderPipeline::stop() {
+    if (!m_running) return;
+
+    m_running = false;
+    m_scheduler.stop();
+    m_pool.wakeAll();
+    {
+        std::lock_guard<std::mutex> lock(m_suspendMutex);
+        m_resume.notify_all();
+    }
+    if (m_engineThread.joinable()) {
+        m_engineThread.join();
+    }
+    if (m_presentThread.joinable()) {
+        m_presentThread.join();
+    }
+    m_renderer.setStageStats(nullptr);
+}
+
+void RenderPipeline::setRenderScale(double fixedScale, double budgetMs) {
+    m_renderScale.setFixedScale(fixedScale);
+    m_renderScale.setBudget(budgetMs);
+}
+
+void RenderPipeline::setPluginName(const std::string& name) {
+    std::lock_guard<std::mutex> lock(m_pluginMutex);
+    m_pluginName = name;
+}
+
+void RenderPipeline::setSuspended(bool suspended) {
+    std::lock_guard<std::mutex> lock(m_suspendMutex);
+    m_suspended = suspended;
+    m_resume.notify_all();
+}
+
+bool RenderPipeline::waitWhileSuspended() {
+    std::unique_lock<std::mutex> lock(m_suspendMutex);
+    m_resume.wait(lock, [this] { return !m_suspended || !m_running; });
+    return m_running;
+}
+
+bool RenderPipeline::frameShown() {
+    if (m_frameLimit == 0 || ++m_framesShown < m_frameLimit) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(m_suspendMutex);
+    m_limitReached = true;
+    m_limitCondition.notify_all();
+    return true;
+}
+
+bool RenderPipeline::waitForFrameLimit(std::chrono::steady_clock::time_point deadline) {
+    std::unique_lock<std::mutex> lock(m_suspendMutex);
+    return m_limitCondition.wait_until(lock, deadline, [this] { return m_limitReached; });
+}
+
+bool RenderPipeline::post(EngineCommand command) {
+    if (!m_commands.push(std::move(command))) {
+        std::cerr << "Engine command queue full, command dropped" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void RenderPipeline::feedAudio(const float* data, size_t samples) {
+    // A full ring drops the newest samples; the engine is behind anyway
+    m_audio.push(data, samples);
+    m_scheduler.audioHopReady();
+}
+
+void RenderPipeline::runCommands() {
+    EngineCommand command;
+    while (m_commands.pop(command)) {
+        switch (command.type) {
+        case EngineCommand::Type::LoadPlugin:
+            if (!m_engine.loadPlugin(command.argument)) {
+                std::cerr << "Failed to load visualization plugin: " << command.argument << std::endl;
+            } else {
+                setPluginName(command.argument);
+            }
+            break;
+        }
+    }
+}
+
+void RenderPipeline::drainAudio() {
+    StageTimer timer(&m_stageStats, Stage::Audio);
+    size_t samples;
+    while ((samples = m_audio.pop(m_audioChunk.data(), m_audioChunk.size())) > 0) {
+        m_engine.processAudio(m_audioChunk.data(), samples);
+    }
+}
+
+void RenderPipeline::discardAudio() {
+    while (m_audio.pop(m_audioChunk.data(), m_audioChunk.size()) > 0) {
+    }
+}
+
+// Renders one engine frame and records its duration, for the statistics and
+// the scale controller
+bool RenderPipeline::renderEngine() {
+    const auto begin = std::chrono::steady_clock::now();
+    if (!m_engine.render()) {
+        return false;
+    }
+    const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - begin;
+    m_stageStats.record(Stage::Engine, elapsed.count());
+    if (m_renderScale.frameRendered(elapsed.count())) {
+        m_scalePending = true;
+    }
+    return true;
+}
+
+void RenderPipeline::applyRenderScale() {
+    m_scalePending = false;
+    int width, height;
+    m_renderScale.scaledSize(m_outputWidth, m_outputHeight, width, height);
+    if (width == m_engine.getWidth() && height == m_engine.getHeight()) {
+        return;
+    }
+    if (!m_engine.resize(width, height)) {
+        std::cout << m_engine.getEngineName() << " renders at output size only; render scaling disabled"
+                  << std::endl;
+        m_renderScale.setFixedScale(1.0);
+        return;
+    }
+    std::cout << "Render scale " << static_cast<int>(m_renderScale.scale() * 100.0 + 0.5) << "%: "
+              << width << "x" << height << " for " << m_outputWidth << "x" << m_outputHeight << std::endl;
+}
+
+void RenderPipeline::advanceEngineDeadline() {
+    using Clock = std::chrono::steady_clock;
+    m_nextEngineFrame += std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(1.0 / m_engineRate));
+    const Clock::time_point now = Clock::now();
+    if (m_nextEngineFrame < now) {
+        // Behind: start afresh rather than rendering a burst to catch up
+        m_nextEngineFrame = now;
+    }
+}
+
+bool RenderPipeline::waitForEngineFrame() {
+    advanceEngineDeadline();
+    std::unique_lock<std::mutex> lock(m_suspendMutex);
+    return !m_resume.wait_until(lock, m_nextEngineFrame, [this] { return !m_running; });
+}
+
+bool RenderPipeline::produceFrame() {
+    const auto started = std::chrono::steady_clock::now();
+    if (!renderEngine()) {
+        return false;
+    }
+    const unsigned char* data = m_engine.getVideoData();
+    if (!data) {
+        return false;
+    }
+
+    // The engine's buffer is overwritten by its next render(), so the frame
+    // is copied out; the pool buffers keep their capacity across frames
+    FramePool::Frame& frame = m_pool.writeFrame();
+    frame.descriptor = m_engine.getFrameDescriptor();
+    frame.pixels.resize(frame.descriptor.sizeInBytes());
+    std::memcpy(frame.pixels.data(), data, frame.pixels.size());
+    if (frame.descriptor.palette) {
+        frame.palette.assign(frame.descriptor.palette, frame.descriptor.palette + 256);
+    } else {
+        frame.palette.clear();
+    }
+    frame.sequence = ++m_framesProduced;
+    frame.timestamp = started;
+    // Hashed here so the presentation thread only compares
+    hashTiles(frame.pixels.data(), frame.descriptor, frame.tiles);
+    m_pool.publish();
+    return true;
+}
+
+void RenderPipeline::engineLoop() {
+    while (m_running) {
+        if (m_suspended) {
+            if (!waitWhileSuspended()) break;
+            // Sound from while nothing was drawn is of no use now
+            discardAudio();
+            m_nextEngineFrame = std::chrono::steady_clock::now();
+        }
+        if (m_scalePending) {
+            applyRenderScale();
+        }
+        runCommands();
+        drainAudio();
+        if (!produceFrame()) {
+            std::this_thread::sleep_for(RENDER_RETRY);
+            continue;
+        }
+        if (m_engineRate > 0.0) {
+            // Own pace; the presenter picks frames up as they come
+            if (!waitForEngineFrame()) break;
+        } else {
+            // Render at most one frame ahead of the screen
+            m_pool.waitUntilConsumed(FRAME_WAIT);
+        }
+    }
+}
+
+bool RenderPipeline::renderGLEngineFrame() {
+    if (m_scalePending) {
+        applyRenderScale();
+    }
+    runCommands();
+    drainAudio();
+
+    if (m_engine.usesDirectGL()) {
+        // Engine renders directly into the window's GL back-buffer
+        renderEngine();
+        m_renderer.swapBuffers();
+        return true;
+    }
+    if (m_interpolate) {
+        // Same thread: render only when the engine frame is due, present always
+        const auto now = std::chrono::steady_clock::now();
+        if (now >= m_nextEngineFrame) {
+            advanceEngineDeadline();
+            if (const unsigned char* data = renderEngine() ? m_engine.getVideoData() : nullptr) {
+                const FrameDescriptor descriptor = m_engine.getFrameDescriptor();
+                hashTiles(data, descriptor, m_glEngineTiles);
+                submitFrame(data, descriptor, m_glEngineTiles, now);
+            }
+        }
+        return presentInterpolated();
+    }
+    if (renderEngine()) {
+        if (const unsigned char* data = m_engine.getVideoData()) {
+            const FrameDescriptor descriptor = m_engine.getFrameDescriptor();
+            hashTiles(data, descriptor, m_glEngineTiles);
+            return presentFrame(data, descriptor, m_glEngineTiles);
+        }
+    }
+    return true;
+}
+
+bool RenderPipeline::presentFrame(const unsigned char* data, const FrameDescriptor& descriptor,
+                                  const TileHashes& tiles) {
+    if (tiles == m_screenTiles) {
+        return false;
+    }
+    if (m_renderer.renderFrame(data, descriptor, &tiles)) {
+        m_screenTiles = tiles;
+    } else {
+        m_screenTiles.clear();
+    }
+    return true;
+}
+
+void RenderPipeline::submitFrame(const unsigned char* data, const FrameDescriptor& descriptor,
+                                 const TileHashes& tiles, std::chrono::steady_clock::time_point timestamp) {
+    // A repeat of the newest frame changes nothing; the fade to it goes on
+    if (tiles == m_latestTiles) {
+        return;
+    }
+    if (!m_renderer.submitFrame(data, descriptor, &tiles)) {
+        m_latestTiles.clear();
+        return;
+    }
+    m_latestTiles = tiles;
+    frameSubmitted(timestamp);
+}
+
+void RenderPipeline::frameSubmitted(std::chrono::steady_clock::time_point timestamp) {
+    // A gap (start, resume, a stalled engine) fades no slower than over two
+    // engine periods
+    m_frameInterval = std::min<std::chrono::duration<double>>(timestamp - m_latestFrameTime,
+                                                              std::chrono::duration<double>(2.0 / m_engineRate));
+    m_latestFrameTime = timestamp;
+    m_latestArrival = std::chrono::steady_clock::now();
+    m_submittedFrames = std::min(m_submittedFrames + 1, 2);
+    m_blendSettled = false;
+}
+
+// The view runs one engine frame behind: after each new frame arrives it
+// fades from the frame before to the new one over one engine interval, so
+// motion stays continuous at the display rate
+bool RenderPipeline::presentInterpolated() {
+    if (m_submittedFrames == 0 || m_blendSettled) {
+        return false;
+    }
+    float weight = 1.0f;
+    if (m_submittedFrames == 2 && m_frameInterval.count() > 0.0) {
+        const std::chrono::duration<double> since = std::chrono::steady_clock::now() - m_latestArrival;
+        weight = static_cast<float>(std::min(since / m_frameInterval, 1.0));
+    }
+    m_renderer.presentInterpolated(weight);
+    m_blendSettled = weight >= 1.0f;
+    return true;
+}
+
+// Everything is read where it is already kept thread-safe; the text is
+// built at most every OVERLAY_REFRESH, so its cost stays off most frames
+void RenderPipeline::updateOverlay() {
+    const auto now = std::chrono::steady_clock::now();
+    if (now < m_nextOverlayUpdate) {
+        return;
+    }
+    m_nextOverlayUpdate = now + OVERLAY_REFRESH;
+
+    std::vector<std::string> lines;
+    {
+        std::lock_guard<std::mutex> lock(m_pluginMutex);
+        lines.push_back(m_engine.getEngineName() + (m_pluginName.empty() ? "" : " / " + m_pluginName));
+    }
+    char line[160];
+    const FramePacingStats pacing = m_scheduler.stats();
+    std::snprintf(line, sizeof(line), "%.1f fps  %.2f ms  jitter %.2f  worst %.2f",
+                  pacing.meanMs > 0.0 ? 1000.0 / pacing.meanMs : 0.0, pacing.meanMs,
+                  pacing.jitterMs, pacing.worstMs);
+    lines.push_back(line);
+    std::snprintf(line, sizeof(line), "audio %.2f  engine %.2f  upload %.2f ms",
+                  m_stageStats.summary(Stage::Audio).meanMs, m_stageStats.summary(Stage::Engine).meanMs,
+                  m_stageStats.summary(Stage::Upload).meanMs);
+    lines.push_back(line);
+    std::snprintf(line, sizeof(line), "present %.2f  overlay %.3f ms",
+                  m_stageStats.summary(Stage::Present).meanMs, m_stageStats.summary(Stage::Overlay).meanMs);
+    lines.push_back(line);
+    std::snprintf(line, sizeof(line), "late %d  missed vblanks %lld  unchanged %llu",
+                  pacing.lateFrames, pacing.missedVblanks,
+                  static_cast<unsigned long long>(m_skippedFrames.load()));
+    lines.push_back(line);
+    std::snprintf(line, sizeof(line), "audio latency %.1f ms", m_audioInput.latencyMs());
+    lines.push_back(line);
+    m_renderer.setOverlayText(lines, pacing.targetMs);
+}
+
+void RenderPipeline::presentLoop() {
+    while (m_scheduler.waitForFrame()) {
+        if (m_suspended) {
+            if (!waitWhileSuspended()) break;
+            if (m_glEngine) {
+                discardAudio();
+                m_nextEngineFrame = std::chrono::steady_clock::now();
+            }
+            // Frames from before the pause are not blended into new ones
+            m_submittedFrames = std::min(m_submittedFrames, 1);
+            m_scheduler.resetTiming();
+            continue;
+        }
+
+        const bool overlay = m_renderer.overlayVisible();
+        if (overlay) {
+            updateOverlay();
+        }
+
+        bool presented = true;
+        if (m_glEngine) {
+            presented = renderGLEngineFrame();
+        } else if (m_interpolate) {
+            // Every display frame is presented; a new engine frame, if any,
+            // becomes the one faded to
+            if (m_pool.acquire() ||
+                (m_submittedFrames == 0 && m_pool.waitForFrame(FRAME_WAIT) && m_pool.acquire())) {
+                const FramePool::Frame& frame = m_pool.readFrame();
+                submitFrame(frame.pixels.data(), frame.descriptor, frame.tiles, frame.timestamp);
+            }
+            if (m_submittedFrames == 0) {
+                continue;
+            }
+            presented = presentInterpolated();
+        } else {
+            // Nothing new since the last swap: wait for the engine rather
+            // than presenting the same frame again
+            if (!m_pool.acquire() && !(m_pool.waitForFrame(FRAME_WAIT) && m_pool.acquire())) {
+                continue;
+            }
+            const FramePool::Frame& frame = m_pool.readFrame();
+            presented = presentFrame(frame.pixels.data(), frame.descriptor, frame.tiles);
+        }
+
+        if (!presented && overlay) {
+            // The picture is the same, the overlay is not
+            presented = m_renderer.presentInterpolated(1.0f);
+        }
+        if (!presented) {
+            // Same picture as on screen: neither uploaded nor swapped
+            ++m_skippedFrames;
+            m_scheduler.frameSkipped();
+        } else {
+            int64_t ust = 0, msc = 0;
+            const bool vblank = m_renderer.getVblankTiming(ust, msc);
+            m_scheduler.framePresented(vblank, ust, msc);
+        }
+        if (frameShown()) {
+            break;
+        }
+    }
+
+    // Hand the context back for shutdown on the GUI thread
+    m_renderer.releaseContext();
+}
@@ -0,0 +1,201 @@
+#ifndef RENDER_PIPELINE_H
+#define RENDER_PIPELINE_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "frame_pool.h"
+#include "render_scale.h"
+#include "spsc_queue.h"
+#include "stage_stats.h"
+
+class VisualizationEngine;
+class DesktopRenderer;
+class FrameScheduler;
+class AudioInput;
+
+/**
+ * Runs the engine and the presentation on their own threads.
+ *
+ * The engine thread renders into a triple-buffered FramePool, at most one
+ * frame ahead of the screen.  The presentation thread owns the GLX context:
+ * it waits on the FrameScheduler, picks up the newest finished frame and
+ * uploads and swaps it, so a slow engine frame never delays a swap and a
+ * slow swap never stalls the engine.
+ *
+ * The engine is touched only by the pipeline while it runs.  GUI commands
+ * and audio reach it through single-producer queues drained at the start of
+ * each engine frame.  Engines that render with OpenGL themselves (projectM)
+ * are driven from the presentation thread, which owns the context.
+ *
+ * The engine side also times each engine frame and resizes the engine when
+ * the RenderScaleController asks for it; the renderer stretches the
+ * smaller frames to the output.
+ *
+ * With an engine rate set, the engine thread renders at that rate on its
+ * own deadlines instead of once per presented frame, and the presentation
+ * thread presents every display frame as a cross-fade between the two
+ * newest engine frames, weighted by their timestamps (GL path only).
+ *
+ * Every engine frame is hashed per tile where it is produced.  A frame
+ * identical to the one on screen is neither uploaded nor swapped, and of a
+ * changed frame only the changed tiles are uploaded (GL path).
+ *
+ * Audio, engine, upload and present times of every frame are collected in
+ * stageStats() while the pipeline runs.  While the renderer's performance
+ * overlay is visible the presentation thread refreshes its text a few
+ * times a second, and presents unchanged frames too, so the overlay keeps
+ * moving.
+ */
+class RenderPipeline {
+public:
+    struct EngineCommand {
+        enum class Type {
+            LoadPlugin
+        };
+        Type type;
+        std::string argument;
+    };
+
+    RenderPipeline(VisualizationEngine& engine, DesktopRenderer& renderer,
+                   FrameScheduler& scheduler, AudioInput& audio);
+    ~RenderPipeline();
+
+    // Starts the scheduler and both threads; the renderer's GL context is
+    // handed over to the presentation thread
+    void start();
+    void stop();
+    bool isRunning() const { return m_running; }
+
+    // Resolution the engine renders at relative to its size at construction:
+    // fixedScale in (0, 1], or 0 to hold engine frames within budgetMs.
+    // Takes effect on the next start().
+    void setRenderScale(double fixedScale, double budgetMs);
+
+    // Frames per second the engine renders at, independent of the display;
+    // 0 renders one engine frame per presented frame.  Takes effect on the
+    // next start().
+    void setEngineRate(double fps) { m_engineRate = fps; }
+
+    // Plugin the engine already has loaded, for the overlay; later
+    // LoadPlugin commands update it
+    void setPluginName(const std::string& name);
+
+    // Parks both threads (and leaves the last frame on screen) until
+    // resumed; for outputs nobody can see
+    void setSuspended(bool suspended);
+
+    // Frames the presentation thread shows before it stops presenting, where
+    // frames skipped as unchanged count as shown; 0 for no limit.  Takes
+    // effect on the next start().
+    void setFrameLimit(uint64_t frames) { m_frameLimit = frames; }
+    // Blocks until the frame limit was reached, up to deadline; true if it was
+    bool waitForFrameLimit(std::chrono::steady_clock::time_point deadline);
+
+    // GUI thread.  Commands queue up while stopped and run on the next start.
+    bool post(EngineCommand command);
+
+    // Audio thread: queues samples for the engine and wakes audio-driven pacing
+    void feedAudio(const float* data, size_t samples);
+
+    const StageStats& stageStats() const { return m_stageStats; }
+    // Display frames skipped since construction because nothing had changed
+    uint64_t skippedFrames() const { return m_skippedFrames; }
+
+private:
+    void engineLoop();
+    void presentLoop();
+    // Blocks while suspended; false once the pipeline is stopping
+    bool waitWhileSuspended();
+    // Presentation side: counts a shown frame; true once the limit is reached
+    bool frameShown();
+
+    // Engine side: on the engine thread, or the presentation thread for GL engines
+    void runCommands();
+    void drainAudio();
+    void discardAudio();
+    bool produceFrame();
+    // Each returns false when the picture had not changed and nothing was
+    // presented
+    bool renderGLEngineFrame();
+    bool presentFrame(const unsigned char* data, const FrameDescriptor& descriptor,
+                      const TileHashes& tiles);
+    bool renderEngine();
+    void applyRenderScale();
+    // Presentation side: new overlay text when the last is old enough
+    void updateOverlay();
+    // Engine rate: moves the deadline of the next engine frame on, and
+    // sleeps until it; false once the pipeline is stopping
+    void advanceEngineDeadline();
+    bool waitForEngineFrame();
+
+    // Presentation side of interpolation
+    void submitFrame(const unsigned char* data, const FrameDescriptor& descriptor,
+                     const TileHashes& tiles, std::chrono::steady_clock::time_point timestamp);
+    void frameSubmitted(std::chrono::steady_clock::time_point timestamp);
+    bool presentInterpolated();
+
+    VisualizationEngine& m_engine;
+    DesktopRenderer& m_renderer;
+    FrameScheduler& m_scheduler;
+    AudioInput& m_audioInput;
+
+    FramePool m_pool;
+    SpscQueue<EngineCommand, 16> m_commands;
+    SpscQueue<float, 16384> m_audio;  // interleaved samples, ~16 capture hops
+    std::vector<float> m_audioChunk;
+
+    std::thread m_engineThread;
+    std::thread m_presentThread;
+    std::atomic<bool> m_running;
+    std::mutex m_suspendMutex;
+    std::condition_variable m_resume;
+    std::atomic<bool> m_suspended;
+    bool m_glEngine;
+    uint64_t m_framesProduced;
+    StageStats m_stageStats;
+    std::atomic<uint64_t> m_skippedFrames;
+
+    // Presentation side: hashes of what the screen shows, and of the newest
+    // frame when interpolating (empty: unknown)
+    TileHashes m_screenTiles;
+    TileHashes m_latestTiles;
+    TileHashes m_glEngineTiles;  // scratch for GL engines' frames
+
+    // Frame limit: the count is presentation side, m_limitReached is
+    // guarded by m_suspendMutex
+    uint64_t m_frameLimit;
+    uint64_t m_framesShown;
+    bool m_limitReached;
+    std::condition_variable m_limitCondition;
+
+    // Engine rate and interpolation
+    double m_engineRate;
+    bool m_interpolate;     // the presenter blends; decided at start()
+    std::chrono::steady_clock::time_point m_nextEngineFrame;  // engine side
+    // Presentation side: the newest submitted frame's engine timestamp and
+    // arrival, and the engine interval between it and the one before
+    std::chrono::steady_clock::time_point m_latestFrameTime;
+    std::chrono::steady_clock::time_point m_latestArrival;
+    std::chrono::duration<double> m_frameInterval;
+    int m_submittedFrames;  // since start() or a resume, up to 2
+    bool m_blendSettled;    // the newest frame is on screen unblended
+
+    // Overlay: the plugin name is written by the engine side
+    std::mutex m_pluginMutex;
+    std::string m_pluginName;
+    std::chrono::steady_clock::time_point m_nextOverlayUpdate;  // presentation side
+
+    // Engine side only
+    RenderScaleController m_renderScale;
+    int m_outputWidth;
+    int m_outputHeight;
+    bool m_scalePending;
+};
+
+#endif // RENDER_PIPELINE_H
@@ -0,0 +1,88 @@
+#include "render_scale.h"
+#include <algorithm>
+
+namespace {
+
+// Linear scale of each step; cost follows the pixel count (scale squared)
+constexpr double LADDER[] = {1.0, 0.85, 0.75, 2.0 / 3.0, 0.5, 0.4, 1.0 / 3.0, 0.25};
+constexpr int STEPS = sizeof(LADDER) / sizeof(LADDER[0]);
+
+// Drop to a step predicted to use this much of the budget
+constexpr double DOWN_TARGET = 0.9;
+// Rise only when the larger step is predicted to stay under this share
+constexpr double UP_THRESHOLD = 0.7;
+
+constexpr double DEFAULT_BUDGET_MS = 12.0;
+constexpr int MIN_DIMENSION = 16;
+
+double predictedMs(double meanMs, int from, int to) {
+    const double ratio = LADDER[to] / LADDER[from];
+    return meanMs * ratio * ratio;
+}
+
+} // namespace
+
+RenderScaleController::RenderScaleController()
+    : m_automatic(true), m_fixedScale(1.0), m_budgetMs(DEFAULT_BUDGET_MS),
+      m_step(0), m_frames(0), m_settle(0), m_totalMs(0.0) {
+}
+
+void RenderScaleController::setBudget(double budgetMs) {
+    m_budgetMs = budgetMs > 0.0 ? budgetMs : DEFAULT_BUDGET_MS;
+}
+
+void RenderScaleController::setFixedScale(double scale) {
+    m_automatic = scale <= 0.0;
+    m_fixedScale = std::clamp(scale, LADDER[STEPS - 1], 1.0);
+    m_frames = 0;
+    m_totalMs = 0.0;
+}
+
+double RenderScaleController::scale() const {
+    return m_automatic ? LADDER[m_step] : m_fixedScale;
+}
+
+bool RenderScaleController::frameRendered(double engineMs) {
+    if (!m_automatic) {
+        return false;
+    }
+    if (m_settle > 0) {
+        --m_settle;
+        return false;
+    }
+
+    m_totalMs += engineMs;
+    if (++m_frames < WINDOW) {
+        return false;
+    }
+    const double meanMs = m_totalMs / m_frames;
+    m_frames = 0;
+    m_totalMs = 0.0;
+
+    int step = m_step;
+    if (meanMs > m_budgetMs) {
+        // As far down as needed, at least one step
+        step = std::min(step + 1, STEPS - 1);
+        while (step < STEPS - 1 && predictedMs(meanMs, m_step, step) > DOWN_TARGET * m_budgetMs) {
+            ++step;
+        }
+    } else if (step > 0 && predictedMs(meanMs, m_step, step - 1) < UP_THRESHOLD * m_budgetMs) {
+        --step;
+    }
+
+    if (step == m_step) {
+        return false;
+    }
+    m_step = step;
+    m_settle = SETTLE;
+    return true;
+}
+
+void RenderScaleController::scaledSize(int width, int height, int& scaledWidth, int& scaledHeight) const {
+    const double s = scale();
+    // Even sizes, never larger than the output
+    scaledWidth  = std::max(MIN_DIMENSION, static_cast<int>(width * s) & ~1);
+    scaledHeight = std::max(MIN_DIMENSION, static_cast<int>(height * s) & ~1);
+    scaledWidth  = std::min(scaledWidth, width);
+    scaledHeight = std::min(scaledHeight, height);
+}
@@ -0,0 +1,48 @@
+#ifndef RENDER_SCALE_H
+#define RENDER_SCALE_H
+
+/**
+ * Picks the resolution an engine renders at, as a fraction of its output's
+ * size; the renderer stretches the frame back up (on the GPU when it can).
+ *
+ * Automatic mode keeps the mean engine frame time within a budget.  Every
+ * WINDOW frames the mean is compared with the budget: over it, the scale
+ * drops as many steps as the pixel count says are needed; when even the
+ * next larger step would stay well under it, the scale rises one step.
+ * Frames right after a change are not measured, since engines warm up
+ * after a resize.
+ */
+class RenderScaleController {
+public:
+    RenderScaleController();
+
+    // Engine frame-time budget of automatic mode, in milliseconds
+    void setBudget(double budgetMs);
+    double budget() const { return m_budgetMs; }
+
+    // 0 < scale <= 1 fixes the scale; 0 selects automatic scaling
+    void setFixedScale(double scale);
+    bool isAutomatic() const { return m_automatic; }
+
+    double scale() const;
+
+    // Reports the time one engine frame took; true when scale() changed
+    bool frameRendered(double engineMs);
+
+    // Engine size for an output of width x height at the current scale
+    void scaledSize(int width, int height, int& scaledWidth, int& scaledHeight) const;
+
+private:
+    static constexpr int WINDOW = 30;   // frames per decision
+    static constexpr int SETTLE = 10;   // frames ignored after a change
+
+    bool m_automatic;
+    double m_fixedScale;
+    double m_budgetMs;
+    int m_step;          // index into the scale ladder
+    int m_frames;
+    int m_settle;
+    double m_totalMs;
+};
+
+#endif // RENDER_SCALE_H
@@ -0,0 +1,87 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/**
+ * Bounded lock-free queue for exactly one producer and one consumer thread.
+ *
+ * Head and tail are free-running counters, each written by one side only,
+ * so neither side ever blocks or takes a lock: a full queue makes push()
+ * fail and an empty one makes pop() fail.  Capacity must be a power of two.
+ */
+template <typename T, size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+                  "SpscQueue capacity must be a power of two");
+
+public:
+    SpscQueue() : m_items(Capacity), m_head(0), m_tail(0) {}
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // Producer side
+    bool push(T value) {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (head - m_tail.load(std::memory_order_acquire) == Capacity) {
+            return false;
+        }
+        m_items[head & MASK] = std::move(value);
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Producer side: copies as many of count items as fit, returns how many
+    size_t push(const T* items, size_t count) {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        const size_t room = Capacity - (head - m_tail.load(std::memory_order_acquire));
+        const size_t n = count < room ? count : room;
+        for (size_t i = 0; i < n; ++i) {
+            m_items[(head + i) & MASK] = items[i];
+        }
+        m_head.store(head + n, std::memory_order_release);
+        return n;
+    }
+
+    // Consumer side
+    bool pop(T& value) {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (m_head.load(std::memory_order_acquire) == tail) {
+            return false;
+        }
+        value = std::move(m_items[tail & MASK]);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side: moves up to count items out, returns how many
+    size_t pop(T* items, size_t count) {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        const size_t available = m_head.load(std::memory_order_acquire) - tail;
+        const size_t n = count < available ? count : available;
+        for (size_t i = 0; i < n; ++i) {
+            items[i] = std::move(m_items[(tail + i) & MASK]);
+        }
+        m_tail.store(tail + n, std::memory_order_release);
+        return n;
+    }
+
+    // Exact only when called from either side; a snapshot otherwise
+    size_t size() const {
+        return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire);
+    }
+
+private:
+    static constexpr size_t MASK = Capacity - 1;
+
+    std::vector<T> m_items;
+    // Separate cache lines so the two sides do not false-share
+    alignas(64) std::atomic<size_t> m_head;  // written by the producer
+    alignas(64) std::atomic<size_t> m_tail;  // written by the consumer
+};
+
+#endif // SPSC_QUEUE_H
@@ -0,0 +1,67 @@
+#include "stage_stats.h"
+#include <algorithm>
+
+StageStats::StageStats() {
+    for (Ring& ring : m_rings) {
+        ring.samples.reserve(WINDOW);
+    }
+}
+
+void StageStats::record(Stage stage, double ms) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Ring& ring = m_rings[static_cast<int>(stage)];
+    if (ring.samples.size() < WINDOW) {
+        ring.samples.push_back(ms);
+    } else {
+        ring.samples[ring.head] = ms;
+        ring.head = (ring.head + 1) % WINDOW;
+    }
+    ++ring.frames;
+}
+
+StageSummary StageStats::summary(Stage stage) const {
+    std::vector<double> sorted;
+    StageSummary s;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const Ring& ring = m_rings[static_cast<int>(stage)];
+        s.frames = ring.frames;
+        sorted = ring.samples;
+    }
+    if (sorted.empty()) {
+        return s;
+    }
+
+    std::sort(sorted.begin(), sorted.end());
+    double sum = 0.0;
+    for (double ms : sorted) {
+        sum += ms;
+    }
+    s.meanMs = sum / sorted.size();
+    s.p50Ms = sorted[sorted.size() / 2];
+    s.p95Ms = sorted[std::min(sorted.size() - 1, sorted.size() * 95 / 100)];
+    s.worstMs = sorted.back();
+    return s;
+}
+
+void StageStats::reset() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (Ring& ring : m_rings) {
+        ring.samples.clear();
+        ring.head = 0;
+        ring.frames = 0;
+    }
+}
+
+const char* StageStats::stageName(Stage stage) {
+    switch (stage) {
+    case Stage::Audio:    return "audio";
+    case Stage::Engine:   return "engine";
+    case Stage::Upload:   return "upload";
+    case Stage::Present:  return "present";
+    case Stage::Overlay:  return "overlay";
+    case Stage::Readback: return "readback";
+    case Stage::Count:    break;
+    }
+    return "unknown";
+}
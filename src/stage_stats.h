@@ -0,0 +1,93 @@
+#ifndef STAGE_STATS_H
+#define STAGE_STATS_H
+
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+/**
+ * Stages of the frame path, timed separately:
+ *
+ * Audio    — handing the queued capture to the engine (processAudio),
+ *            once per engine frame
+ * Engine   — one engine render(), on the engine thread (or the
+ *            presentation thread for GL engines)
+ * Upload   — bringing a frame into the screen's format: the texture upload
+ *            on the GL path, conversion and scaling on the software path
+ * Present  — drawing and swapping, including a swap that waits for vblank,
+ *            or putting the image on the software path
+ * Overlay  — drawing the performance overlay, part of Present
+ * Readback — reading the presented image back to checksum it (headless)
+ */
+enum class Stage {
+    Audio,
+    Engine,
+    Upload,
+    Present,
+    Overlay,
+    Readback,
+    Count
+};
+
+struct StageSummary {
+    long long frames = 0;  // since the last reset
+    double meanMs = 0.0;   // over the most recent window
+    double p50Ms = 0.0;
+    double p95Ms = 0.0;
+    double worstMs = 0.0;
+};
+
+/**
+ * Durations of the stages over the most recent frames.  Thread-safe: the
+ * stages are recorded from different threads.
+ */
+class StageStats {
+public:
+    StageStats();
+
+    void record(Stage stage, double ms);
+    StageSummary summary(Stage stage) const;
+    void reset();
+
+    static const char* stageName(Stage stage);
+
+private:
+    static constexpr size_t WINDOW = 600;
+    static constexpr int STAGES = static_cast<int>(Stage::Count);
+
+    struct Ring {
+        std::vector<double> samples;
+        size_t head = 0;
+        long long frames = 0;
+    };
+
+    mutable std::mutex m_mutex;
+    Ring m_rings[STAGES];
+};
+
+/**
+ * Records the lifetime of the object as one sample of a stage; does nothing
+ * when stats is null.
+ */
+class StageTimer {
+public:
+    StageTimer(StageStats* stats, Stage stage)
+        : m_stats(stats), m_stage(stage), m_start(std::chrono::steady_clock::now()) {}
+    ~StageTimer() {
+        if (m_stats) {
+            const std::chrono::duration<double, std::milli> elapsed =
+                std::chrono::steady_clock::now() - m_start;
+            m_stats->record(m_stage, elapsed.count());
+        }
+    }
+    StageTimer(const StageTimer&) = delete;
+    StageTimer& operator=(const StageTimer&) = delete;
+
+private:
+    StageStats* m_stats;
+    Stage m_stage;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+#endif // STAGE_STATS_H
@@ -3,6 +3,58 @@
 
 #include <vector>
 #include <string>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Memory layout of one pixel in a frame returned by getVideoData().
+ */
+enum class PixelFormat {
+    RGB24,   // R, G, B bytes
+    BGR24,   // B, G, R bytes
+    RGBA32,  // R, G, B, A bytes
+    BGRA32,  // native-endian 0xAARRGGBB words (B, G, R, A bytes on little-endian)
+    Indexed8 // one byte per pixel indexing FrameDescriptor::palette
+};
+
+/** Row order of a frame: first row in memory is the top or the bottom one. */
+enum class FrameOrigin {
+    TopLeft,     // CPU renderers (libvisual)
+    BottomLeft   // OpenGL readback
+};
+
+/** How the fourth channel of 32-bit formats is to be read. */
+enum class AlphaMode {
+    Ignored,       // padding (XRGB), the frame is opaque
+    Straight,
+    Premultiplied
+};
+
+/**
+ * Describes the frame an engine produces, so the renderer can consume it in
+ * its native layout instead of assuming one.
+ */
+struct FrameDescriptor {
+    PixelFormat format = PixelFormat::RGB24;
+    int width  = 0;
+    int height = 0;
+    int stride = 0;   // bytes from one row to the next, >= width * bytesPerPixel()
+    FrameOrigin origin = FrameOrigin::TopLeft;
+    AlphaMode alpha = AlphaMode::Ignored;
+    // Indexed8 only: 256 colours as BGRA32 words, valid until the next render()
+    const uint32_t* palette = nullptr;
+
+    static int bytesPerPixel(PixelFormat format) {
+        switch (format) {
+        case PixelFormat::RGB24:
+        case PixelFormat::BGR24:    return 3;
+        case PixelFormat::Indexed8: return 1;
+        default:                    return 4;
+        }
+    }
+    int bytesPerPixel() const { return bytesPerPixel(format); }
+    size_t sizeInBytes() const { return static_cast<size_t>(stride) * height; }
+};
 
 /**
  * Abstract interface for visualization engines.
@@ -20,6 +72,14 @@ public:
      */
     virtual bool initialize(int width, int height) = 0;
 
+    /**
+     * Change the size frames are rendered at, keeping the loaded plugin.
+     * Used for dynamic resolution scaling; engines that cannot render at
+     * a size other than their output's return false.
+     * @return true on success, false when unsupported or on failure
+     */
+    virtual bool resize(int /*width*/, int /*height*/) { return false; }
+
     /**
      * Shutdown and cleanup the visualization engine.
      */
@@ -54,10 +114,22 @@ public:
 
     /**
      * Get pointer to rendered video frame data.
-     * @return Pointer to RGB/RGBA pixel data
+     * @return Pointer to pixel data laid out as getFrameDescriptor() says
      */
     virtual unsigned char* getVideoData() = 0;
 
+    /**
+     * Describe the layout of the data returned by getVideoData().
+     * The default is tightly packed, top-down RGB24 of getWidth() x getHeight().
+     */
+    virtual FrameDescriptor getFrameDescriptor() const {
+        FrameDescriptor frame;
+        frame.width  = getWidth();
+        frame.height = getHeight();
+        frame.stride = frame.width * frame.bytesPerPixel();
+        return frame;
+    }
+
     /**
      * Get current video width.
      * @return Width in pixels
@@ -83,6 +155,14 @@ public:
      */
     virtual bool usesDirectGL() const { return false; }
 
+    /**
+     * Returns true if the engine issues OpenGL calls (directly or for a
+     * readback).  Such engines must run on the thread that owns the GL
+     * context, so the render pipeline drives them from its presentation
+     * thread instead of a separate engine thread.
+     */
+    virtual bool rendersWithGL() const { return usesDirectGL(); }
+
     /**
      * Provide an existing GLX context so the engine can render directly into
      * the desktop window without a GPU→CPU readback.  Returns true on success.
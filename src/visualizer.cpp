@@ -4,7 +4,8 @@
 
 Visualizer::Visualizer() 
     : m_video(nullptr), m_audio(nullptr), m_actor(nullptr), 
-      m_samplePool(nullptr), m_width(0), m_height(0), m_initialized(false) {
+      m_samplePool(nullptr), m_width(0), m_height(0), m_depth(VISUAL_VIDEO_DEPTH_32BIT),
+      m_initialized(false), m_palette(256, 0xFF000000u) {
 }
 
 Visualizer::~Visualizer() {
@@ -15,12 +16,6 @@ bool Visualizer::initialize(int width, int height) {
     // LibVisual should already be initialized in main
     std::cout << "Initializing visualizer with dimensions: " << width << "x" << height << std::endl;
     
-    // Use fixed small size for testing
-    width = 800;
-    height = 600;
-    
-    std::cout << "Using test dimensions: " << width << "x" << height << std::endl;
-    
     m_width = width;
     m_height = height;
 
@@ -31,9 +26,10 @@ bool Visualizer::initialize(int width, int height) {
         return false;
     }
 
-    // Set video properties
+    // Set video properties; loadPlugin() switches to the actor's own depth
+    m_depth = VISUAL_VIDEO_DEPTH_32BIT;
+    visual_video_set_depth(m_video, m_depth);
     visual_video_set_dimension(m_video, m_width, m_height);
-    visual_video_set_depth(m_video, VISUAL_VIDEO_DEPTH_32BIT);
     
     if (visual_video_allocate_buffer(m_video) != VISUAL_OK) {
         std::cerr << "Failed to allocate video buffer" << std::endl;
@@ -56,6 +52,31 @@ bool Visualizer::initialize(int width, int height) {
     return true;
 }
 
+bool Visualizer::resize(int width, int height) {
+    if (!m_initialized || !m_video) {
+        return false;
+    }
+    if (width == m_width && height == m_height) {
+        return true;
+    }
+
+    visual_video_free_buffer(m_video);
+    visual_video_set_dimension(m_video, width, height);
+    if (visual_video_allocate_buffer(m_video) != VISUAL_OK) {
+        std::cerr << "Failed to reallocate video buffer at " << width << "x" << height << std::endl;
+        return false;
+    }
+    m_width = width;
+    m_height = height;
+
+    // Let the actor pick up the new dimensions
+    if (m_actor && visual_actor_video_negotiate(m_actor, 0, FALSE, FALSE) != VISUAL_OK) {
+        std::cerr << "Failed to renegotiate video after resize" << std::endl;
+        return false;
+    }
+    return true;
+}
+
 void Visualizer::shutdown() {
     if (m_actor) {
         visual_object_unref(VISUAL_OBJECT(m_actor));
@@ -101,13 +122,30 @@ bool Visualizer::loadPlugin(const std::string& pluginName) {
         return false;
     }
 
+    // Native depth: 8-bit actors draw straight into an indexed video, so
+    // neither libvisual nor the renderer converts on the CPU; the palette is
+    // applied when the frame is presented.  Everything else renders 32-bit
+    // (libvisual converts 16- and 24-bit actors).
+    const int supported = visual_actor_get_supported_depth(m_actor);
+    const int depth = (supported & VISUAL_VIDEO_DEPTH_8BIT) && !(supported & VISUAL_VIDEO_DEPTH_32BIT)
+                    ? VISUAL_VIDEO_DEPTH_8BIT : VISUAL_VIDEO_DEPTH_32BIT;
+    if (!setVideoDepth(depth)) {
+        visual_object_unref(VISUAL_OBJECT(m_actor));
+        m_actor = nullptr;
+        return false;
+    }
+
     // Connect video
-    if (visual_actor_set_video(m_actor, m_video) != VISUAL_OK) {
+    if (visual_actor_set_video(m_actor, m_video) != VISUAL_OK ||
+        visual_actor_video_negotiate(m_actor, 0, FALSE, FALSE) != VISUAL_OK) {
         std::cerr << "Failed to set video for plugin: " << pluginName << std::endl;
         visual_object_unref(VISUAL_OBJECT(m_actor));
         m_actor = nullptr;
         return false;
     }
+    if (m_depth == VISUAL_VIDEO_DEPTH_8BIT) {
+        std::cout << pluginName << " renders 8-bit indexed frames" << std::endl;
+    }
 
     std::cout << "Successfully loaded plugin: " << pluginName << std::endl;
     return true;
@@ -177,13 +215,61 @@ bool Visualizer::render() {
         return false;
     }
 
+    if (m_depth == VISUAL_VIDEO_DEPTH_8BIT) {
+        updatePalette();
+    }
+    return true;
+}
+
+bool Visualizer::setVideoDepth(int depth) {
+    if (depth == m_depth) {
+        return true;
+    }
+
+    visual_video_free_buffer(m_video);
+    visual_video_set_depth(m_video, depth);
+    // Recomputes the pitch for the new pixel size
+    visual_video_set_dimension(m_video, m_width, m_height);
+    if (visual_video_allocate_buffer(m_video) != VISUAL_OK) {
+        std::cerr << "Failed to reallocate video buffer for depth " << depth << std::endl;
+        return false;
+    }
+    m_depth = depth;
     return true;
 }
 
+void Visualizer::updatePalette() {
+    VisPalette* palette = visual_actor_get_palette(m_actor);
+    if (!palette || !palette->colors) {
+        return;
+    }
+    const int colors = std::min(palette->ncolors, static_cast<int>(m_palette.size()));
+    for (int i = 0; i < colors; ++i) {
+        const VisColor& color = palette->colors[i];
+        m_palette[i] = 0xFF000000u | (static_cast<uint32_t>(color.r) << 16) |
+                       (static_cast<uint32_t>(color.g) << 8) | color.b;
+    }
+}
+
 unsigned char* Visualizer::getVideoData() {
     if (!m_video) {
         return nullptr;
     }
 
     return static_cast<unsigned char*>(visual_video_get_pixels(m_video));
-}
\ No newline at end of file
+}
+
+FrameDescriptor Visualizer::getFrameDescriptor() const {
+    // 32-bit VisVideo pixels are native-endian 0x00RRGGBB words, 8-bit ones
+    // indices into the actor's palette; top row first either way
+    FrameDescriptor frame;
+    const bool indexed = m_depth == VISUAL_VIDEO_DEPTH_8BIT;
+    frame.format  = indexed ? PixelFormat::Indexed8 : PixelFormat::BGRA32;
+    frame.width   = m_width;
+    frame.height  = m_height;
+    frame.stride  = m_video ? m_video->pitch : m_width * frame.bytesPerPixel();
+    frame.origin  = FrameOrigin::TopLeft;
+    frame.alpha   = AlphaMode::Ignored;
+    frame.palette = indexed ? m_palette.data() : nullptr;
+    return frame;
+}
@@ -13,6 +13,7 @@ public:
     ~Visualizer() override;
 
     bool initialize(int width, int height) override;
+    bool resize(int width, int height) override;
     void shutdown() override;
 
     bool loadPlugin(const std::string& pluginName) override;
@@ -22,11 +23,16 @@ public:
     bool render() override;
 
     unsigned char* getVideoData() override;
+    FrameDescriptor getFrameDescriptor() const override;
     int getWidth() const override { return m_width; }
     int getHeight() const override { return m_height; }
     std::string getEngineName() const override { return "libvisual"; }
 
 private:
+    // Reallocates the video buffer in another depth, keeping its size
+    bool setVideoDepth(int depth);
+    void updatePalette();
+
     VisVideo* m_video;
     VisAudio* m_audio;
     VisActor* m_actor;
@@ -34,7 +40,11 @@ private:
     
     int m_width;
     int m_height;
+    int m_depth;                    // VISUAL_VIDEO_DEPTH_8BIT or _32BIT
     bool m_initialized;
+
+    // 8-bit actors: their palette as BGRA32 words, refreshed every frame
+    std::vector<uint32_t> m_palette;
     
     std::vector<int16_t> m_audioBuffer;
 };
@@ -0,0 +1,79 @@
+#include "worker_pool.h"
+#include <algorithm>
+
+WorkerPool::WorkerPool(int threads)
+    : m_job(nullptr), m_count(0), m_pending(0), m_generation(0), m_stop(false) {
+    if (threads <= 0) {
+        threads = std::clamp(static_cast<int>(std::thread::hardware_concurrency()), 1, MAX_THREADS);
+    }
+    // The caller works too, so it needs one thread less
+    for (int band = 1; band < threads; ++band) {
+        m_threads.emplace_back(&WorkerPool::workerLoop, this, band);
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wake.notify_all();
+    for (std::thread& thread : m_threads) {
+        thread.join();
+    }
+}
+
+void WorkerPool::parallelFor(int count, const std::function<void(int, int)>& fn) {
+    if (count <= 0) {
+        return;
+    }
+    if (m_threads.empty() || count < size()) {
+        fn(0, count);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_job = &fn;
+        m_count = count;
+        m_pending = static_cast<int>(m_threads.size());
+        ++m_generation;
+    }
+    m_wake.notify_all();
+
+    runBand(0);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done.wait(lock, [this] { return m_pending == 0; });
+    m_job = nullptr;
+}
+
+void WorkerPool::runBand(int band) {
+    const int begin = static_cast<int>(static_cast<long long>(m_count) * band / size());
+    const int end   = static_cast<int>(static_cast<long long>(m_count) * (band + 1) / size());
+    if (begin < end) {
+        (*m_job)(begin, end);
+    }
+}
+
+void WorkerPool::workerLoop(int band) {
+    unsigned seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [&] { return m_stop || m_generation != seen; });
+            if (m_stop) {
+                return;
+            }
+            seen = m_generation;
+        }
+
+        // m_job and m_count stay fixed until every band has reported back
+        runBand(band);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (--m_pending == 0) {
+            m_done.notify_one();
+        }
+    }
+}
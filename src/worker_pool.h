@@ -0,0 +1,52 @@
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <vector>
+
+/**
+ * Small set of persistent threads for data-parallel loops.
+ *
+ * parallelFor() cuts a range into one contiguous band per thread — the
+ * calling thread takes the first band — and returns once every band is
+ * done.  Threads sleep on a condition variable between calls, so a per-frame
+ * loop costs one wake-up instead of thread creation.
+ */
+class WorkerPool {
+public:
+    // threads == 0 picks the hardware concurrency, capped at MAX_THREADS
+    explicit WorkerPool(int threads = 0);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    // Threads taking part in parallelFor(), including the caller
+    int size() const { return static_cast<int>(m_threads.size()) + 1; }
+
+    // Calls fn(begin, end) for bands covering [0, count).  Not reentrant.
+    void parallelFor(int count, const std::function<void(int, int)>& fn);
+
+    static constexpr int MAX_THREADS = 8;
+
+private:
+    void workerLoop(int band);
+    void runBand(int band);
+
+    std::vector<std::thread> m_threads;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_done;
+
+    // Current job, guarded by m_mutex
+    const std::function<void(int, int)>* m_job;
+    int m_count;
+    int m_pending;          // worker bands not finished yet
+    unsigned m_generation;  // bumped per job so workers run each one once
+    bool m_stop;
+};
+
+#endif // WORKER_POOL_H
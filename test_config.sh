@@ -7,6 +7,7 @@ set -euo pipefail
 INSTALL_ROOT="${HOME}/.local/share/plasma/wallpapers/org.kde.libvisual"
 CONFIG_QML="${INSTALL_ROOT}/contents/ui/config.qml"
 MAIN_QML="${INSTALL_ROOT}/contents/ui/main.qml"
+VIS_DIR="${INSTALL_ROOT}/contents/ui/visualizations"
 MAIN_XML="${INSTALL_ROOT}/contents/config/main.xml"
 
 PASS=0; FAIL=0
@@ -32,13 +33,14 @@ grep -q "paSourceNames"                         "$CONFIG_QML" && ok "paSourceNam
 grep -q "sources\[i\].description"             "$CONFIG_QML" && ok "shows source descriptions"            || fail "does not display source descriptions"
 grep -q "sources\[i\].name"                    "$CONFIG_QML" && ok "stores source names"                  || fail "does not store source names"
 
-section "config.qml – 20 visualization types"
+section "config.qml – 22 visualization types"
 VIZ_TYPES=(
     "Spectrum Analyzer" "Waveform" "Lissajous" "Circular Burst"
     "Circular Spectrum" "Plasma" "Starfield" "Fireworks"
     "Matrix Rain" "DNA Helix" "Particle Storm" "Ripple Effect"
     "Tunnel Vision" "Spiral Galaxy" "Lightning" "Mandelbrot Zoom"
     "Geometric Dance" "Audio Bars 3D" "Kaleidoscope" "ProjectM Visualizer"
+    "Spectrogram" "Deep Zoom Mandelbrot"
 )
 for vt in "${VIZ_TYPES[@]}"; do
     grep -q "$vt" "$CONFIG_QML" && ok "viz type present: $vt" || fail "viz type missing: $vt"
@@ -53,13 +55,21 @@ grep -q "previewCanvas"             "$CONFIG_QML" && ok "single previewCanvas pr
 ! grep -q "children\[0\].children\[" "$CONFIG_QML" \
                                     && ok "no fragile children[] indexing"            || fail "fragile children[] indexing still present"
 
-section "main.qml – all 20 viz types implemented"
-for type_id in 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19; do
-    grep -q "visualizationType === ${type_id}" "$MAIN_QML" \
-        && ok "type ${type_id} handled in main.qml" \
-        || fail "type ${type_id} NOT handled in main.qml"
+section "visualizations – all 22 viz types implemented"
+# Type number → file, mirrors the table in visualizationregistry.cpp
+VIS_FILES=(SpectrumBars Waveform Oscilloscope CircularBurst CircularSpectrum Plasma
+           Starfield Fireworks MatrixRain DnaHelix ParticleStorm RippleEffect
+           TunnelVision SpiralGalaxy Lightning Mandelbrot GeometricDance AudioBars3D
+           Kaleidoscope ProjectM Spectrogram DeepMandelbrot)
+grep -q "VisualizationHost" "$MAIN_QML" \
+    && ok "main.qml hosts visualizations via VisualizationHost" \
+    || fail "VisualizationHost missing from main.qml"
+for type_id in "${!VIS_FILES[@]}"; do
+    [[ -f "${VIS_DIR}/${VIS_FILES[$type_id]}.qml" ]] \
+        && ok "type ${type_id} implemented (${VIS_FILES[$type_id]}.qml)" \
+        || fail "type ${type_id} NOT implemented (${VIS_FILES[$type_id]}.qml missing)"
 done
-! grep -q "Visualization Not Yet Implemented" "$MAIN_QML" \
+! grep -rq "Visualization Not Yet Implemented" "$MAIN_QML" "$VIS_DIR" \
     && ok "no 'Not Yet Implemented' placeholder"  || fail "'Not Yet Implemented' placeholder still present"
 
 section "main.xml – config schema entries"
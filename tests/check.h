@@ -0,0 +1,23 @@
+#ifndef CHECK_H
+#define CHECK_H
+
+#include <iostream>
+
+/**
+ * Minimal assertions for the unit tests: a failed CHECK reports itself and
+ * is counted, and the test's main() returns TEST_RESULT so ctest sees it.
+ */
+inline int g_checkFailures = 0;
+
+#define CHECK(condition)                                                              \
+    do {                                                                              \
+        if (!(condition)) {                                                           \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK(" #condition ") failed" \
+                      << std::endl;                                                   \
+            ++g_checkFailures;                                                        \
+        }                                                                             \
+    } while (0)
+
+#define TEST_RESULT (g_checkFailures == 0 ? 0 : 1)
+
+#endif // CHECK_H
@@ -0,0 +1,105 @@
+#include "frame_hash.h"
+#include "check.h"
+#include <vector>
+
+namespace {
+
+// 150x100 BGRA32: 3x2 tiles, the last column and row partial
+constexpr int WIDTH = 150;
+constexpr int HEIGHT = 100;
+
+FrameDescriptor testFrame() {
+    FrameDescriptor frame;
+    frame.format = PixelFormat::BGRA32;
+    frame.width = WIDTH;
+    frame.height = HEIGHT;
+    frame.stride = WIDTH * 4;
+    return frame;
+}
+
+std::vector<unsigned char> testPixels() {
+    std::vector<unsigned char> pixels(WIDTH * HEIGHT * 4);
+    for (size_t i = 0; i < pixels.size(); ++i) {
+        pixels[i] = static_cast<unsigned char>(i * 13);
+    }
+    return pixels;
+}
+
+int differingTiles(const TileHashes& a, const TileHashes& b, int& column, int& row) {
+    int count = 0;
+    for (size_t i = 0; i < a.tiles.size() && i < b.tiles.size(); ++i) {
+        if (a.tiles[i] != b.tiles[i]) {
+            column = static_cast<int>(i) % a.columns;
+            row = static_cast<int>(i) / a.columns;
+            ++count;
+        }
+    }
+    return count;
+}
+
+void layout() {
+    TileHashes hashes;
+    hashTiles(testPixels().data(), testFrame(), hashes);
+    CHECK(hashes.columns == 3 && hashes.rows == 2);
+    CHECK(hashes.tiles.size() == 6);
+}
+
+void equality() {
+    const FrameDescriptor frame = testFrame();
+    std::vector<unsigned char> pixels = testPixels();
+    TileHashes a, b;
+    hashTiles(pixels.data(), frame, a);
+    hashTiles(pixels.data(), frame, b);
+    CHECK(a == b);
+
+    // Same bytes read as another format are another picture
+    FrameDescriptor other = frame;
+    other.format = PixelFormat::RGBA32;
+    hashTiles(pixels.data(), other, b);
+    CHECK(a != b);
+
+    // Empty hashes match nothing, not even each other
+    TileHashes empty1, empty2;
+    CHECK(empty1 != empty2);
+    b = a;
+    b.clear();
+    CHECK(b.empty());
+    CHECK(a != b);
+}
+
+// A changed pixel dirties exactly its own tile, including partial edge tiles
+void dirtyTiles() {
+    const FrameDescriptor frame = testFrame();
+    std::vector<unsigned char> pixels = testPixels();
+    TileHashes before, after;
+    hashTiles(pixels.data(), frame, before);
+
+    const int points[][2] = {{0, 0}, {70, 10}, {149, 99}, {64, 64}};
+    for (const auto& point : points) {
+        std::vector<unsigned char> changed = pixels;
+        changed[(point[1] * WIDTH + point[0]) * 4 + 1] ^= 0x5A;
+        hashTiles(changed.data(), frame, after);
+        int column = -1, row = -1;
+        CHECK(differingTiles(before, after, column, row) == 1);
+        CHECK(column == point[0] / TileHashes::TILE_SIZE);
+        CHECK(row == point[1] / TileHashes::TILE_SIZE);
+    }
+
+    // Bytes past the row width (stride padding) are not part of the picture
+    FrameDescriptor padded = frame;
+    padded.stride = WIDTH * 4 + 8;
+    std::vector<unsigned char> wide(padded.stride * HEIGHT, 7);
+    hashTiles(wide.data(), padded, before);
+    wide[WIDTH * 4 + 3] = 9;
+    hashTiles(wide.data(), padded, after);
+    CHECK(before == after);
+}
+
+} // namespace
+
+int main() {
+    layout();
+    equality();
+    dirtyTiles();
+    return TEST_RESULT;
+}
@@ -0,0 +1,73 @@
+#include "frame_pool.h"
+#include "check.h"
+#include <chrono>
+
+namespace {
+
+void publish(FramePool& pool, uint64_t sequence) {
+    FramePool::Frame& frame = pool.writeFrame();
+    frame.sequence = sequence;
+    frame.pixels.assign(4, static_cast<unsigned char>(sequence));
+    frame.palette.clear();
+    pool.publish();
+}
+
+void nothingPublished() {
+    FramePool pool;
+    CHECK(!pool.acquire());
+    CHECK(!pool.waitForFrame(std::chrono::milliseconds(1)));
+}
+
+// Frames published before the consumer looks replace each other
+void latestWins() {
+    FramePool pool;
+    publish(pool, 1);
+    publish(pool, 2);
+    publish(pool, 3);
+    CHECK(pool.acquire());
+    CHECK(pool.readFrame().sequence == 3);
+    CHECK(pool.readFrame().pixels[0] == 3);
+    // Taken once only
+    CHECK(!pool.acquire());
+    CHECK(pool.readFrame().sequence == 3);
+}
+
+// The producer never draws into the frame the consumer holds
+void buffersStayApart() {
+    FramePool pool;
+    publish(pool, 1);
+    CHECK(pool.acquire());
+    const FramePool::Frame* held = &pool.readFrame();
+    for (uint64_t i = 2; i < 8; ++i) {
+        CHECK(&pool.writeFrame() != held);
+        publish(pool, i);
+    }
+    CHECK(held->sequence == 1);
+    CHECK(pool.waitForFrame(std::chrono::milliseconds(1)));
+    CHECK(pool.acquire());
+    CHECK(pool.readFrame().sequence == 7);
+    CHECK(pool.waitUntilConsumed(std::chrono::milliseconds(1)));
+}
+
+void paletteFollowsFrame() {
+    FramePool pool;
+    FramePool::Frame& frame = pool.writeFrame();
+    frame.palette.assign(256, 0xff102030u);
+    pool.publish();
+    CHECK(pool.acquire());
+    CHECK(pool.readFrame().descriptor.palette == pool.readFrame().palette.data());
+
+    publish(pool, 2);  // no palette
+    CHECK(pool.acquire());
+    CHECK(pool.readFrame().descriptor.palette == nullptr);
+}
+
+} // namespace
+
+int main() {
+    nothingPublished();
+    latestWins();
+    buffersStayApart();
+    paletteFollowsFrame();
+    return TEST_RESULT;
+}
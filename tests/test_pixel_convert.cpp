@@ -0,0 +1,101 @@
+#include "pixel_convert.h"
+#include "check.h"
+#include <cstring>
+#include <vector>
+
+namespace {
+
+const PixelFormat FORMATS[] = {PixelFormat::RGB24, PixelFormat::BGR24, PixelFormat::RGBA32,
+                               PixelFormat::BGRA32, PixelFormat::Indexed8};
+
+// Every width up to a few AVX2 blocks, so full blocks and all tail lengths run
+constexpr int MAX_WIDTH = 100;
+
+std::vector<uint32_t> testPalette() {
+    std::vector<uint32_t> palette(256);
+    for (uint32_t i = 0; i < 256; ++i) {
+        palette[i] = (i * 0x01030507u) ^ 0x80402010u;
+    }
+    return palette;
+}
+
+// The dispatched kernels match the scalar reference for every pair and width
+void simdMatchesScalar() {
+    const std::vector<uint32_t> palette = testPalette();
+    std::vector<unsigned char> src(MAX_WIDTH * 4);
+    for (size_t i = 0; i < src.size(); ++i) {
+        src[i] = static_cast<unsigned char>(i * 37 + 11);
+    }
+
+    for (PixelFormat from : FORMATS) {
+        for (PixelFormat to : FORMATS) {
+            const PixelRowConverter fast = pixelRowConverter(from, to);
+            const PixelRowConverter scalar = pixelRowConverterScalar(from, to);
+            if (to == PixelFormat::Indexed8) {
+                CHECK(!fast && !scalar);
+                continue;
+            }
+            CHECK(fast && scalar);
+            if (!fast || !scalar) {
+                continue;
+            }
+            const int bpp = FrameDescriptor::bytesPerPixel(to);
+            for (int width = 1; width <= MAX_WIDTH; ++width) {
+                // One guard byte past the row catches overruns
+                std::vector<unsigned char> a(width * bpp + 1, 0xAB), b(width * bpp + 1, 0xAB);
+                fast(src.data(), a.data(), width, palette.data());
+                scalar(src.data(), b.data(), width, palette.data());
+                CHECK(a == b);
+                CHECK(a.back() == 0xAB);
+            }
+        }
+    }
+}
+
+// The scalar reference itself moves channels where the formats say
+void channelMapping() {
+    const unsigned char rgb[3] = {10, 20, 30};
+    unsigned char out[4] = {};
+
+    pixelRowConverterScalar(PixelFormat::RGB24, PixelFormat::BGR24)(rgb, out, 1, nullptr);
+    CHECK(out[0] == 30 && out[1] == 20 && out[2] == 10);
+
+    pixelRowConverterScalar(PixelFormat::RGB24, PixelFormat::RGBA32)(rgb, out, 1, nullptr);
+    CHECK(out[0] == 10 && out[1] == 20 && out[2] == 30 && out[3] == 0xFF);
+
+    pixelRowConverterScalar(PixelFormat::RGB24, PixelFormat::BGRA32)(rgb, out, 1, nullptr);
+    uint32_t word;
+    std::memcpy(&word, out, 4);
+    CHECK(word == 0xFF0A141Eu);
+
+    const uint32_t palette[256] = {0, 0x11223344u};
+    const unsigned char index = 1;
+    pixelRowConverterScalar(PixelFormat::Indexed8, PixelFormat::RGBA32)(&index, out, 1, palette);
+    CHECK(out[0] == 0x22 && out[1] == 0x33 && out[2] == 0x44 && out[3] == 0x11);
+}
+
+void bottomUpFrame() {
+    const unsigned char rows[2][3] = {{1, 2, 3}, {4, 5, 6}};
+    FrameDescriptor frame;
+    frame.format = PixelFormat::RGB24;
+    frame.width = 1;
+    frame.height = 2;
+    frame.stride = 3;
+    frame.origin = FrameOrigin::BottomLeft;
+    unsigned char out[2][3] = {};
+    CHECK(convertFrame(&rows[0][0], frame, &out[0][0], 3, PixelFormat::RGB24));
+    CHECK(out[0][0] == 4 && out[1][0] == 1);
+
+    frame.format = PixelFormat::Indexed8;
+    CHECK(!convertFrame(&rows[0][0], frame, &out[0][0], 3, PixelFormat::RGB24));
+}
+
+} // namespace
+
+int main() {
+    std::cout << "Row kernels: " << pixelConversionIsa() << std::endl;
+    simdMatchesScalar();
+    channelMapping();
+    bottomUpFrame();
+    return TEST_RESULT;
+}
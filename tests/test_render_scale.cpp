@@ -0,0 +1,94 @@
+#include "render_scale.h"
+#include "check.h"
+#include <cmath>
+
+namespace {
+
+constexpr int WINDOW = 30;  // frames per decision
+constexpr int SETTLE = 10;  // frames ignored after a change
+
+bool near(double a, double b) {
+    return std::fabs(a - b) < 1e-9;
+}
+
+// Feeds count frames of engineMs; true if any of them changed the scale
+bool feed(RenderScaleController& controller, int count, double engineMs) {
+    bool changed = false;
+    for (int i = 0; i < count; ++i) {
+        changed = controller.frameRendered(engineMs) || changed;
+    }
+    return changed;
+}
+
+void fixedScale() {
+    RenderScaleController controller;
+    controller.setFixedScale(0.5);
+    CHECK(!controller.isAutomatic());
+    CHECK(near(controller.scale(), 0.5));
+    CHECK(!feed(controller, 100, 1000.0));
+    // Clamped to the ladder's ends
+    controller.setFixedScale(0.01);
+    CHECK(near(controller.scale(), 0.25));
+    controller.setFixedScale(2.0);
+    CHECK(near(controller.scale(), 1.0));
+}
+
+void ladder() {
+    RenderScaleController controller;
+    controller.setBudget(10.0);
+    CHECK(controller.isAutomatic());
+    CHECK(near(controller.scale(), 1.0));
+
+    // Within budget at full scale: nothing to do
+    CHECK(!feed(controller, WINDOW, 9.0));
+    CHECK(near(controller.scale(), 1.0));
+
+    // Slightly over: one step down
+    CHECK(!feed(controller, WINDOW - 1, 11.0));
+    CHECK(controller.frameRendered(11.0));
+    CHECK(near(controller.scale(), 0.85));
+
+    // Frames right after a change are ignored, then a whole window counts
+    CHECK(!feed(controller, SETTLE + WINDOW - 1, 1000.0));
+    // Far over: as many steps as the pixel count needs, here to the bottom
+    CHECK(controller.frameRendered(1000.0));
+    CHECK(near(controller.scale(), 0.25));
+    CHECK(!feed(controller, SETTLE + WINDOW, 1000.0));
+    CHECK(near(controller.scale(), 0.25));
+
+    // Cheap frames: back up one step per window
+    CHECK(feed(controller, SETTLE + WINDOW, 1.0));
+    CHECK(near(controller.scale(), 1.0 / 3.0));
+    CHECK(feed(controller, SETTLE + WINDOW, 1.0));
+    CHECK(near(controller.scale(), 0.4));
+
+    // Not when the larger step would come too close to the budget:
+    // 0.4 -> 0.5 costs 1.5625x, 5 ms would become 7.8 ms > 70% of 10 ms
+    CHECK(!feed(controller, SETTLE + WINDOW, 5.0));
+    CHECK(near(controller.scale(), 0.4));
+}
+
+void scaledSize() {
+    RenderScaleController controller;
+    controller.setFixedScale(0.85);
+    int width = 0, height = 0;
+    controller.scaledSize(1920, 1080, width, height);
+    CHECK(width == 1632 && height == 918);
+    // Even sizes
+    controller.setFixedScale(1.0 / 3.0);
+    controller.scaledSize(1001, 999, width, height);
+    CHECK(width % 2 == 0 && height % 2 == 0);
+    // Never below a minimum, never above the output
+    controller.setFixedScale(0.25);
+    controller.scaledSize(20, 10, width, height);
+    CHECK(width == 16 && height == 10);
+}
+
+} // namespace
+
+int main() {
+    fixedScale();
+    ladder();
+    scaledSize();
+    return TEST_RESULT;
+}
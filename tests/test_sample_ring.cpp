@@ -0,0 +1,86 @@
+#include "samplering.h"
+#include "check.h"
+#include <vector>
+
+namespace {
+
+std::vector<float> sequence(int first, int count) {
+    std::vector<float> values(count);
+    for (int i = 0; i < count; ++i) {
+        values[i] = static_cast<float>(first + i);
+    }
+    return values;
+}
+
+void capacityRoundsUp() {
+    SampleRing ring(100);
+    CHECK(ring.capacity() == 128);
+}
+
+void readFollowsWrites() {
+    SampleRing ring(16);
+    quint64 cursor = ring.writePosition();
+    ring.write(sequence(0, 5).data(), 5);
+    float out[16] = {};
+    CHECK(ring.read(cursor, out, 16) == 5);
+    CHECK(out[0] == 0.0f && out[4] == 4.0f);
+    CHECK(ring.read(cursor, out, 16) == 0);
+
+    ring.write(sequence(5, 7).data(), 7);
+    CHECK(ring.read(cursor, out, 3) == 3);
+    CHECK(out[0] == 5.0f && out[2] == 7.0f);
+    CHECK(ring.read(cursor, out, 16) == 4);
+    CHECK(out[0] == 8.0f && out[3] == 11.0f);
+
+    // Across the end of the buffer
+    ring.write(sequence(12, 6).data(), 6);
+    CHECK(ring.read(cursor, out, 16) == 6);
+    CHECK(out[0] == 12.0f && out[5] == 17.0f);
+}
+
+// A reader that fell behind skips to the newest half ring, oldest first
+void overrun() {
+    SampleRing ring(16);
+    quint64 cursor = ring.writePosition();
+    for (int first = 0; first < 40; first += 8) {
+        ring.write(sequence(first, 8).data(), 8);
+    }
+    float out[16] = {};
+    CHECK(ring.read(cursor, out, 16) == 8);
+    CHECK(out[0] == 32.0f && out[7] == 39.0f);
+    CHECK(cursor == ring.writePosition());
+
+    // One write larger than the ring keeps only its newest ring of samples
+    ring.write(sequence(100, 20).data(), 20);
+    CHECK(ring.writePosition() == 56);
+    CHECK(ring.read(cursor, out, 16) == 8);
+    CHECK(out[0] == 112.0f && out[7] == 119.0f);
+
+    // A cursor from the future is pulled back
+    cursor = ring.writePosition() + 100;
+    CHECK(ring.read(cursor, out, 16) == 0);
+    CHECK(cursor == ring.writePosition());
+}
+
+void readLatest() {
+    SampleRing ring(16);
+    float out[8];
+    ring.write(sequence(1, 3).data(), 3);
+    // Zero-padded at the front until the ring has enough
+    CHECK(ring.readLatest(out, 5) == 3);
+    CHECK(out[0] == 0.0f && out[1] == 0.0f && out[2] == 1.0f && out[4] == 3.0f);
+
+    ring.write(sequence(4, 30).data(), 30);
+    ring.readLatest(out, 8);
+    CHECK(out[0] == 26.0f && out[7] == 33.0f);
+}
+
+} // namespace
+
+int main() {
+    capacityRoundsUp();
+    readFollowsWrites();
+    overrun();
+    readLatest();
+    return TEST_RESULT;
+}
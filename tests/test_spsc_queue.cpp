@@ -0,0 +1,60 @@
+#include "spsc_queue.h"
+#include "check.h"
+
+namespace {
+
+void fillAndDrain() {
+    SpscQueue<int, 4> queue;
+    int value = -1;
+    CHECK(!queue.pop(value));
+    for (int i = 0; i < 4; ++i) {
+        CHECK(queue.push(i));
+    }
+    CHECK(!queue.push(4));
+    CHECK(queue.size() == 4);
+    for (int i = 0; i < 4; ++i) {
+        CHECK(queue.pop(value) && value == i);
+    }
+    CHECK(!queue.pop(value));
+    CHECK(queue.size() == 0);
+}
+
+// Head and tail keep running past the capacity; order must survive the wrap
+void wrapAround() {
+    SpscQueue<int, 4> queue;
+    int next = 0, expected = 0, value = -1;
+    for (int round = 0; round < 10; ++round) {
+        CHECK(queue.push(next++));
+        CHECK(queue.push(next++));
+        CHECK(queue.push(next++));
+        CHECK(queue.pop(value) && value == expected++);
+        CHECK(queue.pop(value) && value == expected++);
+        CHECK(queue.pop(value) && value == expected++);
+    }
+    CHECK(!queue.pop(value));
+}
+
+void bulkPartial() {
+    SpscQueue<float, 8> queue;
+    const float in[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    CHECK(queue.push(in, 5) == 5);
+    // Only the room that is left is taken
+    CHECK(queue.push(in + 5, 5) == 3);
+    float out[10] = {};
+    CHECK(queue.pop(out, 3) == 3);
+    CHECK(out[0] == 0 && out[2] == 2);
+    // Wraps: three slots free at the start of the ring
+    CHECK(queue.push(in, 3) == 3);
+    CHECK(queue.pop(out, 10) == 8);
+    CHECK(out[0] == 3 && out[4] == 7 && out[5] == 0 && out[7] == 2);
+    CHECK(queue.pop(out, 10) == 0);
+}
+
+} // namespace
+
+int main() {
+    fillAndDrain();
+    wrapAround();
+    bulkPartial();
+    return TEST_RESULT;
+}